@@ -9,6 +9,7 @@
 #include "otp.h"
 #include "tfm_plat_provisioning.h"
 #include "boot_hal.h"
+#include "boot_timestamp.h"
 #include "region_defs.h"
 #include "log.h"
 #include "util.h"
@@ -46,10 +47,13 @@ int main(void)
 {
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_STAGE_ENTRY, 0);
+
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_PLATFORM_INIT_DONE, 0);
     BL1_LOG("[INF] Starting TF-M BL1_1\r\n");
 
     fih_rc = bl1_otp_init();
@@ -65,6 +69,7 @@ int main(void)
     }
 
     tfm_plat_provisioning_check_for_dummy_keys();
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_OTP_INIT_DONE, 0);
 
     fih_rc = fih_int_encode_zero_equality(boot_platform_post_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
@@ -85,18 +90,25 @@ int main(void)
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_IMAGE_LOAD_DONE, 0);
 
     FIH_CALL(validate_image_at_addr, fih_rc, (uint8_t *)BL1_2_CODE_START);
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         BL1_LOG("[ERR] BL1_2 image failed to validate\r\n");
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_IMAGE_HASH_DONE, 0);
 
     fih_rc = fih_int_encode_zero_equality(boot_platform_post_load(0));
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
 
+#ifdef TFM_BOOT_TIMESTAMPS
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_1, BOOT_TS_STAGE_EXIT, 0);
+    (void)boot_store_timestamps(BOOT_TS_STAGE_BL1_1);
+#endif
+
     BL1_LOG("[INF] Jumping to BL1_2\r\n");
     /* Jump to BL1_2 */
     boot_platform_quit((struct boot_arm_vector_table *)BL1_2_CODE_START);
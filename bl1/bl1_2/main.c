@@ -8,6 +8,7 @@
 #include "crypto.h"
 #include "otp.h"
 #include "boot_hal.h"
+#include "boot_timestamp.h"
 #include "uart_stdout.h"
 #include "fih.h"
 #include "util.h"
@@ -190,6 +191,7 @@ static fih_int validate_image(uint32_t image_id)
         BL1_LOG("[ERR] BL2 image failed to decrypt\r\n");
         FIH_RET(FIH_FAILURE);
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_2, BOOT_TS_IMAGE_LOAD_DONE, image_id);
     image = (struct bl1_2_image_t *)BL2_IMAGE_START;
 
     BL1_LOG("[INF] BL2 image decrypted successfully\r\n");
@@ -199,6 +201,7 @@ static fih_int validate_image(uint32_t image_id)
         BL1_LOG("[ERR] BL2 image failed to validate\r\n");
         FIH_RET(FIH_FAILURE);
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_2, BOOT_TS_SIG_VERIFY_DONE, image_id);
 
     BL1_LOG("[INF] BL2 image validated successfully\r\n");
 
@@ -210,10 +213,13 @@ int main(void)
     platform_code_is_bl1_2 = 1;
     fih_int fih_rc = FIH_FAILURE;
 
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_2, BOOT_TS_STAGE_ENTRY, 0);
+
     fih_rc = fih_int_encode_zero_equality(boot_platform_init());
     if (fih_not_eq(fih_rc, FIH_SUCCESS)) {
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_2, BOOT_TS_PLATFORM_INIT_DONE, 0);
     BL1_LOG("[INF] starting TF-M bl1_2\r\n");
 
     fih_rc = fih_int_encode_zero_equality(boot_platform_post_init());
@@ -235,6 +241,11 @@ int main(void)
         }
     }
 
+#ifdef TFM_BOOT_TIMESTAMPS
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL1_2, BOOT_TS_STAGE_EXIT, 0);
+    (void)boot_store_timestamps(BOOT_TS_STAGE_BL1_2);
+#endif
+
     BL1_LOG("[INF] Jumping to BL2\r\n");
     boot_platform_quit((struct boot_arm_vector_table *)BL2_CODE_START);
 
@@ -28,6 +28,7 @@
 #include "bootutil/fault_injection_hardening.h"
 #include "flash_map_backend/flash_map_backend.h"
 #include "boot_hal.h"
+#include "boot_timestamp.h"
 #include "uart_stdout.h"
 #include "tfm_plat_otp.h"
 #include "tfm_plat_provisioning.h"
@@ -76,6 +77,11 @@ static void do_boot(struct boot_rsp *rsp)
                                          rsp->br_hdr->ih_hdr_size);
     }
 
+#ifdef TFM_BOOT_TIMESTAMPS
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL2, BOOT_TS_STAGE_EXIT, 0);
+    (void)boot_store_timestamps(BOOT_TS_STAGE_BL2);
+#endif
+
     /* This function never returns, because it calls the secure application
      * Reset_Handler().
      */
@@ -89,6 +95,8 @@ int main(void)
     enum tfm_plat_err_t plat_err;
     int32_t image_id;
 
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL2, BOOT_TS_STAGE_ENTRY, 0);
+
     /* Initialise the mbedtls static memory allocator so that mbedtls allocates
      * memory from the provided static buffer instead of from the heap.
      */
@@ -99,6 +107,7 @@ int main(void)
         BOOT_LOG_ERR("Platform init failed");
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL2, BOOT_TS_PLATFORM_INIT_DONE, 0);
 
     BOOT_LOG_INF("Starting bootloader");
 
@@ -123,6 +132,7 @@ int main(void)
         BOOT_LOG_ERR("Error while initializing the security counter");
         FIH_PANIC;
     }
+    BOOT_TS_RECORD(BOOT_TS_STAGE_BL2, BOOT_TS_OTP_INIT_DONE, 0);
 
     /* Perform platform specific post-initialization */
     if (boot_platform_post_init() != 0) {
@@ -148,6 +158,7 @@ int main(void)
             BOOT_LOG_ERR("Unable to find bootable image");
             FIH_PANIC;
         }
+        BOOT_TS_RECORD(BOOT_TS_STAGE_BL2, BOOT_TS_SIG_VERIFY_DONE, image_id);
 
         if (boot_platform_post_load(image_id)) {
             BOOT_LOG_ERR("Post-load step for image %d failed", image_id);
@@ -81,6 +81,7 @@ int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
 {
     uint32_t i;
     uint8_t *u8dst;
+    uint8_t erased_val;
     int rc;
 
     BOOT_LOG_DBG("read_is_empty area=%d, off=%#x, len=%#x",
@@ -91,9 +92,10 @@ int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
     }
 
     u8dst = (uint8_t*)dst;
+    erased_val = flash_area_erased_val(fa);
 
     for (i = 0; i < len; i++) {
-        if (u8dst[i] != flash_area_erased_val(fa)) {
+        if (u8dst[i] != erased_val) {
             return 0;
         }
     }
@@ -73,6 +73,16 @@ uint8_t flash_area_erased_val(const struct flash_area *fap);
 int flash_area_read_is_empty(const struct flash_area *fa, uint32_t off,
         void *dst, uint32_t len);
 
+#ifdef BL2_FLASH_MEMORY_MAPPED
+/*
+ * Get a pointer to `len` bytes at `off` in a memory-mapped flash area, to
+ * process them in place.
+ * Returns 0 on success, or -1 if the area is not memory-mapped.
+ */
+int flash_area_get_mapped_ptr(const struct flash_area *area, uint32_t off,
+                              uint32_t len, const void **ptr);
+#endif
+
 static inline uint8_t flash_area_get_id(const struct flash_area *fa)
 {
     return fa->fa_id;
@@ -374,12 +374,36 @@ struct bootutil_key bootutil_keys[1] = {
 };
 const int bootutil_key_cnt = 1;
 
+#if defined(MCUBOOT_DATA_SHARING) && \
+    defined(CONFIG_TFM_BOOT_STORE_MEASUREMENTS) && \
+    !defined(MCUBOOT_MEASURED_BOOT)
+extern void boot_measurement_save_signer_id(uint8_t image_index,
+                                            const uint8_t *signer_id,
+                                            size_t signer_id_size);
+#endif
+
 int boot_retrieve_public_key_hash(uint8_t image_index,
                                   uint8_t *public_key_hash,
                                   size_t *key_hash_size)
 {
-    return tfm_plat_get_rotpk_hash(image_index,
-                                   public_key_hash,
-                                   (uint32_t *)key_hash_size);
+    int rc;
+
+    rc = tfm_plat_get_rotpk_hash(image_index,
+                                 public_key_hash,
+                                 (uint32_t *)key_hash_size);
+
+#if defined(MCUBOOT_DATA_SHARING) && \
+    defined(CONFIG_TFM_BOOT_STORE_MEASUREMENTS) && \
+    !defined(MCUBOOT_MEASURED_BOOT)
+    /* The image is only accepted if the hash of its public key matches this
+     * one, so it is also the signer ID of the boot measurement.
+     */
+    if (rc == TFM_PLAT_ERR_SUCCESS) {
+        boot_measurement_save_signer_id(image_index, public_key_hash,
+                                        *key_hash_size);
+    }
+#endif
+
+    return rc;
 }
 #endif /* !MCUBOOT_HW_KEY */
@@ -0,0 +1,95 @@
+#! /usr/bin/env python3
+#
+# -----------------------------------------------------------------------------
+# Copyright (c) 2022, Arm Limited. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# -----------------------------------------------------------------------------
+
+"""
+Create a delta image for the Firmware Update partition.
+
+The delta image describes the new signed image as copies from the image in the
+active (primary) slot and insertions of new data. The FWU partition
+reconstructs the new image in the staging (secondary) slot, so that only the
+differences need to be downloaded.
+"""
+
+import argparse
+import struct
+
+DELTA_MAGIC = 0x544C4446
+DELTA_CMD_COPY = 0x01
+DELTA_CMD_INSERT = 0x02
+
+# Size of the chunks indexed in the active image to find the matches
+BLOCK_SIZE = 16
+# A copy command is only worth it for matches of at least this size
+MIN_MATCH_SIZE = 24
+
+
+def _index(old):
+    index = {}
+    for off in range(0, len(old) - BLOCK_SIZE + 1):
+        index.setdefault(old[off:off + BLOCK_SIZE], off)
+    return index
+
+
+def _insert(delta, data):
+    if data:
+        delta += struct.pack('<BI', DELTA_CMD_INSERT, len(data)) + data
+
+
+def create_delta(old, new):
+    index = _index(old)
+    delta = bytearray(struct.pack('<II', DELTA_MAGIC, len(new)))
+    literal = bytearray()
+    pos = 0
+
+    while pos < len(new):
+        src = index.get(new[pos:pos + BLOCK_SIZE])
+        length = 0
+        if src is not None:
+            while (pos + length < len(new) and src + length < len(old) and
+                   new[pos + length] == old[src + length]):
+                length += 1
+
+        if length >= MIN_MATCH_SIZE:
+            _insert(delta, literal)
+            literal = bytearray()
+            delta += struct.pack('<BII', DELTA_CMD_COPY, src, length)
+            pos += length
+        else:
+            literal.append(new[pos])
+            pos += 1
+
+    _insert(delta, literal)
+    return bytes(delta)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-a', '--active', required=True,
+                        help='Signed image in the active slot')
+    parser.add_argument('-n', '--new', required=True,
+                        help='New signed image')
+    parser.add_argument('-o', '--output', required=True,
+                        help='Output delta image')
+    args = parser.parse_args()
+
+    with open(args.active, 'rb') as f:
+        old = f.read()
+    with open(args.new, 'rb') as f:
+        new = f.read()
+
+    delta = create_delta(old, new)
+    with open(args.output, 'wb') as f:
+        f.write(delta)
+
+    print('Delta image: {} bytes, {:.1f}% of the new image'.format(
+        len(delta), 100.0 * len(delta) / len(new)))
+
+
+if __name__ == '__main__':
+    main()
@@ -6,6 +6,7 @@
  */
 
 #include <stdbool.h>
+#include <string.h>
 #include "target.h"
 #include "flash_map/flash_map.h"
 #include "flash_map_backend/flash_map_backend.h"
@@ -103,37 +104,72 @@ void flash_area_close(const struct flash_area *area)
 }
 
 /*
- * Read/write/erase. Offset is relative from beginning of flash area.
- * `off` and `len` can be any alignment.
- * Return 0 on success, other value on failure.
+ * Capabilities of the flash areas read recently, to avoid querying the driver
+ * on each of the small reads done while an image is hashed.
  */
-int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
-                    uint32_t len)
-{
-    uint32_t remaining_len, read_length;
-    uint32_t aligned_off;
-    uint32_t item_number;
+struct flash_area_read_info {
+    const struct flash_area *area;
+    uint8_t data_width;
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    bool is_mapped;
+    uintptr_t mapped_addr;          /* Address where the area is mapped */
+#endif
+};
 
-    /* The maximum value of data_width is 4 bytes. */
-    uint8_t temp_buffer[sizeof(uint32_t)];
-    uint8_t data_width, i = 0, j;
-    int ret = 0;
+#define FLASH_AREA_READ_INFO_NUM    2
 
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
+static struct flash_area_read_info read_info[FLASH_AREA_READ_INFO_NUM];
+static uint32_t read_info_next;
 
-    BOOT_LOG_DBG("read area=%d, off=%#x, len=%#x", area->fa_id, off, len);
+static const struct flash_area_read_info *
+get_read_info(const struct flash_area *area)
+{
+    ARM_FLASH_CAPABILITIES DriverCapabilities;
+    struct flash_area_read_info *info;
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    uintptr_t device_base = 0;
+#endif
+    uint32_t i;
 
-    if (!is_range_valid(area, off, len)) {
-        return -1;
+    for (i = 0; i < FLASH_AREA_READ_INFO_NUM; i++) {
+        if (read_info[i].area == area) {
+            return &read_info[i];
+        }
     }
-    remaining_len = len;
+
+    info = &read_info[read_info_next];
+    read_info_next = (read_info_next + 1) % FLASH_AREA_READ_INFO_NUM;
 
     /* CMSIS ARM_FLASH_ReadData API requires the `addr` data type size aligned.
      * Data type size is specified by the data_width in ARM_FLASH_CAPABILITIES.
      */
     DriverCapabilities = DRV_FLASH_AREA(area)->GetCapabilities();
-    data_width = data_width_byte[DriverCapabilities.data_width];
-    aligned_off = FLOOR_ALIGN(off, data_width);
+    info->data_width = data_width_byte[DriverCapabilities.data_width];
+
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    info->is_mapped = (flash_device_base(area->fa_device_id,
+                                         &device_base) == 0);
+    info->mapped_addr = device_base + area->fa_off;
+#endif
+
+    info->area = area;
+
+    return info;
+}
+
+/*
+ * Read through the driver. The first and last data items are read into a
+ * bounce buffer if `off` or `off + len` are not aligned to the data width.
+ */
+static int flash_area_read_driver(const struct flash_area *area,
+                                  uint8_t data_width, uint32_t off,
+                                  uint8_t *dst, uint32_t len)
+{
+    /* The maximum value of data_width is 4 bytes. */
+    uint8_t temp_buffer[sizeof(uint32_t)];
+    uint32_t aligned_off = FLOOR_ALIGN(off, data_width);
+    uint32_t read_length, item_number;
+    int ret;
 
     /* Read the first data_width long data if `off` is not aligned. */
     if (aligned_off != off) {
@@ -145,53 +181,105 @@ int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
         }
 
         /* Record how many target data have been read. */
-        read_length = off - aligned_off + len >= data_width ?
-                                        data_width - (off - aligned_off) : len;
-
-        /* Copy the read data from off. */
-        for (i = 0; i < read_length; i++) {
-            ((uint8_t *)dst)[i] = temp_buffer[i + off - aligned_off];
+        read_length = data_width - (off - aligned_off);
+        if (read_length > len) {
+            read_length = len;
         }
-        remaining_len -= read_length;
+
+        memcpy(dst, &temp_buffer[off - aligned_off], read_length);
+        dst += read_length;
+        off += read_length;
+        len -= read_length;
     }
 
     /* The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of data
      * items to read.
      */
-    if (remaining_len) {
-        item_number = remaining_len / data_width;
-        if (item_number) {
-            ret = DRV_FLASH_AREA(area)->ReadData(area->fa_off + off + i,
-                                                (uint8_t *)dst + i,
-                                                item_number);
-            if (ret < 0) {
-                return ret;
-            }
-            remaining_len -= item_number * data_width;
+    item_number = len / data_width;
+    if (item_number) {
+        ret = DRV_FLASH_AREA(area)->ReadData(area->fa_off + off,
+                                             dst,
+                                             item_number);
+        if (ret < 0) {
+            return ret;
         }
+        dst += item_number * data_width;
+        off += item_number * data_width;
+        len -= item_number * data_width;
     }
-    if (remaining_len) {
-        ret = DRV_FLASH_AREA(area)->ReadData(
-                            area->fa_off + off + i + item_number * data_width,
-                            temp_buffer,
-                            1);
+
+    /* Read the last data_width long data if `off + len` is not aligned. */
+    if (len) {
+        ret = DRV_FLASH_AREA(area)->ReadData(area->fa_off + off,
+                                             temp_buffer,
+                                             1);
         if (ret < 0) {
             return ret;
         }
-        for (j = 0; j < remaining_len; j++) {
-            ((uint8_t *)dst)[i + item_number * data_width + j] = temp_buffer[j];
-        }
+        memcpy(dst, temp_buffer, len);
     }
 
     /* CMSIS ARM_FLASH_ReadData can return the number of data items read or
      * Status Error Codes which are negative for failures.
      */
-    if (ret < 0) {
-        return ret;
-    } else {
+    return 0;
+}
+
+/*
+ * Read/write/erase. Offset is relative from beginning of flash area.
+ * `off` and `len` can be any alignment.
+ * Return 0 on success, other value on failure.
+ */
+int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
+                    uint32_t len)
+{
+    const struct flash_area_read_info *info;
+
+    BOOT_LOG_DBG("read area=%d, off=%#x, len=%#x", area->fa_id, off, len);
+
+    if (!is_range_valid(area, off, len)) {
+        return -1;
+    }
+
+    info = get_read_info(area);
+
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    /* Memory-mapped flash is copied in bulk, at any alignment */
+    if (info->is_mapped) {
+        memcpy(dst, (const void *)(info->mapped_addr + off), len);
         return 0;
     }
+#endif
+
+    return flash_area_read_driver(area, info->data_width, off,
+                                  (uint8_t *)dst, len);
+}
+
+#ifdef BL2_FLASH_MEMORY_MAPPED
+/*
+ * Get the address where `len` bytes at `off` in a flash area are mapped, so
+ * that they can be processed in place instead of being read into a buffer.
+ * Return 0 on success, other value if the area is not memory-mapped.
+ */
+int flash_area_get_mapped_ptr(const struct flash_area *area, uint32_t off,
+                              uint32_t len, const void **ptr)
+{
+    const struct flash_area_read_info *info;
+
+    if (!is_range_valid(area, off, len)) {
+        return -1;
+    }
+
+    info = get_read_info(area);
+    if (!info->is_mapped) {
+        return -1;
+    }
+
+    *ptr = (const void *)(info->mapped_addr + off);
+
+    return 0;
 }
+#endif /* BL2_FLASH_MEMORY_MAPPED */
 
 /* Writes `len` bytes of flash memory at `off` from the buffer at `src`.
  * `off` and `len` can be any alignment.
@@ -205,7 +293,6 @@ int flash_area_write(const struct flash_area *area, uint32_t off,
 #else
     uint8_t len_padding[FLASH_PROGRAM_UNIT - 1];
 #endif
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
     uint8_t data_width;
     /* The PROGRAM_UNIT aligned value of `off` */
     uint32_t aligned_off;
@@ -240,8 +327,7 @@ int flash_area_write(const struct flash_area *area, uint32_t off,
         return -1;
     }
 
-    DriverCapabilities = DRV_FLASH_AREA(area)->GetCapabilities();
-    data_width = data_width_byte[DriverCapabilities.data_width];
+    data_width = get_read_info(area)->data_width;
 
     if (FLASH_PROGRAM_UNIT) {
         /* Read the bytes from aligned_off to off. */
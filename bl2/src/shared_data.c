@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-3-Clause
  *
  */
+#include <stdbool.h>
 #include <string.h>
 #include "bootutil/boot_record.h"
 #include "bootutil/boot_status.h"
@@ -46,10 +47,52 @@ extern int boot_add_data_to_shared_area(uint8_t        major_type,
 
 
 #if defined(CONFIG_TFM_BOOT_STORE_MEASUREMENTS) && !defined(MCUBOOT_MEASURED_BOOT)
+/* Per-image measurement data carried over from the image verification */
+struct boot_image_measurement_ctx {
+    uint8_t signer_id[MCUBOOT_HASH_SIZE];
+    size_t  signer_id_size;             /* 0 if the signer ID is not known */
+};
+
+static struct boot_image_measurement_ctx
+                                image_measurement_ctx[MCUBOOT_IMAGE_NUMBER];
+
+/**
+ * Save the signer ID of an image, as matched by the bootloader while the
+ * image was verified, so that it is not calculated again for the boot
+ * measurement.
+ *
+ * @param[in]  image_index     Index of the image.
+ * @param[in]  signer_id       Hash of the public key the image is signed with.
+ * @param[in]  signer_id_size  Size of the signer ID in bytes.
+ */
+void boot_measurement_save_signer_id(uint8_t image_index,
+                                     const uint8_t *signer_id,
+                                     size_t signer_id_size)
+{
+    struct boot_image_measurement_ctx *ctx;
+
+    if (image_index >= MCUBOOT_IMAGE_NUMBER) {
+        return;
+    }
+
+    ctx = &image_measurement_ctx[image_index];
+
+    if (signer_id_size != sizeof(ctx->signer_id)) {
+        /* Not usable as signer ID, it is collected from the TLV area */
+        ctx->signer_id_size = 0;
+        return;
+    }
+
+    memcpy(ctx->signer_id, signer_id, signer_id_size);
+    ctx->signer_id_size = signer_id_size;
+}
+
 /**
  * Collect boot measurement and available associated metadata from the
- * TLV area of an image.
+ * TLV area of an image. The signer ID saved by the image verification is
+ * reused, then the walk stops at the image hash.
  *
+ * @param[in]  image_index  Index of the image.
  * @param[in]  hdr        Pointer to the image header stored in RAM.
  * @param[in]  fap        Pointer to the flash area where image is stored.
  * @param[out] metadata   Pointer to measurement metadata structure.
@@ -61,16 +104,20 @@ extern int boot_add_data_to_shared_area(uint8_t        major_type,
  *
  */
 static int collect_image_measurement_and_metadata(
+                                    uint8_t image_index,
                                     const struct image_header *hdr,
                                     const struct flash_area *fap,
                                     struct boot_measurement_metadata *metadata,
                                     uint8_t *measurement_buf,
                                     size_t   measurement_buf_size)
 {
+    const struct boot_image_measurement_ctx *ctx =
+                                        &image_measurement_ctx[image_index];
     struct image_tlv_iter it;
     uint32_t off;
     uint16_t len;
     uint16_t type;
+    bool hash_found = false;
 #ifdef MCUBOOT_HW_KEY
     /* Few extra bytes for encoding and for public exponent. */
     uint8_t key_buf[SIG_BUF_SIZE + 24];
@@ -89,13 +136,23 @@ static int collect_image_measurement_and_metadata(
         return -1;
     }
 
-    /* Traverse through all of the TLVs for the required items. */
-    rc = bootutil_tlv_iter_begin(&it, hdr, fap, IMAGE_TLV_ANY, false);
+    if (ctx->signer_id_size != 0) {
+        memcpy(metadata->signer_id, ctx->signer_id, ctx->signer_id_size);
+        metadata->signer_id_size = ctx->signer_id_size;
+    }
+
+    /* Traverse through the TLVs until the required items are found. Only the
+     * image hash is needed when the signer ID is already known.
+     */
+    rc = bootutil_tlv_iter_begin(&it, hdr, fap,
+                                 (metadata->signer_id_size != 0) ?
+                                 IMAGE_TLV_SHA256 : IMAGE_TLV_ANY,
+                                 false);
     if (rc) {
         return rc;
     }
 
-    while (true) {
+    while (!hash_found || (metadata->signer_id_size == 0)) {
         rc = bootutil_tlv_iter_next(&it, &off, &len, &type);
         if (rc < 0) {
             return -1;
@@ -112,6 +169,7 @@ static int collect_image_measurement_and_metadata(
             if (rc) {
                 return -1;
             }
+            hash_found = true;
 #ifdef MCUBOOT_HW_KEY
         } else if (type == IMAGE_TLV_PUBKEY) {
             /* Retrieve the signer ID (hash of PUBKEY) from the TLV area. */
@@ -253,7 +311,7 @@ int boot_save_shared_data(const struct image_header *hdr,
         break;
     }
 
-    rc = collect_image_measurement_and_metadata(hdr, fap,
+    rc = collect_image_measurement_and_metadata(mcuboot_image_id, hdr, fap,
                                                 &metadata,
                                                 image_hash,
                                                 sizeof(image_hash));
@@ -59,11 +59,15 @@ set(CONFIG_TFM_HALT_ON_CORE_PANIC       OFF         CACHE BOOL       "On fatal e
 
 set(CONFIG_TFM_STACK_WATERMARKS         OFF         CACHE BOOL      "Whether to pre-fill partition stacks with a set value to help determine stack usage")
 
+set(CONFIG_TFM_SPM_PROFILING            OFF         CACHE BOOL      "Whether to count cycles spent in SPM message queuing, memory checks and context switches")
+set(TFM_BOOT_TIMESTAMPS                 OFF         CACHE BOOL      "Whether to record boot timeline checkpoints in BL1, BL2 and SPM, and log the timeline before entering NSPE")
+
 set(PROJECT_CONFIG_HEADER_FILE          "${CMAKE_SOURCE_DIR}/config/config_base.h" CACHE FILEPATH "User defined header file for TF-M config")
 
 ############################ Platform ##########################################
 
 set(NUM_MAILBOX_QUEUE_SLOT              1           CACHE BOOL      "Number of mailbox queue slots")
+set(NUM_MAILBOX_SHM_BUF                 0           CACHE STRING    "Number of shared memory buffers which NSPE can register to SPE mailbox. 0 to disable")
 set(TFM_PLAT_SPECIFIC_MULTI_CORE_COMM   OFF         CACHE BOOL      "Whether to use a platform specific inter-core communication instead of mailbox in dual-cpu topology")
 
 set(DEBUG_AUTHENTICATION                CHIP_DEFAULT CACHE STRING   "Debug authentication setting. [CHIP_DEFAULT, NONE, NS_ONLY, FULL")
@@ -72,6 +76,7 @@ set(SECURE_UART1                        OFF         CACHE BOOL      "Enable secu
 set(CRYPTO_HW_ACCELERATOR               OFF         CACHE BOOL      "Whether to enable the crypto hardware accelerator on supported platforms")
 
 set(OTP_NV_COUNTERS_RAM_EMULATION       OFF         CACHE BOOL      "Enable OTP/NV_COUNTERS emulation in RAM. Has no effect on non-default implementations of the OTP and NV_COUNTERS")
+set(OTP_NV_COUNTERS_JOURNAL             OFF         CACHE BOOL      "Append single NV counter word updates of the flash based OTP/NV_COUNTERS area to a journal instead of rewriting the area. Requires a journal area in flash_layout.h")
 set(TFM_NS_NV_COUNTER_AMOUNT            0           CACHE STRING    "How many NS NV counters are enabled")
 
 set(PLATFORM_DEFAULT_BL1                ON          CACHE STRING    "Whether to use default BL1 or platform-specific one")
@@ -22,6 +22,9 @@
 /* Disable Non-volatile counter module */
 #define PLATFORM_NV_COUNTER_MODULE_DISABLED    0
 
+/* Number of asynchronous IOCTL requests in flight, 0 disables them */
+#define PLATFORM_IOCTL_ASYNC_SLOT_NUM          0
+
 /* Crypto Partition Configs */
 
 /*
@@ -30,6 +33,12 @@
  */
 #define CRYPTO_ENGINE_BUF_SIZE                 0x2080
 
+/*
+ * Serve the Mbed Crypto allocations from power of two size classes carved from
+ * the engine buffer, instead of the Mbed TLS buffer allocator
+ */
+#define CRYPTO_ENGINE_SLAB_ALLOC               0
+
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #define CRYPTO_CONC_OPER_NUM                   8
 
@@ -60,6 +69,9 @@
 /* Enable PSA Crypto key derivation module */
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 
+/* Enable the Crypto resource usage statistics module */
+#define CRYPTO_STATS_MODULE_ENABLED            0
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
 
@@ -83,6 +95,18 @@
 /* The stack size of the Firmware Update Secure Partition */
 #define FWU_STACK_SIZE                         0x600
 
+/* Hash the image as it is written, instead of reading it back from flash */
+#define FWU_STREAMING_HASH                     1
+
+/* Size of the buffer combining the writes to the staging area, 0 to disable */
+#define FWU_WRITE_BUF_SIZE                     0x400
+
+/* Accept delta images, reconstructed from the active image */
+#define FWU_DELTA_IMAGE                        0
+
+/* Sectors of the staging area erased ahead of the writes, 0 to erase it at start */
+#define FWU_ERASE_AHEAD_SECTORS                1
+
 /* Attest Partition Configs */
 
 /* Include optional claims in initial attestation token */
@@ -30,6 +30,12 @@
  */
 #define CRYPTO_ENGINE_BUF_SIZE                 0x5000
 
+/*
+ * Serve the Mbed Crypto allocations from power of two size classes carved from
+ * the engine buffer, instead of the Mbed TLS buffer allocator
+ */
+#define CRYPTO_ENGINE_SLAB_ALLOC               0
+
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #define CRYPTO_CONC_OPER_NUM                   8
 
@@ -60,6 +66,9 @@
 /* Enable PSA Crypto key derivation module */
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 
+/* Enable the Crypto resource usage statistics module */
+#define CRYPTO_STATS_MODULE_ENABLED            0
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #define CRYPTO_IOVEC_BUFFER_SIZE               5120
 
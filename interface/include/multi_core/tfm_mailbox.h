@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  * Copyright (c) 2022 Cypress Semiconductor Corporation. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
@@ -33,6 +33,15 @@ extern "C" {
 #define MAILBOX_PSA_CONNECT                 (0x3)
 #define MAILBOX_PSA_CALL                    (0x4)
 #define MAILBOX_PSA_CLOSE                   (0x5)
+#define MAILBOX_SHM_REGISTER                (0x6)
+#define MAILBOX_SHM_UNREGISTER              (0x7)
+
+/* Shared memory buffer ID which refers to no buffer */
+#define MAILBOX_SHM_NULL_ID                 (0)
+
+/* Access permissions of a shared memory buffer granted to SPE */
+#define MAILBOX_SHM_ACCESS_RO               (0x1)
+#define MAILBOX_SHM_ACCESS_RW               (0x2)
 
 /* Return code of mailbox APIs */
 #define MAILBOX_SUCCESS                     (0)
@@ -66,11 +75,28 @@ struct psa_client_params_t {
             size_t          in_len;
             psa_outvec      *out_vec;
             size_t          out_len;
+#if NUM_MAILBOX_SHM_BUF > 0
+            int32_t         shm_id;     /* Shared memory buffer holding the
+                                         * iovecs, or MAILBOX_SHM_NULL_ID.
+                                         */
+#endif
         } psa_call_params;
 
         struct {
             psa_handle_t    handle;
         } psa_close_params;
+
+#if NUM_MAILBOX_SHM_BUF > 0
+        struct {
+            const void      *base;
+            size_t          size;
+            uint32_t        access;
+        } shm_register_params;
+
+        struct {
+            int32_t         shm_id;
+        } shm_unregister_params;
+#endif
     };
 };
 
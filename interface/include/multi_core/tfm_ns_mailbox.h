@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -53,6 +53,156 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
                                    int32_t client_id,
                                    int32_t *reply);
 
+#if NUM_MAILBOX_SHM_BUF > 0
+/**
+ * \brief Register a shared memory buffer to SPE.
+ *
+ * \details SPE validates the access to the whole buffer once at registration.
+ *          The iovecs of \ref tfm_ns_mailbox_psa_call_shm located inside the
+ *          buffer are then accepted by SPE via a bounds check on the buffer,
+ *          instead of looking up the memory layout per iovec.
+ *
+ * \param[in] base              Base address of the buffer
+ * \param[in] size              Size of the buffer in bytes
+ * \param[in] access            \ref MAILBOX_SHM_ACCESS_RO or
+ *                              \ref MAILBOX_SHM_ACCESS_RW
+ * \param[out] shm_id           The ID assigned to the buffer
+ *
+ * \retval PSA_SUCCESS          The buffer is registered.
+ * \retval Other return code    Operation failed with an error code.
+ */
+psa_status_t tfm_ns_mailbox_shm_register(const void *base, size_t size,
+                                         uint32_t access, int32_t *shm_id);
+
+/**
+ * \brief Unregister a shared memory buffer from SPE.
+ *
+ * \param[in] shm_id            The ID of the buffer
+ *
+ * \retval PSA_SUCCESS          The buffer is unregistered.
+ * \retval Other return code    Operation failed with an error code.
+ */
+psa_status_t tfm_ns_mailbox_shm_unregister(int32_t shm_id);
+
+/**
+ * \brief Same as psa_call(), with the iovecs located in a registered shared
+ *        memory buffer.
+ *
+ * \param[in] shm_id            The ID of the buffer holding the iovecs. The
+ *                              buffer must not be unregistered before the call
+ *                              returns.
+ *
+ * \note Iovecs outside of the buffer are still accepted, with the regular
+ *       memory access check.
+ */
+psa_status_t tfm_ns_mailbox_psa_call_shm(int32_t shm_id, psa_handle_t handle,
+                                         int32_t type, const psa_invec *in_vec,
+                                         size_t in_len, psa_outvec *out_vec,
+                                         size_t out_len);
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
+#ifndef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
+/*
+ * Ticket of an asynchronous PSA client call. It encodes the mailbox queue slot
+ * and a sequence number, so that a stale ticket is not mixed up with a later
+ * call in the same slot.
+ */
+typedef uint32_t tfm_ns_mailbox_ticket_t;
+
+#define TFM_NS_MAILBOX_INVALID_TICKET       ((tfm_ns_mailbox_ticket_t)0)
+
+/**
+ * \brief Completion callback of an asynchronous PSA client call.
+ *
+ * \param[in] ticket            The ticket of the completed call.
+ * \param[in] reply             PSA client call result.
+ * \param[in] cb_data           The data registered with the call.
+ */
+typedef void (*tfm_ns_mailbox_async_cb_t)(tfm_ns_mailbox_ticket_t ticket,
+                                          int32_t reply, void *cb_data);
+
+/**
+ * \brief Send PSA client call to SPE via mailbox and return without waiting
+ *        for the result.
+ *
+ * \note The vectors and buffers referenced by \p params must remain valid
+ *       until the call is completed.
+ *
+ * \note Each call in flight holds a share of the NS mailbox OS lock until its
+ *       result is fetched, as a blocking call does until it returns. The call
+ *       waits for the lock while blocking calls hold it. It fails with
+ *       \ref MAILBOX_QUEUE_FULL if the asynchronous calls already hold all
+ *       the mailbox queue slots, so that a caller keeping several calls in
+ *       flight can complete some of them before retrying.
+ *
+ * \param[in] call_type         PSA client call type
+ * \param[in] params            Parameters used for PSA client call
+ * \param[in] client_id         Optional client ID of non-secure caller.
+ * \param[in] cb                Optional completion callback. If set, the result
+ *                              is delivered by
+ *                              \ref tfm_ns_mailbox_dispatch_completions and the
+ *                              ticket cannot be polled.
+ * \param[in] cb_data           Data passed to \p cb.
+ * \param[out] ticket           The ticket of the submitted call.
+ *
+ * \retval MAILBOX_SUCCESS      The PSA client call is submitted.
+ * \retval MAILBOX_QUEUE_FULL   All the slots are held by asynchronous calls.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_client_call_async(
+                                    uint32_t call_type,
+                                    const struct psa_client_params_t *params,
+                                    int32_t client_id,
+                                    tfm_ns_mailbox_async_cb_t cb,
+                                    void *cb_data,
+                                    tfm_ns_mailbox_ticket_t *ticket);
+
+/**
+ * \brief Check whether an asynchronous PSA client call is completed, and fetch
+ *        its result if so. The ticket is released once the result is fetched.
+ *
+ * \param[in] ticket            The ticket of the call.
+ * \param[out] reply            The buffer written with PSA client call result.
+ *
+ * \retval MAILBOX_SUCCESS       The call is completed and \p reply is written.
+ * \retval MAILBOX_NO_PEND_EVENT The call is still in progress.
+ * \retval MAILBOX_INVAL_PARAMS  The ticket is invalid, already released or
+ *                               registered with a completion callback.
+ */
+int32_t tfm_ns_mailbox_poll(tfm_ns_mailbox_ticket_t ticket, int32_t *reply);
+
+/**
+ * \brief Wait until any of the given asynchronous PSA client calls completes
+ *        and fetch its result.
+ *
+ * \note With an NS OS, replies wake up the task which submitted the calls, so
+ *       the calls should be waited for by the task which submitted them.
+ *
+ * \param[in] tickets           Array of tickets to wait for.
+ * \param[in] num               Number of tickets in the array.
+ * \param[out] completed        Index in \p tickets of the completed call.
+ * \param[out] reply            The buffer written with PSA client call result.
+ *
+ * \retval MAILBOX_SUCCESS      A call is completed and its ticket is released.
+ * \retval Other return code    Operation failed with an error code.
+ */
+int32_t tfm_ns_mailbox_wait_any(const tfm_ns_mailbox_ticket_t *tickets,
+                                uint32_t num, uint32_t *completed,
+                                int32_t *reply);
+
+/**
+ * \brief Invoke the completion callbacks of the completed asynchronous PSA
+ *        client calls, and release their tickets.
+ *
+ * \note It is intended to be called in thread context by the NS event loop,
+ *       for example after \ref tfm_ns_mailbox_os_wait_reply returns. The
+ *       callbacks may submit new calls.
+ *
+ * \return The number of callbacks invoked.
+ */
+uint32_t tfm_ns_mailbox_dispatch_completions(void);
+#endif /* !TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD */
+
 #ifdef TFM_MULTI_CORE_NS_OS_MAILBOX_THREAD
 /**
  * \brief Handling PSA client calls in a dedicated NS mailbox thread.
@@ -20,6 +20,8 @@
 #define psa_read                 psa_read_svc
 #define psa_skip                 psa_skip_svc
 #define psa_write                psa_write_svc
+#define tfm_psa_read_vec         tfm_psa_read_vec_svc
+#define tfm_psa_write_vec        tfm_psa_write_vec_svc
 #define psa_reply                psa_reply_svc
 #define psa_panic                psa_panic_svc
 #define psa_rot_lifecycle_state  psa_rot_lifecycle_state_svc
@@ -59,6 +61,8 @@
 #define psa_read                 psa_read_cross
 #define psa_skip                 psa_skip_cross
 #define psa_write                psa_write_cross
+#define tfm_psa_read_vec         tfm_psa_read_vec_cross
+#define tfm_psa_write_vec        tfm_psa_write_vec_cross
 #define psa_reply                psa_reply_cross
 #define psa_panic                psa_panic_cross
 #define psa_rot_lifecycle_state  psa_rot_lifecycle_state_cross
@@ -103,6 +107,8 @@
 #define psa_read                 psa_read_sfn
 #define psa_skip                 psa_skip_sfn
 #define psa_write                psa_write_sfn
+#define tfm_psa_read_vec         tfm_psa_read_vec_sfn
+#define tfm_psa_write_vec        tfm_psa_write_vec_sfn
 #define psa_panic                psa_panic_sfn
 /* Following PSA APIs are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
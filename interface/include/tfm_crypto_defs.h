@@ -56,10 +56,31 @@ struct tfm_crypto_pack_iovec {
     uint16_t step;           /*!< Key derivation step */
 };
 
+/**
+ * \brief Resource usage of the Crypto service, returned by
+ *        \ref tfm_crypto_get_stats. Sizes are in bytes.
+ */
+struct tfm_crypto_stats {
+    uint32_t engine_buf_size;     /*!< Size of the Mbed Crypto heap */
+    uint32_t engine_buf_used;     /*!< Heap currently allocated, 0 if the
+                                   *   allocator does not track it
+                                   */
+    uint32_t engine_buf_max_used; /*!< Peak of engine_buf_used */
+    uint32_t oper_num;            /*!< Number of multipart operation contexts */
+    uint32_t oper_in_use;         /*!< Operation contexts currently in use */
+    uint32_t oper_max_in_use;     /*!< Peak of oper_in_use */
+    uint32_t scratch_size;        /*!< Size of the IOVec scratch buffer, 0 if
+                                   *   the IOVecs are mapped instead
+                                   */
+    uint32_t scratch_max_used;    /*!< Peak use of the IOVec scratch buffer */
+    uint32_t key_slot_num;        /*!< Number of key slots */
+    uint32_t key_slot_in_use;     /*!< Key slots currently holding a key */
+};
+
 /**
  * \brief Type associated to the group of a function encoding. There can be
- *        nine groups (Random, Key management, Hash, MAC, Cipher, AEAD,
- *        Asym sign, Asym encrypt, Key derivation).
+ *        ten groups (Random, Key management, Hash, MAC, Cipher, AEAD,
+ *        Asym sign, Asym encrypt, Key derivation, Statistics).
  */
 enum tfm_crypto_group_id {
     TFM_CRYPTO_GROUP_ID_RANDOM = 0x0,
@@ -71,6 +92,7 @@ enum tfm_crypto_group_id {
     TFM_CRYPTO_GROUP_ID_ASYM_SIGN,
     TFM_CRYPTO_GROUP_ID_ASYM_ENCRYPT,
     TFM_CRYPTO_GROUP_ID_KEY_DERIVATION,
+    TFM_CRYPTO_GROUP_ID_STATS,
 };
 
 /* X macro describing each of the available PSA Crypto APIs */
@@ -157,6 +179,10 @@ enum tfm_crypto_group_id {
 #define RANDOM_FUNCS                               \
     X(TFM_CRYPTO_GENERATE_RANDOM)
 
+#define STATS_FUNCS                                \
+    X(TFM_CRYPTO_GET_STATS)                        \
+    X(TFM_CRYPTO_RESET_STATS)
+
 /*
  * Define function IDs in each group. The function ID will be encoded into
  * tfm_crypto_func_sid below.
@@ -191,6 +217,9 @@ enum tfm_crypto_key_derivation_func_id {
 enum tfm_crypto_random_func_id {
     RANDOM_FUNCS
 };
+enum tfm_crypto_stats_func_id {
+    STATS_FUNCS
+};
 #undef X
 
 #define FUNC_ID(func_id)    (((func_id) & 0xFF) << 8)
@@ -253,6 +282,11 @@ enum tfm_crypto_func_sid {
                                            (TFM_CRYPTO_GROUP_ID_RANDOM & 0xFF)),
     RANDOM_FUNCS
 
+#undef X
+#define X(func_id)      func_id ## _SID = (uint16_t)((FUNC_ID(func_id)) | \
+                                            (TFM_CRYPTO_GROUP_ID_STATS & 0xFF)),
+    STATS_FUNCS
+
 };
 #undef X
 
@@ -277,6 +311,26 @@ enum {
     TFM_CRYPTO_IN_USE = 1
 };
 
+/**
+ * \brief Get the resource usage of the Crypto service. Only secure partitions
+ *        are allowed to call it.
+ *
+ * \param[out] stats  Resource usage of the service
+ *
+ * \return PSA_ERROR_NOT_PERMITTED if called from the NSPE, or
+ *         PSA_ERROR_NOT_SUPPORTED if CRYPTO_STATS_MODULE_ENABLED is not set.
+ *         Other return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_get_stats(struct tfm_crypto_stats *stats);
+
+/**
+ * \brief Reset the peak values of the resource usage of the Crypto service to
+ *        the current values. Only secure partitions are allowed to call it.
+ *
+ * \return Return values as described in \ref tfm_crypto_get_stats
+ */
+psa_status_t tfm_crypto_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,12 +21,21 @@ extern "C" {
  * \brief TFM secure partition platform API version
  */
 #define TFM_PLATFORM_API_VERSION_MAJOR (0)
-#define TFM_PLATFORM_API_VERSION_MINOR (3)
+#define TFM_PLATFORM_API_VERSION_MINOR (5)
 
-#define TFM_PLATFORM_API_ID_NV_READ       (1010)
-#define TFM_PLATFORM_API_ID_NV_INCREMENT  (1011)
-#define TFM_PLATFORM_API_ID_SYSTEM_RESET  (1012)
-#define TFM_PLATFORM_API_ID_IOCTL         (1013)
+#define TFM_PLATFORM_API_ID_NV_READ             (1010)
+#define TFM_PLATFORM_API_ID_NV_INCREMENT        (1011)
+#define TFM_PLATFORM_API_ID_SYSTEM_RESET        (1012)
+#define TFM_PLATFORM_API_ID_IOCTL               (1013)
+#define TFM_PLATFORM_API_ID_NV_READ_MULTI       (1014)
+#define TFM_PLATFORM_API_ID_NV_INCREMENT_MULTI  (1015)
+#define TFM_PLATFORM_API_ID_IOCTL_ASYNC         (1016)
+#define TFM_PLATFORM_API_ID_IOCTL_ASYNC_RESULT  (1017)
+
+/**
+ * \brief Maximum number of NV counters in a single read or increment request
+ */
+#define TFM_PLATFORM_NV_COUNTER_MULTI_MAX (8)
 
 /*!
  * \enum tfm_platform_err_t
@@ -39,6 +48,8 @@ enum tfm_platform_err_t {
     TFM_PLATFORM_ERR_SYSTEM_ERROR,
     TFM_PLATFORM_ERR_INVALID_PARAM,
     TFM_PLATFORM_ERR_NOT_SUPPORTED,
+    TFM_PLATFORM_ERR_IN_PROGRESS,
+    TFM_PLATFORM_ERR_BUSY,
 
     /* Following entry is only to ensure the error code of int size */
     TFM_PLATFORM_ERR_FORCE_INT_SIZE = INT_MAX
@@ -67,6 +78,49 @@ enum tfm_platform_err_t tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
                                            psa_invec *input,
                                            psa_outvec *output);
 
+/*!
+ * \brief Starts a platform-specific service without waiting for its
+ *        completion
+ *
+ * \param[in]  request      Request identifier (valid values vary
+ *                          based on the platform)
+ * \param[in]  input        Input buffer to the requested service (or NULL)
+ * \param[in]  output_size  Size of the output of the requested service, in
+ *                          bytes (or 0)
+ * \param[out] ticket       Ticket identifying the request, to collect its
+ *                          result with \ref tfm_platform_ioctl_async_result
+ *
+ * \note The platform signals the completion of the request in a platform
+ *       specific way. Every ticket must be collected, as the number of
+ *       requests in flight is limited, and a client can only hold half of
+ *       them.
+ *
+ * \return TFM_PLATFORM_ERR_BUSY if no request can be started until the
+ *         client, or another one, collects a ticket. Otherwise, values as
+ *         specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+tfm_platform_ioctl_async(tfm_platform_ioctl_req_t request,
+                         psa_invec *input, uint32_t output_size,
+                         uint32_t *ticket);
+
+/*!
+ * \brief Collects the result of a platform-specific service started with
+ *        \ref tfm_platform_ioctl_async
+ *
+ * \param[in]     ticket    Ticket returned when the request was started
+ * \param[in,out] output    Output buffer to the requested service (or NULL).
+ *                          It must hold the output_size given when the
+ *                          request was started. Its len is set to the size
+ *                          of the output produced.
+ *
+ * \return TFM_PLATFORM_ERR_IN_PROGRESS if the request is not completed yet,
+ *         in which case the ticket remains valid. Otherwise, the result of
+ *         the request as specified by the \ref tfm_platform_err_t
+ */
+enum tfm_platform_err_t
+tfm_platform_ioctl_async_result(uint32_t ticket, psa_outvec *output);
+
 /*!
  * \brief Increments the given non-volatile (NV) counter by one
  *
@@ -93,6 +147,41 @@ enum tfm_platform_err_t
 tfm_platform_nv_counter_read(uint32_t counter_id,
                              uint32_t size, uint8_t *val);
 
+/*!
+ * \brief Increments several non-volatile (NV) counters by one in a single
+ *        request. The permissions are checked for all the counters before
+ *        any of them is incremented.
+ *
+ * \param[in]  counter_ids  NV counter IDs.
+ * \param[in]  num          Number of counters, at most
+ *                          \ref TFM_PLATFORM_NV_COUNTER_MULTI_MAX.
+ *
+ * \return  TFM_PLATFORM_ERR_SUCCESS if all the counters are incremented
+ *          correctly. TFM_PLATFORM_ERR_INVALID_PARAM if the number of
+ *          counters is not supported. Otherwise, it returns
+ *          TFM_PLATFORM_ERR_SYSTEM_ERROR.
+ */
+enum tfm_platform_err_t
+tfm_platform_nv_counter_increment_multi(const uint32_t *counter_ids,
+                                        uint32_t num);
+
+/*!
+ * \brief Reads several non-volatile (NV) counters in a single request.
+ *
+ * \param[in]  counter_ids  NV counter IDs.
+ * \param[in]  num          Number of counters, at most
+ *                          \ref TFM_PLATFORM_NV_COUNTER_MULTI_MAX.
+ * \param[out] vals         Array of num elements to store the NV counter
+ *                          values, in the order of counter_ids.
+ *
+ * \return  TFM_PLATFORM_ERR_SUCCESS if all the values are read correctly.
+ *          TFM_PLATFORM_ERR_INVALID_PARAM if the number of counters is not
+ *          supported. Otherwise, it returns TFM_PLATFORM_ERR_SYSTEM_ERROR.
+ */
+enum tfm_platform_err_t
+tfm_platform_nv_counter_read_multi(const uint32_t *counter_ids,
+                                   uint32_t num, uint32_t *vals);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __TFM_PSA_RW_VEC_H__
+#define __TFM_PSA_RW_VEC_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "psa_config.h"
+#include "psa/client.h"
+#include "psa/service.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * TF-M specific extension of the PSA Secure Partition APIs. The vectored
+ * variants of psa_read() and psa_write() move several segments between the
+ * client vectors and the Secure Partition buffers in one SPM entry, instead of
+ * paying one SPM entry and one message handle validation per segment.
+ */
+
+/* The maximum number of segments accepted by one vectored read or write */
+#define TFM_PSA_RW_VEC_MAX_SEGS     (PSA_MAX_IOVEC * 2)
+
+/* A segment of a vectored read or write */
+struct tfm_psa_rw_seg_t {
+    uint32_t iovec_idx;         /* Index of the client input/output vector */
+    void     *buffer;           /* Buffer in the Secure Partition          */
+    size_t   len;               /*
+                                 * Number of bytes to read or write. It is
+                                 * updated with the number of bytes copied by
+                                 * tfm_psa_read_vec().
+                                 */
+};
+
+/**
+ * \brief Read several segments of client input vectors into Secure Partition
+ *        buffers. Each segment behaves as a psa_read() call, and segments are
+ *        processed in array order.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in,out] segs          Array of segments to read. The len member of
+ *                              each segment is updated with the number of bytes
+ *                              copied for it.
+ * \param[in] num_segs          Number of segments in the array. Must not be
+ *                              greater than \ref TFM_PSA_RW_VEC_MAX_SEGS.
+ *
+ * \retval >=0                  Total number of bytes copied.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           num_segs is greater than
+ *                                \ref TFM_PSA_RW_VEC_MAX_SEGS.
+ * \arg                           The memory reference for segs is invalid or
+ *                                not read-write.
+ * \arg                           Any segment is invalid for psa_read().
+ */
+size_t tfm_psa_read_vec(psa_handle_t msg_handle,
+                        struct tfm_psa_rw_seg_t *segs, uint32_t num_segs);
+
+/**
+ * \brief Write several Secure Partition buffers to client output vectors.
+ *        Each segment behaves as a psa_write() call, and segments are
+ *        processed in array order.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] segs              Array of segments to write.
+ * \param[in] num_segs          Number of segments in the array. Must not be
+ *                              greater than \ref TFM_PSA_RW_VEC_MAX_SEGS.
+ *
+ * \retval void                 Success
+ * \retval "PROGRAMMER ERROR"   The call is invalid, one or more of the
+ *                              following are true:
+ * \arg                           msg_handle is invalid.
+ * \arg                           msg_handle does not refer to a request
+ *                                message.
+ * \arg                           num_segs is greater than
+ *                                \ref TFM_PSA_RW_VEC_MAX_SEGS.
+ * \arg                           The memory reference for segs is invalid or
+ *                                not readable.
+ * \arg                           Any segment is invalid for psa_write().
+ */
+void tfm_psa_write_vec(psa_handle_t msg_handle,
+                       const struct tfm_psa_rw_seg_t *segs, uint32_t num_segs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TFM_PSA_RW_VEC_H__ */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -104,6 +104,9 @@ psa_status_t psa_call(psa_handle_t handle, int32_t type,
     params.psa_call_params.in_len = in_len;
     params.psa_call_params.out_vec = out_vec;
     params.psa_call_params.out_len = out_len;
+#if NUM_MAILBOX_SHM_BUF > 0
+    params.psa_call_params.shm_id = MAILBOX_SHM_NULL_ID;
+#endif
 
     ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
                                      NON_SECURE_CLIENT_ID,
@@ -125,3 +128,80 @@ void psa_close(psa_handle_t handle)
     (void)tfm_ns_mailbox_client_call(MAILBOX_PSA_CLOSE, &params,
                                      NON_SECURE_CLIENT_ID, &reply);
 }
+
+#if NUM_MAILBOX_SHM_BUF > 0
+psa_status_t tfm_ns_mailbox_shm_register(const void *base, size_t size,
+                                         uint32_t access, int32_t *shm_id)
+{
+    struct psa_client_params_t params;
+    int32_t ret, reply;
+
+    if (!shm_id) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    params.shm_register_params.base = base;
+    params.shm_register_params.size = size;
+    params.shm_register_params.access = access;
+
+    ret = tfm_ns_mailbox_client_call(MAILBOX_SHM_REGISTER, &params,
+                                     NON_SECURE_CLIENT_ID, &reply);
+    if (ret != MAILBOX_SUCCESS) {
+        return PSA_INTER_CORE_COMM_ERR;
+    }
+
+    /* SPE replies the buffer ID, or an error code which is negative */
+    if (reply <= MAILBOX_SHM_NULL_ID) {
+        return (psa_status_t)reply;
+    }
+
+    *shm_id = reply;
+
+    return PSA_SUCCESS;
+}
+
+psa_status_t tfm_ns_mailbox_shm_unregister(int32_t shm_id)
+{
+    struct psa_client_params_t params;
+    int32_t ret;
+    psa_status_t status;
+
+    params.shm_unregister_params.shm_id = shm_id;
+
+    ret = tfm_ns_mailbox_client_call(MAILBOX_SHM_UNREGISTER, &params,
+                                     NON_SECURE_CLIENT_ID,
+                                     (int32_t *)&status);
+    if (ret != MAILBOX_SUCCESS) {
+        status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    return status;
+}
+
+psa_status_t tfm_ns_mailbox_psa_call_shm(int32_t shm_id, psa_handle_t handle,
+                                         int32_t type, const psa_invec *in_vec,
+                                         size_t in_len, psa_outvec *out_vec,
+                                         size_t out_len)
+{
+    struct psa_client_params_t params;
+    int32_t ret;
+    psa_status_t status;
+
+    params.psa_call_params.handle = handle;
+    params.psa_call_params.type = type;
+    params.psa_call_params.in_vec = in_vec;
+    params.psa_call_params.in_len = in_len;
+    params.psa_call_params.out_vec = out_vec;
+    params.psa_call_params.out_len = out_len;
+    params.psa_call_params.shm_id = shm_id;
+
+    ret = tfm_ns_mailbox_client_call(MAILBOX_PSA_CALL, &params,
+                                     NON_SECURE_CLIENT_ID,
+                                     (int32_t *)&status);
+    if (ret != MAILBOX_SUCCESS) {
+        status = PSA_INTER_CORE_COMM_ERR;
+    }
+
+    return status;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
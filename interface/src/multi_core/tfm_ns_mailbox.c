@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,7 +15,34 @@
 /* The pointer to NSPE mailbox queue */
 static struct ns_mailbox_queue_t *mailbox_queue_ptr = NULL;
 
+/*
+ * Asynchronous call state of each mailbox queue slot. It is kept in NS local
+ * memory since SPE never accesses it.
+ */
+struct ns_mailbox_async_slot_t {
+    uint32_t                    seq;        /* Sequence number of the call  */
+    bool                        in_flight;  /* An async call owns the slot  */
+    tfm_ns_mailbox_async_cb_t   cb;         /* Optional completion callback */
+    void                        *cb_data;   /* Data passed to the callback  */
+};
+
+static struct ns_mailbox_async_slot_t async_slots[NUM_MAILBOX_QUEUE_SLOT];
+
+/* Number of async calls holding a mailbox queue slot and the OS lock */
+static uint32_t async_in_flight_num;
+
+/* Ticket layout: slot index in the low byte and sequence number above. */
+#define TICKET_IDX_MASK                 0xFFUL
+#define TICKET_SEQ_SHIFT                8
+#define TICKET_SEQ_MASK                 (UINT32_MAX >> TICKET_SEQ_SHIFT)
+
+#define MAKE_TICKET(idx, seq)                                           \
+    ((tfm_ns_mailbox_ticket_t)(((seq) << TICKET_SEQ_SHIFT) | (idx)))
+#define TICKET_IDX(ticket)              ((uint8_t)((ticket) & TICKET_IDX_MASK))
+#define TICKET_SEQ(ticket)              ((ticket) >> TICKET_SEQ_SHIFT)
+
 static int32_t mailbox_wait_reply(uint8_t idx);
+static inline bool mailbox_wait_reply_signal(uint8_t idx);
 
 static inline void set_queue_slot_empty(uint8_t idx)
 {
@@ -99,9 +126,33 @@ static void set_msg_owner(uint8_t idx, const void *owner)
     }
 }
 
+/*
+ * Set the async state of a slot, before the message is pended. The reply, and
+ * its dispatch, can happen as soon as SPE is notified.
+ */
+static void async_slot_claim(uint8_t idx,
+                             struct ns_mailbox_async_slot_t *async)
+{
+    struct ns_mailbox_async_slot_t *p_async = &async_slots[idx];
+    uint32_t seq;
+
+    seq = (p_async->seq + 1) & TICKET_SEQ_MASK;
+    if (seq == 0) {
+        seq = 1;
+    }
+
+    p_async->seq = seq;
+    p_async->cb = async->cb;
+    p_async->cb_data = async->cb_data;
+    p_async->in_flight = true;
+
+    async->seq = seq;
+}
+
 static int32_t mailbox_tx_client_req(uint32_t call_type,
                                      const struct psa_client_params_t *params,
                                      int32_t client_id,
+                                     struct ns_mailbox_async_slot_t *async,
                                      uint8_t *slot_idx)
 {
     uint8_t idx;
@@ -131,6 +182,10 @@ static int32_t mailbox_tx_client_req(uint32_t call_type,
     task_handle = tfm_ns_mailbox_os_get_task_handle();
     set_msg_owner(idx, task_handle);
 
+    if (async) {
+        async_slot_claim(idx, async);
+    }
+
     tfm_ns_mailbox_hal_enter_critical();
     set_queue_slot_pend(mailbox_queue_ptr, idx);
     tfm_ns_mailbox_hal_exit_critical();
@@ -183,7 +238,8 @@ int32_t tfm_ns_mailbox_client_call(uint32_t call_type,
     }
 
     /* It requires SVCall if NS mailbox is put in privileged mode. */
-    ret = mailbox_tx_client_req(call_type, params, client_id, &slot_idx);
+    ret = mailbox_tx_client_req(call_type, params, client_id, NULL,
+                                &slot_idx);
     if (ret != MAILBOX_SUCCESS) {
         goto exit;
     }
@@ -204,6 +260,180 @@ exit:
     return ret;
 }
 
+int32_t tfm_ns_mailbox_client_call_async(
+                                    uint32_t call_type,
+                                    const struct psa_client_params_t *params,
+                                    int32_t client_id,
+                                    tfm_ns_mailbox_async_cb_t cb,
+                                    void *cb_data,
+                                    tfm_ns_mailbox_ticket_t *ticket)
+{
+    uint8_t slot_idx = NUM_MAILBOX_QUEUE_SLOT;
+    struct ns_mailbox_async_slot_t async;
+    bool is_full;
+    int32_t ret;
+
+    if (!mailbox_queue_ptr) {
+        return MAILBOX_INIT_ERROR;
+    }
+
+    if (!params || !ticket) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    /*
+     * An async call holds its share of the OS lock until its result is
+     * fetched, so that the blocking calls still find a free slot once they
+     * own the lock. Fail instead of waiting for the lock if the async calls
+     * already hold all the slots, as only their owners can release them.
+     */
+    tfm_ns_mailbox_os_spin_lock();
+    is_full = (async_in_flight_num >= NUM_MAILBOX_QUEUE_SLOT);
+    if (!is_full) {
+        async_in_flight_num++;
+    }
+    tfm_ns_mailbox_os_spin_unlock();
+
+    if (is_full) {
+        return MAILBOX_QUEUE_FULL;
+    }
+
+    if (tfm_ns_mailbox_os_lock_acquire() != MAILBOX_SUCCESS) {
+        ret = MAILBOX_QUEUE_FULL;
+        goto err_count;
+    }
+
+    async.cb = cb;
+    async.cb_data = cb_data;
+
+    ret = mailbox_tx_client_req(call_type, params, client_id, &async,
+                                &slot_idx);
+    if (ret != MAILBOX_SUCCESS) {
+        goto err_lock;
+    }
+
+    *ticket = MAKE_TICKET(slot_idx, async.seq);
+
+    return MAILBOX_SUCCESS;
+
+err_lock:
+    tfm_ns_mailbox_os_lock_release();
+err_count:
+    tfm_ns_mailbox_os_spin_lock();
+    async_in_flight_num--;
+    tfm_ns_mailbox_os_spin_unlock();
+
+    return ret;
+}
+
+static bool is_ticket_in_flight(tfm_ns_mailbox_ticket_t ticket)
+{
+    uint8_t idx = TICKET_IDX(ticket);
+
+    return (idx < NUM_MAILBOX_QUEUE_SLOT) &&
+           async_slots[idx].in_flight &&
+           (async_slots[idx].seq == TICKET_SEQ(ticket));
+}
+
+/*
+ * Fetch the result of a completed async call, and release its slot and its
+ * share of the OS lock.
+ */
+static void mailbox_rx_async_reply(uint8_t idx, int32_t *reply)
+{
+    async_slots[idx].in_flight = false;
+    async_slots[idx].cb = NULL;
+    async_slots[idx].cb_data = NULL;
+
+    mailbox_rx_client_reply(idx, reply);
+
+    tfm_ns_mailbox_os_lock_release();
+
+    tfm_ns_mailbox_os_spin_lock();
+    async_in_flight_num--;
+    tfm_ns_mailbox_os_spin_unlock();
+}
+
+int32_t tfm_ns_mailbox_poll(tfm_ns_mailbox_ticket_t ticket, int32_t *reply)
+{
+    uint8_t idx = TICKET_IDX(ticket);
+
+    if (!reply || !is_ticket_in_flight(ticket) || async_slots[idx].cb) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    if (!mailbox_wait_reply_signal(idx)) {
+        return MAILBOX_NO_PEND_EVENT;
+    }
+
+    mailbox_rx_async_reply(idx, reply);
+
+    return MAILBOX_SUCCESS;
+}
+
+int32_t tfm_ns_mailbox_wait_any(const tfm_ns_mailbox_ticket_t *tickets,
+                                uint32_t num, uint32_t *completed,
+                                int32_t *reply)
+{
+    uint32_t i;
+    int32_t ret;
+
+    if (!tickets || !num || !completed || !reply) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
+    while (1) {
+        for (i = 0; i < num; i++) {
+            ret = tfm_ns_mailbox_poll(tickets[i], reply);
+            if (ret == MAILBOX_SUCCESS) {
+                *completed = i;
+                return MAILBOX_SUCCESS;
+            } else if (ret != MAILBOX_NO_PEND_EVENT) {
+                return ret;
+            }
+        }
+
+        /* Woken up by any reply, including the ones of other tasks. */
+        tfm_ns_mailbox_os_wait_reply();
+    }
+}
+
+uint32_t tfm_ns_mailbox_dispatch_completions(void)
+{
+    tfm_ns_mailbox_async_cb_t cb;
+    tfm_ns_mailbox_ticket_t ticket;
+    void *cb_data;
+    uint32_t count = 0;
+    int32_t reply;
+    uint8_t idx;
+
+    if (!mailbox_queue_ptr) {
+        return 0;
+    }
+
+    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
+        if (!async_slots[idx].in_flight || !async_slots[idx].cb) {
+            continue;
+        }
+
+        if (!mailbox_wait_reply_signal(idx)) {
+            continue;
+        }
+
+        cb = async_slots[idx].cb;
+        cb_data = async_slots[idx].cb_data;
+        ticket = MAKE_TICKET(idx, async_slots[idx].seq);
+
+        /* Release the slot first, the callback may submit a new call. */
+        mailbox_rx_async_reply(idx, &reply);
+
+        cb(ticket, reply, cb_data);
+        count++;
+    }
+
+    return count;
+}
+
 #ifdef TFM_MULTI_CORE_NS_OS
 int32_t tfm_ns_mailbox_wake_reply_owner_isr(void)
 {
@@ -330,6 +560,9 @@ int32_t tfm_ns_mailbox_init(struct ns_mailbox_queue_t *queue)
     queue->empty_slots +=
             (mailbox_queue_status_t)(1UL << (NUM_MAILBOX_QUEUE_SLOT - 1));
 
+    memset(async_slots, 0, sizeof(async_slots));
+    async_in_flight_num = 0;
+
     mailbox_queue_ptr = queue;
 
     /* Platform specific initialization. */
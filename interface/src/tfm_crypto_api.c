@@ -1623,3 +1623,33 @@ psa_status_t psa_key_derivation_output_key(
 
     return API_DISPATCH(in_vec, out_vec);
 }
+
+psa_status_t tfm_crypto_get_stats(struct tfm_crypto_stats *stats)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_GET_STATS_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    psa_outvec out_vec[] = {
+        {.base = stats, .len = sizeof(struct tfm_crypto_stats)},
+    };
+
+    return API_DISPATCH(in_vec, out_vec);
+}
+
+psa_status_t tfm_crypto_reset_stats(void)
+{
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = TFM_CRYPTO_RESET_STATS_SID,
+    };
+
+    psa_invec in_vec[] = {
+        {.base = &iov, .len = sizeof(struct tfm_crypto_pack_iovec)},
+    };
+
+    return API_DISPATCH_NO_OUTVEC(in_vec);
+}
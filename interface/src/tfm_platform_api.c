@@ -62,6 +62,73 @@ tfm_platform_ioctl(tfm_platform_ioctl_req_t request,
     }
 }
 
+enum tfm_platform_err_t
+tfm_platform_ioctl_async(tfm_platform_ioctl_req_t request,
+                         psa_invec *input, uint32_t output_size,
+                         uint32_t *ticket)
+{
+    tfm_platform_ioctl_req_t req = request;
+    uint32_t out_size = output_size;
+    struct psa_invec in_vec[3] = { {0} };
+    struct psa_outvec out_vec[1];
+    size_t inlen;
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+
+    in_vec[0].base = &req;
+    in_vec[0].len = sizeof(req);
+    in_vec[1].base = &out_size;
+    in_vec[1].len = sizeof(out_size);
+    if (input != NULL) {
+        in_vec[2].base = input->base;
+        in_vec[2].len = input->len;
+        inlen = 3;
+    } else {
+        inlen = 2;
+    }
+
+    out_vec[0].base = ticket;
+    out_vec[0].len = sizeof(*ticket);
+
+    status = psa_call(TFM_PLATFORM_SERVICE_HANDLE,
+                      TFM_PLATFORM_API_ID_IOCTL_ASYNC,
+                      in_vec, inlen,
+                      out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    } else {
+        return (enum tfm_platform_err_t)status;
+    }
+}
+
+enum tfm_platform_err_t
+tfm_platform_ioctl_async_result(uint32_t ticket, psa_outvec *output)
+{
+    struct psa_invec in_vec[1];
+    size_t outlen;
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+
+    in_vec[0].base = &ticket;
+    in_vec[0].len = sizeof(ticket);
+
+    if (output != NULL) {
+        outlen = 1;
+    } else {
+        outlen = 0;
+    }
+
+    status = psa_call(TFM_PLATFORM_SERVICE_HANDLE,
+                      TFM_PLATFORM_API_ID_IOCTL_ASYNC_RESULT,
+                      in_vec, 1,
+                      output, outlen);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    } else {
+        return (enum tfm_platform_err_t)status;
+    }
+}
+
 enum tfm_platform_err_t
 tfm_platform_nv_counter_increment(uint32_t counter_id)
 {
@@ -106,3 +173,57 @@ tfm_platform_nv_counter_read(uint32_t counter_id,
         return (enum tfm_platform_err_t)status;
     }
 }
+
+enum tfm_platform_err_t
+tfm_platform_nv_counter_increment_multi(const uint32_t *counter_ids,
+                                        uint32_t num)
+{
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+    struct psa_invec in_vec[1];
+
+    if (num == 0 || num > TFM_PLATFORM_NV_COUNTER_MULTI_MAX) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    in_vec[0].base = counter_ids;
+    in_vec[0].len = num * sizeof(uint32_t);
+
+    status = psa_call(TFM_PLATFORM_SERVICE_HANDLE,
+                      TFM_PLATFORM_API_ID_NV_INCREMENT_MULTI,
+                      in_vec, 1, (psa_outvec *)NULL, 0);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    } else {
+        return (enum tfm_platform_err_t)status;
+    }
+}
+
+enum tfm_platform_err_t
+tfm_platform_nv_counter_read_multi(const uint32_t *counter_ids,
+                                   uint32_t num, uint32_t *vals)
+{
+    psa_status_t status = PSA_ERROR_CONNECTION_REFUSED;
+    struct psa_invec in_vec[1];
+    struct psa_outvec out_vec[1];
+
+    if (num == 0 || num > TFM_PLATFORM_NV_COUNTER_MULTI_MAX) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    in_vec[0].base = counter_ids;
+    in_vec[0].len = num * sizeof(uint32_t);
+
+    out_vec[0].base = vals;
+    out_vec[0].len = num * sizeof(uint32_t);
+
+    status = psa_call(TFM_PLATFORM_SERVICE_HANDLE,
+                      TFM_PLATFORM_API_ID_NV_READ_MULTI,
+                      in_vec, 1, out_vec, 1);
+
+    if (status < PSA_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    } else {
+        return (enum tfm_platform_err_t)status;
+    }
+}
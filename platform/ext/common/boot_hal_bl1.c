@@ -19,11 +19,16 @@
 #include "fih.h"
 #endif /* CRYPTO_HW_ACCELERATOR */
 
-#ifdef MEASURED_BOOT_API
+#if defined(MEASURED_BOOT_API) || defined(TFM_BOOT_TIMESTAMPS)
 #include "region_defs.h"
 #include "tfm_boot_status.h"
+#endif /* MEASURED_BOOT_API || TFM_BOOT_TIMESTAMPS */
+#ifdef MEASURED_BOOT_API
 #include "boot_measurement.h"
 #endif /* MEASURED_BOOT_API */
+#ifdef TFM_BOOT_TIMESTAMPS
+#include "boot_timestamp.h"
+#endif /* TFM_BOOT_TIMESTAMPS */
 
 /* Flash device name must be specified by target */
 extern ARM_DRIVER_FLASH FLASH_DEV_NAME;
@@ -234,7 +239,7 @@ __WEAK int boot_platform_post_load(uint32_t image_id)
     return 0;
 }
 
-#ifdef MEASURED_BOOT_API
+#if defined(MEASURED_BOOT_API) || defined(TFM_BOOT_TIMESTAMPS)
 static int boot_add_data_to_shared_area(uint8_t        major_type,
                                         uint16_t       minor_type,
                                         size_t         size,
@@ -300,7 +305,9 @@ static int boot_add_data_to_shared_area(uint8_t        major_type,
 
     return 0;
 }
+#endif /* MEASURED_BOOT_API || TFM_BOOT_TIMESTAMPS */
 
+#ifdef MEASURED_BOOT_API
 __WEAK int boot_store_measurement(
                             uint8_t index,
                             const uint8_t *measurement,
@@ -336,3 +343,20 @@ __WEAK int boot_store_measurement(
     return rc;
 }
 #endif /* MEASURED_BOOT_API */
+
+#ifdef TFM_BOOT_TIMESTAMPS
+__WEAK int boot_store_timestamps(uint8_t stage)
+{
+    const struct boot_ts_record_t *p_records;
+    size_t count;
+
+    count = boot_ts_fetch_records(&p_records);
+    if (count == 0) {
+        return 0;
+    }
+
+    return boot_add_data_to_shared_area(TLV_MAJOR_BTS, stage,
+                                        count * sizeof(*p_records),
+                                        (const uint8_t *)p_records);
+}
+#endif /* TFM_BOOT_TIMESTAMPS */
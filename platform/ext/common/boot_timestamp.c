@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "boot_timestamp.h"
+
+#include "cmsis.h"
+#include "cmsis_compiler.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define BOOT_TS_HAS_DWT_CYCCNT
+#endif
+
+static struct boot_ts_record_t boot_ts_records[BOOT_TS_MAX_RECORDS];
+static size_t boot_ts_count;
+/* Records before this index have been fetched already */
+static size_t boot_ts_fetched;
+
+__WEAK uint32_t boot_ts_get_time(void)
+{
+#ifdef BOOT_TS_HAS_DWT_CYCCNT
+    /* The counter is left running by the previous stages, don't reset it */
+    if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+void boot_ts_record(uint8_t stage, uint8_t checkpoint, uint16_t arg)
+{
+    struct boot_ts_record_t *p_record;
+
+    if (boot_ts_count >= BOOT_TS_MAX_RECORDS) {
+        return;
+    }
+
+    p_record = &boot_ts_records[boot_ts_count++];
+    p_record->stage = stage;
+    p_record->checkpoint = checkpoint;
+    p_record->arg = arg;
+    p_record->time = boot_ts_get_time();
+}
+
+size_t boot_ts_fetch_records(const struct boot_ts_record_t **p_records)
+{
+    size_t count = boot_ts_count - boot_ts_fetched;
+
+    *p_records = &boot_ts_records[boot_ts_fetched];
+    boot_ts_fetched = boot_ts_count;
+
+    return count;
+}
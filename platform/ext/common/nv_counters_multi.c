@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfm_plat_nv_counters.h"
+
+#include "cmsis_compiler.h"
+
+/*
+ * Default implementations accessing the counters one by one. The platforms
+ * which can access several counters at once override them.
+ */
+__WEAK enum tfm_plat_err_t tfm_plat_read_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num, uint32_t *vals)
+{
+    enum tfm_plat_err_t err;
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        err = tfm_plat_read_nv_counter(counter_ids[i], sizeof(vals[i]),
+                                       (uint8_t *)&vals[i]);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+__WEAK enum tfm_plat_err_t tfm_plat_increment_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num)
+{
+    enum tfm_plat_err_t err;
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        err = tfm_plat_increment_nv_counter(counter_ids[i]);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
@@ -17,6 +17,7 @@
 #include "Driver_Flash.h"
 #include "flash_layout.h"
 
+#include <stdbool.h>
 #include <string.h>
 
 static enum tfm_plat_err_t create_or_restore_layout(void);
@@ -74,6 +75,13 @@ static const uint32_t data_width_byte[] = {
 static enum tfm_plat_err_t make_backup(void);
 #endif
 
+#ifdef OTP_NV_COUNTERS_JOURNAL
+static void journal_patch(uint32_t offset, uint8_t *buf, uint32_t size);
+#if defined(OTP_WRITEABLE)
+static void journal_extend_range(size_t *start, size_t *end);
+#endif
+#endif
+
 /* Compilation time checks to be sure the defines are well defined */
 #ifndef TFM_OTP_NV_COUNTERS_AREA_ADDR
 #error "TFM_OTP_NV_COUNTERS_AREA_ADDR must be defined in flash_layout.h"
@@ -124,7 +132,8 @@ static uint8_t block[OTP_NV_COUNTERS_WRITE_BLOCK_SIZE];
 /* Import the CMSIS flash device driver */
 extern ARM_DRIVER_FLASH OTP_NV_COUNTERS_FLASH_DEV;
 
-enum tfm_plat_err_t read_otp_nv_counters_flash(uint32_t offset, void *data, uint32_t cnt)
+static enum tfm_plat_err_t read_otp_nv_counters_area(uint32_t offset, void *data,
+                                                     uint32_t cnt)
 {
     enum tfm_plat_err_t err = TFM_PLAT_ERR_SUCCESS;
     ARM_FLASH_CAPABILITIES DriverCapabilities;
@@ -164,7 +173,7 @@ enum tfm_plat_err_t read_otp_nv_counters_flash(uint32_t offset, void *data, uint
     return TFM_PLAT_ERR_SUCCESS;
 }
 
-enum tfm_plat_err_t init_otp_nv_counters_flash(void)
+static enum tfm_plat_err_t init_otp_nv_counters_area(void)
 {
     enum tfm_plat_err_t err = TFM_PLAT_ERR_SUCCESS;
     uint32_t init_value;
@@ -180,13 +189,13 @@ enum tfm_plat_err_t init_otp_nv_counters_flash(void)
         return TFM_PLAT_ERR_SYSTEM_ERR;
     }
 
-    err = read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, init_value),
+    err = read_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, init_value),
             &init_value, sizeof(init_value));
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
     }
 
-    err = read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
+    err = read_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
             &swap_count, sizeof(swap_count));
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
@@ -200,7 +209,7 @@ enum tfm_plat_err_t init_otp_nv_counters_flash(void)
     }
     else
     {
-        err = read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, swap_count)
+        err = read_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, swap_count)
                 + TFM_OTP_NV_COUNTERS_AREA_SIZE,
                 &backup_swap_count, sizeof(backup_swap_count));
         if (err != TFM_PLAT_ERR_SUCCESS) {
@@ -302,7 +311,9 @@ static enum tfm_plat_err_t make_backup(void)
     return err;
 }
 
-enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *data, uint32_t cnt)
+static enum tfm_plat_err_t write_otp_nv_counters_area(uint32_t offset,
+                                                      const void *data,
+                                                      uint32_t cnt)
 {
     enum tfm_plat_err_t err = TFM_PLAT_ERR_SUCCESS;
     size_t copy_size;
@@ -322,6 +333,11 @@ enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *dat
     DriverCapabilities = OTP_NV_COUNTERS_FLASH_DEV.GetCapabilities();
     data_width = data_width_byte[DriverCapabilities.data_width];
 
+#ifdef OTP_NV_COUNTERS_JOURNAL
+    /* The journalled words are written too, as the journal becomes stale */
+    journal_extend_range(&start, &end);
+#endif
+
     if (end > TFM_OTP_NV_COUNTERS_AREA_SIZE) {
         /* Erase is beyond the TFM_OTP_NV_COUNTERS_AREA */
         return TFM_PLAT_ERR_SYSTEM_ERR;
@@ -340,9 +356,7 @@ enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *dat
         }
     }
 
-    err = erase_flash_region(round_down(TFM_OTP_NV_COUNTERS_AREA_ADDR + offset,
-                                        TFM_OTP_NV_COUNTERS_SECTOR_SIZE),
-                             round_up(cnt, TFM_OTP_NV_COUNTERS_SECTOR_SIZE));
+    err = erase_flash_region(TFM_OTP_NV_COUNTERS_AREA_ADDR + start, end - start);
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
     }
@@ -363,7 +377,11 @@ enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *dat
             return TFM_PLAT_ERR_SYSTEM_ERR;
         }
 
-        if (idx + copy_size >= offset && idx < offset + cnt) {
+#ifdef OTP_NV_COUNTERS_JOURNAL
+        journal_patch(idx, block, copy_size);
+#endif
+
+        if (idx + copy_size > offset && idx < offset + cnt) {
             input_copy_size = sizeof(block) - ((offset + input_idx) % sizeof(block));
             if (input_idx + input_copy_size > cnt) {
                 input_copy_size = cnt - input_idx;
@@ -420,7 +438,7 @@ enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *dat
     }
 
     /* Read, modify, and write the swap count */
-    err = read_otp_nv_counters_flash(round_down(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
+    err = read_otp_nv_counters_area(round_down(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
                                      TFM_HAL_ITS_PROGRAM_UNIT) + TFM_OTP_NV_COUNTERS_AREA_SIZE,
                                      swap_count_buf, sizeof(swap_count_buf));
     if (err != TFM_PLAT_ERR_SUCCESS) {
@@ -482,13 +500,13 @@ static enum tfm_plat_err_t create_or_restore_layout(void)
     DriverCapabilities = OTP_NV_COUNTERS_FLASH_DEV.GetCapabilities();
     data_width = data_width_byte[DriverCapabilities.data_width];
 
-    err = read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, init_value)
+    err = read_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, init_value)
             + TFM_OTP_NV_COUNTERS_AREA_SIZE,
             &backup_init_value, sizeof(init_value));
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
     }
-    err = read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, swap_count)
+    err = read_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, swap_count)
             + TFM_OTP_NV_COUNTERS_AREA_SIZE,
             &backup_swap_count, sizeof(swap_count));
     if (err != TFM_PLAT_ERR_SUCCESS) {
@@ -528,14 +546,14 @@ static enum tfm_plat_err_t create_or_restore_layout(void)
         }
 
         init_value = OTP_NV_COUNTERS_INITIALIZED;
-        err = write_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, init_value),
+        err = write_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, init_value),
                 &init_value, sizeof(init_value));
         if (err != ARM_DRIVER_OK) {
             return TFM_PLAT_ERR_SYSTEM_ERR;
         }
 
         swap_count = 1;
-        err = write_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
+        err = write_otp_nv_counters_area(offsetof(struct flash_otp_nv_counters_region_t, swap_count),
                 &swap_count, sizeof(swap_count));
         if (err != ARM_DRIVER_OK) {
             return TFM_PLAT_ERR_SYSTEM_ERR;
@@ -545,4 +563,526 @@ static enum tfm_plat_err_t create_or_restore_layout(void)
 }
 #endif /*  OTP_WRITEABLE */
 
+#ifdef OTP_NV_COUNTERS_JOURNAL
+/*
+ * Counter journal. Updates of a single NV counter word of the OTP / NV counter
+ * area, such as counter increments, are appended as records to a dedicated
+ * journal area instead of rewriting the area. The NV counter words are kept in
+ * a RAM shadow built at initialization, with the journal replayed on top of
+ * it. The rest of the area, which holds the keys and other OTP values, is not
+ * shadowed and is read from flash. When the journal is full, or an update
+ * can't be journalled, the area is rewritten with the shadow applied and the
+ * journal is erased.
+ *
+ * The journal starts with a header record which holds the swap count of the
+ * area it applies to. Rewriting the area increments the swap count, so a
+ * journal left behind by an interrupted compaction is recognized as stale.
+ */
+#ifndef TFM_OTP_NV_COUNTERS_JOURNAL_AREA_ADDR
+#error "TFM_OTP_NV_COUNTERS_JOURNAL_AREA_ADDR must be defined in flash_layout.h"
+#endif
+#ifndef TFM_OTP_NV_COUNTERS_JOURNAL_AREA_SIZE
+#error "TFM_OTP_NV_COUNTERS_JOURNAL_AREA_SIZE must be defined in flash_layout.h"
+#endif
+#if !defined(PLATFORM_DEFAULT_NV_COUNTERS) && \
+    !(defined(PLATFORM_DEFAULT_OTP) && \
+      (defined(BL2) || defined(BL1) || (PLATFORM_NS_NV_COUNTERS > 0)))
+#error "OTP_NV_COUNTERS_JOURNAL requires NV counters in the OTP / NV counter area"
+#endif
+
+struct journal_record_t {
+    uint32_t offset;            /* Offset of the word in the area */
+    uint32_t value;             /* New value of the word */
+    uint32_t check;             /* journal_check() of the above */
+};
+
+#define JOURNAL_RECORD_SIZE     ((sizeof(struct journal_record_t) + \
+                                  TFM_HAL_ITS_PROGRAM_UNIT - 1) / \
+                                 TFM_HAL_ITS_PROGRAM_UNIT * \
+                                 TFM_HAL_ITS_PROGRAM_UNIT)
+#define JOURNAL_RECORD_NUM      (TFM_OTP_NV_COUNTERS_JOURNAL_AREA_SIZE / \
+                                 JOURNAL_RECORD_SIZE)
+#define JOURNAL_RECORD_ADDR(idx) (TFM_OTP_NV_COUNTERS_JOURNAL_AREA_ADDR + \
+                                  (idx) * JOURNAL_RECORD_SIZE)
+
+/* Offset field of the header record */
+#define JOURNAL_HEADER_OFFSET   0xFFFF0000U
+
+#define REGION_FIELD_OFFSET(field) \
+    offsetof(struct flash_otp_nv_counters_region_t, field)
+#define REGION_FIELD_SIZE(field) \
+    sizeof(((struct flash_otp_nv_counters_region_t *)0)->field)
+
+/* Sizes of the journalled NV counter fields, the counters of a kind are
+ * contiguous in the area.
+ */
+#if defined(PLATFORM_DEFAULT_OTP) && defined(BL2)
+#define JOURNAL_BL2_SIZE        (REGION_FIELD_OFFSET(bl2_rotpk_2) - \
+                                 REGION_FIELD_OFFSET(bl2_nv_counter_0))
+#else
+#define JOURNAL_BL2_SIZE        0
+#endif
+#if defined(PLATFORM_DEFAULT_OTP) && defined(BL1)
+#define JOURNAL_BL1_SIZE        REGION_FIELD_SIZE(bl1_nv_counter_0)
+#else
+#define JOURNAL_BL1_SIZE        0
+#endif
+#if defined(PLATFORM_DEFAULT_OTP) && (PLATFORM_NS_NV_COUNTERS > 0)
+#define JOURNAL_NS_SIZE         (REGION_FIELD_OFFSET(entropy_seed) - \
+                                 REGION_FIELD_OFFSET(ns_nv_counter_0))
+#else
+#define JOURNAL_NS_SIZE         0
+#endif
+#ifdef PLATFORM_DEFAULT_NV_COUNTERS
+#define JOURNAL_FLASH_SIZE      REGION_FIELD_SIZE(flash_nv_counters)
+#else
+#define JOURNAL_FLASH_SIZE      0
+#endif
+
+#define JOURNAL_SHADOW_SIZE     (JOURNAL_BL2_SIZE + JOURNAL_BL1_SIZE + \
+                                 JOURNAL_NS_SIZE + JOURNAL_FLASH_SIZE)
+
+/* Word aligned range of the area whose words are journalled */
+struct journal_range_t {
+    uint32_t offset;
+    uint32_t size;
+};
+
+static const struct journal_range_t journal_ranges[] = {
+#if defined(PLATFORM_DEFAULT_OTP) && defined(BL2)
+    {REGION_FIELD_OFFSET(bl2_nv_counter_0), JOURNAL_BL2_SIZE},
+#endif
+#if defined(PLATFORM_DEFAULT_OTP) && defined(BL1)
+    {REGION_FIELD_OFFSET(bl1_nv_counter_0), JOURNAL_BL1_SIZE},
+#endif
+#if defined(PLATFORM_DEFAULT_OTP) && (PLATFORM_NS_NV_COUNTERS > 0)
+    {REGION_FIELD_OFFSET(ns_nv_counter_0), JOURNAL_NS_SIZE},
+#endif
+#ifdef PLATFORM_DEFAULT_NV_COUNTERS
+    {REGION_FIELD_OFFSET(flash_nv_counters), JOURNAL_FLASH_SIZE},
+#endif
+};
+
+#define JOURNAL_RANGE_NUM       (sizeof(journal_ranges) / sizeof(journal_ranges[0]))
+
+/* The journalled words, in the order of journal_ranges */
+static uint32_t shadow[JOURNAL_SHADOW_SIZE / sizeof(uint32_t)];
+static bool shadow_valid;
+/* Swap count of the area the journal applies to */
+static uint32_t journal_swap_count;
+/* Index of the first empty record in journal */
+static uint32_t journal_next;
+
+/* CRC-32 (IEEE 802.3) of the offset and value of a record */
+static uint32_t journal_check(uint32_t offset, uint32_t value)
+{
+    uint8_t buf[2 * sizeof(uint32_t)];
+    uint32_t crc = 0xFFFFFFFFU;
+    uint32_t i, bit;
+
+    memcpy(buf, &offset, sizeof(offset));
+    memcpy(buf + sizeof(offset), &value, sizeof(value));
+
+    for (i = 0; i < sizeof(buf); i++) {
+        crc ^= buf[i];
+        for (bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+        }
+    }
+
+    return ~crc;
+}
+
+/* Find the shadow index of the word at offset, if it is journalled */
+static bool journal_word_index(uint32_t offset, uint32_t *idx)
+{
+    uint32_t base = 0;
+    uint32_t i;
+
+    if (offset % sizeof(uint32_t)) {
+        return false;
+    }
+
+    for (i = 0; i < JOURNAL_RANGE_NUM; i++) {
+        if ((offset >= journal_ranges[i].offset) &&
+            (offset < journal_ranges[i].offset + journal_ranges[i].size)) {
+            *idx = base + (offset - journal_ranges[i].offset) / sizeof(uint32_t);
+            return true;
+        }
+        base += journal_ranges[i].size / sizeof(uint32_t);
+    }
+
+    return false;
+}
+
+/* Copy the shadowed words of [offset, offset + size) into buf, which holds
+ * the area content of that range.
+ */
+static void journal_patch(uint32_t offset, uint8_t *buf, uint32_t size)
+{
+    uint32_t base = 0;
+    uint32_t start, end;
+    uint32_t i;
+
+    if (!shadow_valid) {
+        return;
+    }
+
+    for (i = 0; i < JOURNAL_RANGE_NUM; i++) {
+        start = journal_ranges[i].offset > offset ?
+                journal_ranges[i].offset : offset;
+        end = journal_ranges[i].offset + journal_ranges[i].size < offset + size ?
+              journal_ranges[i].offset + journal_ranges[i].size : offset + size;
+
+        if (start < end) {
+            memcpy(buf + (start - offset),
+                   (uint8_t *)&shadow[base] + (start - journal_ranges[i].offset),
+                   end - start);
+        }
+        base += journal_ranges[i].size / sizeof(uint32_t);
+    }
+}
+
+#if defined(OTP_WRITEABLE)
+/* Extend the sector range rewritten in the area to the journalled words */
+static void journal_extend_range(size_t *start, size_t *end)
+{
+    size_t range_start, range_end;
+    uint32_t i;
+
+    if (!shadow_valid) {
+        return;
+    }
+
+    for (i = 0; i < JOURNAL_RANGE_NUM; i++) {
+        range_start = round_down(journal_ranges[i].offset,
+                                 TFM_OTP_NV_COUNTERS_SECTOR_SIZE);
+        range_end = round_up(journal_ranges[i].offset + journal_ranges[i].size,
+                             TFM_OTP_NV_COUNTERS_SECTOR_SIZE);
+        if (range_start < *start) {
+            *start = range_start;
+        }
+        if (range_end > *end) {
+            *end = range_end;
+        }
+    }
+}
+#endif /* OTP_WRITEABLE */
+
+static enum tfm_plat_err_t journal_read_record(uint32_t idx,
+                                               struct journal_record_t *rec,
+                                               bool *is_erased)
+{
+    uint8_t rec_buf[JOURNAL_RECORD_SIZE];
+    ARM_FLASH_CAPABILITIES DriverCapabilities;
+    uint8_t data_width;
+    uint32_t i;
+    int32_t ret;
+
+    DriverCapabilities = OTP_NV_COUNTERS_FLASH_DEV.GetCapabilities();
+    data_width = data_width_byte[DriverCapabilities.data_width];
+
+    ret = OTP_NV_COUNTERS_FLASH_DEV.ReadData(JOURNAL_RECORD_ADDR(idx), rec_buf,
+                                             sizeof(rec_buf) / data_width);
+    if (ret < 0) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    *is_erased = true;
+    for (i = 0; i < sizeof(rec_buf); i++) {
+        if (rec_buf[i] != 0xFF) {
+            *is_erased = false;
+            break;
+        }
+    }
+
+    memcpy(rec, rec_buf, sizeof(*rec));
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+#if defined(OTP_WRITEABLE)
+static enum tfm_plat_err_t journal_erase(void)
+{
+    journal_next = 0;
+
+    return erase_flash_region(TFM_OTP_NV_COUNTERS_JOURNAL_AREA_ADDR,
+                              TFM_OTP_NV_COUNTERS_JOURNAL_AREA_SIZE);
+}
+#endif /* OTP_WRITEABLE */
+
+/* Build the shadow from the area and the journal */
+static enum tfm_plat_err_t journal_load(void)
+{
+    enum tfm_plat_err_t err;
+    struct journal_record_t rec;
+    bool is_erased;
+    uint32_t base = 0;
+    uint32_t idx, word_idx;
+
+    shadow_valid = false;
+
+    /* The header and at least one record must fit in the journal */
+    if (JOURNAL_RECORD_NUM < 2) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    for (idx = 0; idx < JOURNAL_RANGE_NUM; idx++) {
+        err = read_otp_nv_counters_area(journal_ranges[idx].offset,
+                                        &shadow[base],
+                                        journal_ranges[idx].size);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+        base += journal_ranges[idx].size / sizeof(uint32_t);
+    }
+
+    err = read_otp_nv_counters_area(REGION_FIELD_OFFSET(swap_count),
+                                    &journal_swap_count,
+                                    sizeof(journal_swap_count));
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    err = journal_read_record(0, &rec, &is_erased);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+    journal_next = 0;
+
+    if (!is_erased) {
+        if ((rec.offset != JOURNAL_HEADER_OFFSET) ||
+            (rec.check != journal_check(rec.offset, rec.value)) ||
+            (rec.value != journal_swap_count)) {
+            /* The journal doesn't apply to the current area content */
+#if defined(OTP_WRITEABLE)
+            err = journal_erase();
+            if (err != TFM_PLAT_ERR_SUCCESS) {
+                return err;
+            }
+#else
+            /* Not writeable, so all the journal records are ignored */
+            journal_next = JOURNAL_RECORD_NUM;
+#endif
+        } else {
+            for (idx = 1; idx < JOURNAL_RECORD_NUM; idx++) {
+                err = journal_read_record(idx, &rec, &is_erased);
+                if (err != TFM_PLAT_ERR_SUCCESS) {
+                    return err;
+                }
+
+                if (is_erased) {
+                    break;
+                }
+
+                /* Skip the records torn by a power failure */
+                if ((rec.check != journal_check(rec.offset, rec.value)) ||
+                    !journal_word_index(rec.offset, &word_idx)) {
+                    continue;
+                }
+
+                shadow[word_idx] = rec.value;
+            }
+
+            journal_next = idx;
+        }
+    }
+
+    shadow_valid = true;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+#if defined(OTP_WRITEABLE)
+static enum tfm_plat_err_t journal_program_record(uint32_t offset,
+                                                  uint32_t value)
+{
+    uint8_t rec_buf[JOURNAL_RECORD_SIZE];
+    struct journal_record_t rec;
+    ARM_FLASH_CAPABILITIES DriverCapabilities;
+    uint8_t data_width;
+    int32_t ret;
+
+    DriverCapabilities = OTP_NV_COUNTERS_FLASH_DEV.GetCapabilities();
+    data_width = data_width_byte[DriverCapabilities.data_width];
+
+    rec.offset = offset;
+    rec.value = value;
+    rec.check = journal_check(offset, value);
+
+    memset(rec_buf, 0xFF, sizeof(rec_buf));
+    memcpy(rec_buf, &rec, sizeof(rec));
+
+    ret = OTP_NV_COUNTERS_FLASH_DEV.ProgramData(JOURNAL_RECORD_ADDR(journal_next),
+                                                rec_buf,
+                                                sizeof(rec_buf) / data_width);
+    /* The slot is consumed even if programming failed part way */
+    journal_next++;
+
+    if ((ret < 0) || (ret > 0 && ret != sizeof(rec_buf) / data_width)) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+/* Write the update to the area together with the shadow, and restart the
+ * journal.
+ */
+static enum tfm_plat_err_t journal_compact(uint32_t offset, const void *data,
+                                           uint32_t cnt)
+{
+    enum tfm_plat_err_t err;
+
+    /* The shadow stays valid during the write, to be applied to the area */
+    err = write_otp_nv_counters_area(offset, data, cnt);
+    if (err == TFM_PLAT_ERR_SUCCESS) {
+        /* The journal is stale now, as the swap count was incremented */
+        err = journal_erase();
+    }
+
+    /* Reload the shadow in any case, to keep it consistent with flash */
+    if (journal_load() != TFM_PLAT_ERR_SUCCESS) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    return err;
+}
+
+static enum tfm_plat_err_t journal_write(uint32_t offset, const void *data,
+                                         uint32_t cnt)
+{
+    enum tfm_plat_err_t err;
+    uint8_t word_buf[sizeof(uint32_t)];
+    uint32_t word_offset, word_idx, changed_idx = 0, changed_offset = 0;
+    uint32_t start, end, copy_start, copy_end;
+    uint32_t changed = 0;
+    uint32_t value, changed_value = 0;
+
+    if (!shadow_valid) {
+        return TFM_PLAT_ERR_SYSTEM_ERR;
+    }
+
+    if ((cnt == 0) ||
+        (offset >= sizeof(struct flash_otp_nv_counters_region_t)) ||
+        (cnt > sizeof(struct flash_otp_nv_counters_region_t) - offset)) {
+        return TFM_PLAT_ERR_INVALID_INPUT;
+    }
+
+    /* Find the words which change. Updates of words which aren't journalled
+     * rewrite the area directly.
+     */
+    start = offset & ~(sizeof(uint32_t) - 1);
+    end = offset + cnt;
+    for (word_offset = start; word_offset < end;
+         word_offset += sizeof(uint32_t)) {
+        if (!journal_word_index(word_offset, &word_idx)) {
+            return journal_compact(offset, data, cnt);
+        }
+
+        memcpy(word_buf, &shadow[word_idx], sizeof(word_buf));
+
+        copy_start = word_offset < offset ? offset : word_offset;
+        copy_end = word_offset + sizeof(uint32_t) < end ?
+                   word_offset + sizeof(uint32_t) : end;
+        memcpy(word_buf + (copy_start - word_offset),
+               (const uint8_t *)data + (copy_start - offset),
+               copy_end - copy_start);
+
+        memcpy(&value, word_buf, sizeof(value));
+        if (value != shadow[word_idx]) {
+            changed++;
+            changed_idx = word_idx;
+            changed_offset = word_offset;
+            changed_value = value;
+        }
+    }
+
+    if (changed == 0) {
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
+    /*
+     * A single record is atomic. Updates of several words go to the area, so
+     * that they can't be torn.
+     */
+    if ((changed > 1) ||
+        (journal_next + (journal_next == 0 ? 2 : 1) > JOURNAL_RECORD_NUM)) {
+        return journal_compact(offset, data, cnt);
+    }
+
+    /*
+     * A failed program may leave a torn header or record behind. Records
+     * can't be appended after a torn header, and a torn record may be lost, so
+     * the update is written to the area instead, which also erases the
+     * journal.
+     */
+    if (journal_next == 0) {
+        err = journal_program_record(JOURNAL_HEADER_OFFSET, journal_swap_count);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return journal_compact(offset, data, cnt);
+        }
+    }
+
+    err = journal_program_record(changed_offset, changed_value);
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return journal_compact(offset, data, cnt);
+    }
+
+    shadow[changed_idx] = changed_value;
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+#endif /* OTP_WRITEABLE */
+#endif /* OTP_NV_COUNTERS_JOURNAL */
+
+enum tfm_plat_err_t read_otp_nv_counters_flash(uint32_t offset, void *data, uint32_t cnt)
+{
+    enum tfm_plat_err_t err;
+
+    err = read_otp_nv_counters_area(offset, data, cnt);
+
+#ifdef OTP_NV_COUNTERS_JOURNAL
+    /* The area doesn't hold the journalled updates of the NV counters */
+    if (err == TFM_PLAT_ERR_SUCCESS) {
+        journal_patch(offset, data, cnt);
+    }
+#endif
+
+    return err;
+}
+
+enum tfm_plat_err_t init_otp_nv_counters_flash(void)
+{
+    enum tfm_plat_err_t err;
+
+#ifdef OTP_NV_COUNTERS_JOURNAL
+    /* The area is restored without the shadow, it is built afterwards */
+    shadow_valid = false;
+#endif
+
+    err = init_otp_nv_counters_area();
+    if (err != TFM_PLAT_ERR_SUCCESS) {
+        return err;
+    }
+
+#ifdef OTP_NV_COUNTERS_JOURNAL
+    err = journal_load();
+#endif
+
+    return err;
+}
+
+#if defined(OTP_WRITEABLE)
+enum tfm_plat_err_t write_otp_nv_counters_flash(uint32_t offset, const void *data, uint32_t cnt)
+{
+#ifdef OTP_NV_COUNTERS_JOURNAL
+    return journal_write(offset, data, cnt);
+#else
+    return write_otp_nv_counters_area(offset, data, cnt);
+#endif
+}
+#endif /* OTP_WRITEABLE */
+
 #endif /* OTP_NV_COUNTERS_RAM_EMULATION */
@@ -22,11 +22,28 @@
 #include "flash_otp_nv_counters_backend.h"
 #endif
 
+#include <stdbool.h>
 #include <string.h>
 
 #define OTP_COUNTER_MAX_SIZE    128u
 #define NV_COUNTER_SIZE         4
 
+#if defined(BL2) || defined(BL1)
+/*
+ * Cache of the OTP counter values, as reading and counting the OTP elements is
+ * slow. An entry is only used if its check word matches the value, so the
+ * zero initialised entries and corrupted ones are read from OTP again.
+ */
+#define NV_COUNTER_CACHE_CHECK(value)   ((value) ^ 0x5AA5C33Cu)
+
+struct nv_counter_cache_entry_t {
+    uint32_t value;
+    uint32_t check;
+};
+
+static struct nv_counter_cache_entry_t nv_counter_cache[PLAT_NV_COUNTER_MAX];
+#endif /* BL2 || BL1 */
+
 #ifdef TFM_PARTITION_PROTECTED_STORAGE
 enum flash_nv_counter_id_t {
     FLASH_NV_COUNTER_ID_PS_0 = 0,
@@ -38,6 +55,21 @@ enum flash_nv_counter_id_t {
 
 enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
 {
+#if defined(BL2) || defined(BL1)
+    enum tfm_nv_counter_t counter_id;
+    uint32_t value;
+
+    /*
+     * Fill the cache with the counters of this image. Counters which can't be
+     * read now are read from OTP again on first use.
+     */
+    for (counter_id = PLAT_NV_COUNTER_BL2_0; counter_id < PLAT_NV_COUNTER_MAX;
+         counter_id++) {
+        (void)tfm_plat_read_nv_counter(counter_id, sizeof(value),
+                                       (uint8_t *)&value);
+    }
+#endif /* BL2 || BL1 */
+
 #ifdef TFM_PARTITION_PROTECTED_STORAGE
     if (FLASH_NV_COUNTER_ID_MAX > FLASH_NV_COUNTER_AM) {
         return TFM_PLAT_ERR_SYSTEM_ERR;
@@ -50,16 +82,33 @@ enum tfm_plat_err_t tfm_plat_init_nv_counter(void)
 }
 
 #if defined(BL2) || defined(BL1)
-static enum tfm_plat_err_t read_nv_counter_otp(enum tfm_otp_element_id_t id,
+/* Number of set bits in a word */
+static inline uint32_t popcount_word(uint32_t word)
+{
+    word = word - ((word >> 1) & 0x55555555u);
+    word = (word & 0x33333333u) + ((word >> 2) & 0x33333333u);
+    word = (word + (word >> 4)) & 0x0F0F0F0Fu;
+
+    return (word * 0x01010101u) >> 24;
+}
+
+static enum tfm_plat_err_t read_nv_counter_otp(enum tfm_nv_counter_t counter_id,
+                                               enum tfm_otp_element_id_t id,
                                                uint32_t size, uint8_t *val)
 {
+    struct nv_counter_cache_entry_t *p_entry = &nv_counter_cache[counter_id];
     size_t counter_size;
+    size_t padded_size;
     enum tfm_plat_err_t err;
-    size_t byte_idx;
-    uint8_t bit_idx;
-    uint8_t counter_value[OTP_COUNTER_MAX_SIZE];
+    size_t word_idx;
+    uint32_t counter_value[OTP_COUNTER_MAX_SIZE / sizeof(uint32_t)];
     uint32_t count;
 
+    if (p_entry->check == NV_COUNTER_CACHE_CHECK(p_entry->value)) {
+        memcpy(val, &p_entry->value, NV_COUNTER_SIZE);
+        return TFM_PLAT_ERR_SUCCESS;
+    }
+
     err = tfm_plat_otp_get_size(id, &counter_size);
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
@@ -67,18 +116,25 @@ static enum tfm_plat_err_t read_nv_counter_otp(enum tfm_otp_element_id_t id,
 
     counter_size = counter_size > OTP_COUNTER_MAX_SIZE ? OTP_COUNTER_MAX_SIZE : counter_size;
 
-    err = tfm_plat_otp_read(id, counter_size, counter_value);
+    err = tfm_plat_otp_read(id, counter_size, (uint8_t *)counter_value);
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
     }
 
+    /* Clear the unused bytes of the last word, then count word by word */
+    padded_size = (counter_size + sizeof(uint32_t) - 1) &
+                  ~(sizeof(uint32_t) - 1);
+    memset((uint8_t *)counter_value + counter_size, 0,
+           padded_size - counter_size);
+
     count = 0;
-    for (byte_idx = 0; byte_idx < counter_size; byte_idx++) {
-        for (bit_idx = 0; bit_idx < 8; bit_idx++) {
-            count += (counter_value[byte_idx] >> bit_idx) & 1;
-        }
+    for (word_idx = 0; word_idx < padded_size / sizeof(uint32_t); word_idx++) {
+        count += popcount_word(counter_value[word_idx]);
     }
 
+    p_entry->value = count;
+    p_entry->check = NV_COUNTER_CACHE_CHECK(count);
+
     memcpy(val, &count, NV_COUNTER_SIZE);
 
     return TFM_PLAT_ERR_SUCCESS;
@@ -126,31 +182,31 @@ enum tfm_plat_err_t tfm_plat_read_nv_counter(enum tfm_nv_counter_t counter_id,
 
 #ifdef BL2
     case (PLAT_NV_COUNTER_BL2_0):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_0, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_0, size, val);
     case (PLAT_NV_COUNTER_BL2_1):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_1, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_1, size, val);
     case (PLAT_NV_COUNTER_BL2_2):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_2, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_2, size, val);
     case (PLAT_NV_COUNTER_BL2_3):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_3, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_3, size, val);
 #endif /* BL2 */
 
 #ifdef BL1
     case (PLAT_NV_COUNTER_BL1_0):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL1_0, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL1_0, size, val);
 #endif /* BL1 */
 
 #if (PLATFORM_NS_NV_COUNTERS > 0)
     case (PLAT_NV_COUNTER_NS_0):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_0, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_0, size, val);
 #endif
 #if (PLATFORM_NS_NV_COUNTERS > 1)
     case (PLAT_NV_COUNTER_NS_1):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_1, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_1, size, val);
 #endif
 #if (PLATFORM_NS_NV_COUNTERS > 2)
     case (PLAT_NV_COUNTER_NS_2):
-        return read_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_2, size, val);
+        return read_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_2, size, val);
 #endif
 
     default:
@@ -159,7 +215,8 @@ enum tfm_plat_err_t tfm_plat_read_nv_counter(enum tfm_nv_counter_t counter_id,
 }
 
 #if defined(BL2) || defined(BL1)
-static enum tfm_plat_err_t set_nv_counter_otp(enum tfm_otp_element_id_t id,
+static enum tfm_plat_err_t set_nv_counter_otp(enum tfm_nv_counter_t counter_id,
+                                              enum tfm_otp_element_id_t id,
                                               uint32_t value)
 {
     size_t counter_size;
@@ -184,6 +241,13 @@ static enum tfm_plat_err_t set_nv_counter_otp(enum tfm_otp_element_id_t id,
     }
     counter_value[byte_idx] = (1 << (value % 8)) - 1;
 
+    /*
+     * Drop the cached value, so that the read back which verifies the write
+     * gets the value from OTP and refills the cache with it.
+     */
+    nv_counter_cache[counter_id].check = ~NV_COUNTER_CACHE_CHECK(
+                                            nv_counter_cache[counter_id].value);
+
     err = tfm_plat_otp_write(id, counter_size, counter_value);
     if (err != TFM_PLAT_ERR_SUCCESS) {
         return err;
@@ -251,38 +315,38 @@ enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
 
 #ifdef BL2
     case (PLAT_NV_COUNTER_BL2_0):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_0, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_0, value);
         break;
     case (PLAT_NV_COUNTER_BL2_1):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_1, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_1, value);
         break;
     case (PLAT_NV_COUNTER_BL2_2):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_2, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_2, value);
         break;
     case (PLAT_NV_COUNTER_BL2_3):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL2_3, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL2_3, value);
         break;
 #endif /* BL2 */
 
 #ifdef BL1
     case (PLAT_NV_COUNTER_BL1_0):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_BL1_0, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_BL1_0, value);
         break;
 #endif /* BL1 */
 
 #if (PLATFORM_NS_NV_COUNTERS > 0)
     case (PLAT_NV_COUNTER_NS_0):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_0, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_0, value);
         break;
 #endif
 #if (PLATFORM_NS_NV_COUNTERS > 1)
     case (PLAT_NV_COUNTER_NS_1):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_1, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_1, value);
         break;
 #endif
 #if (PLATFORM_NS_NV_COUNTERS > 2)
     case (PLAT_NV_COUNTER_NS_2):
-        err = set_nv_counter_otp(PLAT_OTP_ID_NV_COUNTER_NS_2, value);
+        err = set_nv_counter_otp(counter_id, PLAT_OTP_ID_NV_COUNTER_NS_2, value);
         break;
 #endif
 
@@ -328,3 +392,134 @@ enum tfm_plat_err_t tfm_plat_increment_nv_counter(
 
     return tfm_plat_set_nv_counter(counter_id, security_cnt + 1u);
 }
+
+#ifdef TFM_PARTITION_PROTECTED_STORAGE
+static bool is_nv_counter_flash(enum tfm_nv_counter_t counter_id)
+{
+    return (counter_id >= PLAT_NV_COUNTER_PS_0) &&
+           (counter_id <= PLAT_NV_COUNTER_PS_2);
+}
+
+static bool has_nv_counter_flash(const enum tfm_nv_counter_t *counter_ids,
+                                 uint32_t num)
+{
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        if (is_nv_counter_flash(counter_ids[i])) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* The counters kept in flash are accessed together, as a single array */
+static enum tfm_plat_err_t read_nv_counters_flash(
+                                uint32_t counters[FLASH_NV_COUNTER_ID_MAX])
+{
+    return read_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t,
+                                               flash_nv_counters),
+                                      counters,
+                                      FLASH_NV_COUNTER_ID_MAX * sizeof(uint32_t));
+}
+
+enum tfm_plat_err_t tfm_plat_read_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num, uint32_t *vals)
+{
+    uint32_t flash_counters[FLASH_NV_COUNTER_ID_MAX];
+    bool flash_read = false;
+    enum tfm_plat_err_t err;
+    uint32_t i;
+
+    for (i = 0; i < num; i++) {
+        if (!is_nv_counter_flash(counter_ids[i])) {
+            err = tfm_plat_read_nv_counter(counter_ids[i], sizeof(vals[i]),
+                                           (uint8_t *)&vals[i]);
+            if (err != TFM_PLAT_ERR_SUCCESS) {
+                return err;
+            }
+            continue;
+        }
+
+        if (!flash_read) {
+            err = read_nv_counters_flash(flash_counters);
+            if (err != TFM_PLAT_ERR_SUCCESS) {
+                return err;
+            }
+            flash_read = true;
+        }
+        vals[i] = flash_counters[counter_ids[i] - PLAT_NV_COUNTER_PS_0];
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_plat_increment_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num)
+{
+    uint32_t flash_counters[FLASH_NV_COUNTER_ID_MAX];
+    uint32_t new_counters[FLASH_NV_COUNTER_ID_MAX];
+    enum tfm_plat_err_t err;
+    uint32_t idx;
+    uint32_t i;
+
+    /*
+     * Only the counters kept in flash are incremented all together or not at
+     * all. The flash array is not accessed if the list has none of them.
+     */
+    if (has_nv_counter_flash(counter_ids, num)) {
+        err = read_nv_counters_flash(flash_counters);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+        memcpy(new_counters, flash_counters, sizeof(new_counters));
+
+        /* Check all of them before writing any */
+        for (i = 0; i < num; i++) {
+            if (!is_nv_counter_flash(counter_ids[i])) {
+                continue;
+            }
+
+            idx = counter_ids[i] - PLAT_NV_COUNTER_PS_0;
+            if (new_counters[idx] == UINT32_MAX) {
+                return TFM_PLAT_ERR_MAX_VALUE;
+            }
+            new_counters[idx]++;
+        }
+
+        err = write_otp_nv_counters_flash(offsetof(struct flash_otp_nv_counters_region_t,
+                                                   flash_nv_counters),
+                                          new_counters, sizeof(new_counters));
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+
+        /* Check that the write hasn't failed, as in tfm_plat_set_nv_counter */
+        err = read_nv_counters_flash(flash_counters);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+
+        if (memcmp(flash_counters, new_counters, sizeof(new_counters)) != 0) {
+            return TFM_PLAT_ERR_SYSTEM_ERR;
+        }
+    }
+
+    /* The other counters are in OTP, which is written one counter at a time */
+    for (i = 0; i < num; i++) {
+        if (is_nv_counter_flash(counter_ids[i])) {
+            continue;
+        }
+
+        err = tfm_plat_increment_nv_counter(counter_ids[i]);
+        if (err != TFM_PLAT_ERR_SUCCESS) {
+            return err;
+        }
+    }
+
+    return TFM_PLAT_ERR_SUCCESS;
+}
+#endif /* TFM_PARTITION_PROTECTED_STORAGE */
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "tfm_platform_system.h"
+
+#include "cmsis_compiler.h"
+
+/*
+ * By default no request completes later, and the platform service serves the
+ * asynchronous requests with tfm_platform_hal_ioctl() when they are started.
+ */
+__WEAK enum tfm_platform_err_t
+tfm_platform_hal_ioctl_async_start(int32_t client_id, uint32_t ticket,
+                                   tfm_platform_ioctl_req_t request,
+                                   psa_invec *in_vec)
+{
+    (void)client_id;
+    (void)ticket;
+    (void)request;
+    (void)in_vec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
+
+__WEAK enum tfm_platform_err_t
+tfm_platform_hal_ioctl_async_poll(uint32_t ticket, psa_outvec *out_vec)
+{
+    (void)ticket;
+    (void)out_vec;
+
+    return TFM_PLATFORM_ERR_NOT_SUPPORTED;
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "config_impl.h"
+#include "psa/client.h"
+#include "psa_manifest/sid.h"
+
+#ifdef CONFIG_TFM_SPM_PROFILING
+#include "ffm/spm_profiler.h"
+#endif
+
+#ifndef TFM_HOST_BENCH_ITERATIONS
+#define TFM_HOST_BENCH_ITERATIONS       100000
+#endif
+
+static const size_t payload_sizes[] = {0, 16, 256, 1024};
+
+static uint8_t in_buf[1024];
+static uint8_t out_buf[1024];
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_echo(size_t size)
+{
+    psa_invec in_vec[] = {{in_buf, size}};
+    psa_outvec out_vec[] = {{out_buf, size}};
+    psa_status_t status;
+    uint64_t start, elapsed;
+    uint32_t i;
+
+    start = bench_now_ns();
+    for (i = 0; i < TFM_HOST_BENCH_ITERATIONS; i++) {
+        status = psa_call(TFM_HOST_BENCH_ECHO_SERVICE_HANDLE, PSA_IPC_CALL,
+                          in_vec, 1, out_vec, 1);
+        if (status != PSA_SUCCESS) {
+            printf("psa_call failed: %" PRId32 "\n", status);
+            exit(EXIT_FAILURE);
+        }
+    }
+    elapsed = bench_now_ns() - start;
+
+    if (size && memcmp(in_buf, out_buf, size) != 0) {
+        printf("Echo mismatch for %zu bytes\n", size);
+        exit(EXIT_FAILURE);
+    }
+
+    printf("%-8zu %-12u %-14.1f %.0f\n", size, TFM_HOST_BENCH_ITERATIONS,
+           (double)elapsed / TFM_HOST_BENCH_ITERATIONS,
+           TFM_HOST_BENCH_ITERATIONS * 1e9 / (double)elapsed);
+}
+
+/*
+ * Entry of the benchmark client, an NS agent which measures psa_call() round
+ * trips to the echo service for several payload sizes.
+ */
+void tfm_host_bench_client_main(void)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(in_buf); i++) {
+        in_buf[i] = (uint8_t)i;
+    }
+
+    printf("TF-M host SPM benchmark, %s backend\n",
+           CONFIG_TFM_SPM_BACKEND_IPC == 1 ? "IPC" : "SFN");
+    printf("%-8s %-12s %-14s %s\n", "Bytes", "Calls", "ns/call", "calls/s");
+
+    for (i = 0; i < sizeof(payload_sizes) / sizeof(payload_sizes[0]); i++) {
+        bench_echo(payload_sizes[i]);
+    }
+
+#ifdef CONFIG_TFM_SPM_PROFILING
+    spm_profiler_dump(0);
+#endif
+
+    exit(EXIT_SUCCESS);
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "psa/service.h"
+#include "psa_manifest/tfm_host_bench_echo.h"
+
+#define ECHO_BUFFER_SIZE        1024
+
+/* Copy the input vector to the output vector through a partition buffer. */
+psa_status_t tfm_host_bench_echo_service_sfn(const psa_msg_t *msg)
+{
+    uint8_t buf[ECHO_BUFFER_SIZE];
+    size_t num;
+
+    if (msg->type != PSA_IPC_CALL) {
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+
+    if (msg->in_size[0] > sizeof(buf) || msg->out_size[0] < msg->in_size[0]) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    num = psa_read(msg->handle, 0, buf, msg->in_size[0]);
+    psa_write(msg->handle, 0, buf, num);
+
+    return PSA_SUCCESS;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/***** WARNING: This file SHOULD BE CHANGED according to storage template *****/
+
+#include <stdint.h>
+#include <stddef.h>
+#include "compiler_ext_defs.h"
+#include "config_impl.h"
+#include "spm_ipc.h"
+#include "load/partition_defs.h"
+#include "load/service_defs.h"
+#include "load/asset_defs.h"
+#include "psa_manifest/pid.h"
+#include "psa_manifest/sid.h"
+#include "psa_manifest/tfm_host_bench_echo.h"
+
+/*
+ * Load information of the host benchmark partitions. The client is an NS
+ * agent, so it gets a thread in both the IPC and SFN backends, and the echo
+ * partition is a SFN partition which runs on the common SFN thread in the IPC
+ * backend.
+ */
+
+#define TFM_SP_HOST_BENCH_CLIENT_STACK_SIZE                     (0x400)
+#define TFM_SP_HOST_BENCH_ECHO_STACK_SIZE                       (0x400)
+
+#define TFM_SP_HOST_BENCH_ECHO_NDEPS                            (0)
+#define TFM_SP_HOST_BENCH_ECHO_NSERVS                           (1)
+
+/* Entrypoint function declaration */
+extern void tfm_host_bench_client_main(void);
+
+/* Stacks, only used by the SPM for the thread runtime metadata */
+uint8_t tfm_sp_host_bench_client_stack[TFM_SP_HOST_BENCH_CLIENT_STACK_SIZE]
+                                                                __aligned(0x20);
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+uint8_t tfm_sp_host_bench_echo_stack[TFM_SP_HOST_BENCH_ECHO_STACK_SIZE]
+                                                                __aligned(0x20);
+#endif
+
+struct partition_tfm_sp_host_bench_client_load_info_t {
+    /* common length load data */
+    struct partition_load_info_t    load_info;
+    /* per-partition variable length load data */
+    uintptr_t                       stack_addr;
+    uintptr_t                       heap_addr;
+} __attribute__((aligned(4)));
+
+struct partition_tfm_sp_host_bench_echo_load_info_t {
+    /* common length load data */
+    struct partition_load_info_t    load_info;
+    /* per-partition variable length load data */
+    uintptr_t                       stack_addr;
+    uintptr_t                       heap_addr;
+    struct service_load_info_t      services[TFM_SP_HOST_BENCH_ECHO_NSERVS];
+} __attribute__((aligned(4)));
+
+/* Partition load, deps, service load data. Put to a dedicated section. */
+const struct partition_tfm_sp_host_bench_client_load_info_t
+    tfm_sp_host_bench_client_load
+    __attribute__((used, section(".part_load_priority_lowest"))) = {
+    .load_info = {
+        .psa_ff_ver                 = 0x0101 | PARTITION_INFO_MAGIC,
+        .pid                        = TFM_SP_HOST_BENCH_CLIENT,
+        .flags                      = (PARTITION_PRI_LOWEST - 1)
+                                    | PARTITION_MODEL_IPC
+                                    | PARTITION_MODEL_PSA_ROT
+                                    | PARTITION_NS_AGENT,
+        .entry                      = ENTRY_TO_POSITION(
+                                                tfm_host_bench_client_main),
+        .stack_size                 = TFM_SP_HOST_BENCH_CLIENT_STACK_SIZE,
+        .heap_size                  = 0,
+        .ndeps                      = 0,
+        .nservices                  = 0,
+        .nassets                    = 0,
+    },
+    .stack_addr                     =
+                                (uintptr_t)tfm_sp_host_bench_client_stack,
+    .heap_addr                      = 0,
+};
+
+const struct partition_tfm_sp_host_bench_echo_load_info_t
+    tfm_sp_host_bench_echo_load
+    __attribute__((used, section(".part_load_priority_normal"))) = {
+    .load_info = {
+        .psa_ff_ver                 = 0x0101 | PARTITION_INFO_MAGIC,
+        .pid                        = TFM_SP_HOST_BENCH_ECHO,
+        .flags                      = PARTITION_MODEL_PSA_ROT
+                                    | PARTITION_PRI_NORMAL,
+        .entry                      = 0,
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+        .stack_size                 = TFM_SP_HOST_BENCH_ECHO_STACK_SIZE,
+#else
+        .stack_size                 = 0,
+#endif
+        .heap_size                  = 0,
+        .ndeps                      = TFM_SP_HOST_BENCH_ECHO_NDEPS,
+        .nservices                  = TFM_SP_HOST_BENCH_ECHO_NSERVS,
+        .nassets                    = 0,
+    },
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+    .stack_addr                     = (uintptr_t)tfm_sp_host_bench_echo_stack,
+#else
+    .stack_addr                     = 0,
+#endif
+    .heap_addr                      = 0,
+    .services = {
+        {
+            .name_strid             =
+                            STRING_PTR_TO_STRID("TFM_HOST_BENCH_ECHO_SERVICE"),
+            .sfn                    =
+                        ENTRY_TO_POSITION(tfm_host_bench_echo_service_sfn),
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+            .signal                 = TFM_HOST_BENCH_ECHO_SERVICE_SIGNAL,
+#endif
+            .sid                    = TFM_HOST_BENCH_ECHO_SERVICE_SID,
+            .flags                  = 0
+                                    | SERVICE_FLAG_NS_ACCESSIBLE
+                                    | SERVICE_FLAG_STATELESS | 0x0
+                                    | SERVICE_VERSION_POLICY_STRICT,
+            .version                = TFM_HOST_BENCH_ECHO_SERVICE_VERSION,
+        },
+    },
+};
+
+/* Placeholder for partition and service runtime space. Do not reference it. */
+static struct partition_t tfm_sp_host_bench_client_partition_runtime_item
+    __attribute__((used, section(".bss.part_runtime_priority_lowest")));
+static struct partition_t tfm_sp_host_bench_echo_partition_runtime_item
+    __attribute__((used, section(".bss.part_runtime_priority_normal")));
+static struct service_t
+    tfm_sp_host_bench_echo_service_runtime_item[TFM_SP_HOST_BENCH_ECHO_NSERVS]
+    __attribute__((used, section(".bss.serv_runtime_priority_normal")));
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "fih.h"
+#include "spm_ipc.h"
+#include "tfm_arch.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
+#include "utilities.h"
+
+uintptr_t spm_boundary = (uintptr_t)NULL;
+
+/*
+ * Counterpart of the target 'main()' and SVC based SPM initialization. The
+ * initialization runs in the simulated 'SVC' state and then returns to the
+ * first partition thread, which never comes back here.
+ */
+int main(void)
+{
+    fih_int fih_rc = FIH_FAILURE;
+    uint32_t exc_return;
+
+    FIH_CALL(tfm_hal_set_up_static_boundaries, fih_rc, &spm_boundary);
+    if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
+        tfm_core_panic();
+    }
+
+    FIH_CALL(tfm_hal_platform_init, fih_rc);
+    if (fih_not_eq(fih_rc, fih_int_encode(TFM_HAL_SUCCESS))) {
+        tfm_core_panic();
+    }
+
+    exc_return = tfm_spm_init();
+
+    tfm_arch_free_msp_and_exc_ret(0, exc_return);
+
+    return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __HOST_CMSIS_H__
+#define __HOST_CMSIS_H__
+
+/*
+ * Device header of the host simulation. Only the core accessors used by the
+ * SPM common code are provided.
+ */
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+
+#define __NVIC_PRIO_BITS    3U
+
+/* Waiting with nothing else to run means no event will ever arrive. */
+void tfm_hal_host_wait_for_interrupt(void);
+
+#define __WFI()             tfm_hal_host_wait_for_interrupt()
+
+/*
+ * Thread stacks are host allocated and large, report a stack pointer which
+ * always passes the stack room checks.
+ */
+__STATIC_INLINE uint32_t __get_PSP(void)
+{
+    return UINT32_MAX;
+}
+
+#endif /* __HOST_CMSIS_H__ */
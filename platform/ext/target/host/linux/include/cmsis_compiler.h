@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __HOST_CMSIS_COMPILER_H__
+#define __HOST_CMSIS_COMPILER_H__
+
+/* Compiler abstraction of the host simulation, GCC and Clang only. */
+
+#include <stdint.h>
+
+#ifndef __ASM
+#define __ASM                   __asm
+#endif
+#ifndef __INLINE
+#define __INLINE                inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE         static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE    __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN             __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED                  __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK                  __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED                __attribute__((packed, aligned(1)))
+#endif
+#ifndef __PACKED_STRUCT
+#define __PACKED_STRUCT         struct __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)            __attribute__((aligned(x)))
+#endif
+#ifndef __RESTRICT
+#define __RESTRICT              __restrict
+#endif
+#ifndef __COMPILER_BARRIER
+#define __COMPILER_BARRIER()    __ASM volatile("":::"memory")
+#endif
+
+#define __DSB()                 __sync_synchronize()
+#define __DMB()                 __sync_synchronize()
+#define __ISB()                 __COMPILER_BARRIER()
+
+#endif /* __HOST_CMSIS_COMPILER_H__ */
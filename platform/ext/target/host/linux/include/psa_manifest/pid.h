@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PSA_MANIFEST_PID_H__
+#define __PSA_MANIFEST_PID_H__
+
+/* Partition IDs of the host benchmark, normally generated from manifests. */
+
+#define TFM_SP_HOST_BENCH_CLIENT                                 (0)
+#define TFM_SP_HOST_BENCH_ECHO                                   (256)
+
+#endif /* __PSA_MANIFEST_PID_H__ */
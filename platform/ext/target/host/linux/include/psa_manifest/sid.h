@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PSA_MANIFEST_SID_H__
+#define __PSA_MANIFEST_SID_H__
+
+/* Services of the host benchmark, normally generated from manifests. */
+
+/******** TFM_SP_HOST_BENCH_ECHO ********/
+#define TFM_HOST_BENCH_ECHO_SERVICE_SID                          (0x0000F100U)
+#define TFM_HOST_BENCH_ECHO_SERVICE_VERSION                      (1U)
+#define TFM_HOST_BENCH_ECHO_SERVICE_HANDLE                       (0x40000100U)
+
+#endif /* __PSA_MANIFEST_SID_H__ */
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PSA_MANIFEST_TFM_HOST_BENCH_ECHO_H__
+#define __PSA_MANIFEST_TFM_HOST_BENCH_ECHO_H__
+
+#include "psa/service.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TFM_HOST_BENCH_ECHO_SERVICE_SIGNAL                       (1U << 0)
+
+psa_status_t tfm_host_bench_echo_service_sfn(const psa_msg_t *msg);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PSA_MANIFEST_TFM_HOST_BENCH_ECHO_H__ */
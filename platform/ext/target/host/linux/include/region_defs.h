@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __REGION_DEFS_H__
+#define __REGION_DEFS_H__
+
+/*
+ * The host simulation has no memory map, the image is laid out by the host
+ * linker. See 'host_sections.ld' for the sections the SPM relies on.
+ */
+
+#endif /* __REGION_DEFS_H__ */
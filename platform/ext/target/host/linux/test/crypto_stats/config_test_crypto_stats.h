@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CONFIG_TEST_CRYPTO_STATS_H__
+#define __CONFIG_TEST_CRYPTO_STATS_H__
+
+/* Crypto Partition Configs of the statistics host test */
+
+/* Heap size for the crypto backend */
+#define CRYPTO_ENGINE_BUF_SIZE                 0x2000
+
+/*
+ * Serve the Mbed Crypto allocations from power of two size classes carved from
+ * the engine buffer, instead of the Mbed TLS buffer allocator
+ */
+#define CRYPTO_ENGINE_SLAB_ALLOC               1
+
+/* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
+#define CRYPTO_CONC_OPER_NUM                   4
+
+/* Only the statistics module is built, the other modules need Mbed Crypto */
+#define CRYPTO_RNG_MODULE_ENABLED              0
+#define CRYPTO_KEY_MODULE_ENABLED              0
+#define CRYPTO_AEAD_MODULE_ENABLED             0
+#define CRYPTO_MAC_MODULE_ENABLED              0
+#define CRYPTO_CIPHER_MODULE_ENABLED           0
+#define CRYPTO_HASH_MODULE_ENABLED             0
+#define CRYPTO_ASYM_SIGN_MODULE_ENABLED        0
+#define CRYPTO_ASYM_ENCRYPT_MODULE_ENABLED     0
+#define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   0
+#define CRYPTO_STATS_MODULE_ENABLED            1
+
+/* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
+#define CRYPTO_IOVEC_BUFFER_SIZE               1024
+
+/* Use SST/PS/ITS or not to save the seed of the entropy source */
+#define CRYPTO_NV_SEED                         1
+
+/* Only enable multi-part operations in Hash, MAC, AEAD and symmetric ciphers */
+#define CRYPTO_SINGLE_PART_FUNCS_DISABLED      0
+
+/* The stack size of the Crypto Secure Partition */
+#define CRYPTO_STACK_SIZE                      0x1B00
+
+#endif /* __CONFIG_TEST_CRYPTO_STATS_H__ */
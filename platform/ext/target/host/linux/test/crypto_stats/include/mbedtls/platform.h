@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef MBEDTLS_PLATFORM_H
+#define MBEDTLS_PLATFORM_H
+
+/* Host replacement of the Mbed TLS platform hooks used by the Crypto
+ * partition.
+ */
+
+#include <stddef.h>
+
+int mbedtls_platform_set_calloc_free(void *(*calloc_func)(size_t, size_t),
+                                     void (*free_func)(void *));
+
+int mbedtls_platform_set_printf(int (*printf_func)(const char *, ...));
+
+#endif /* MBEDTLS_PLATFORM_H */
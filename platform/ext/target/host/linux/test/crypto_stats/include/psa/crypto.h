@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __HOST_TEST_PSA_CRYPTO_H__
+#define __HOST_TEST_PSA_CRYPTO_H__
+
+/*
+ * Host replacement of the Mbed Crypto PSA header. Only the client view of the
+ * PSA Crypto API is available, together with the few Mbed Crypto definitions
+ * the Crypto partition uses outside of the crypto modules.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include_next "psa/crypto.h"
+
+#define MBEDTLS_PSA_CRYPTO_KEY_ID_ENCODES_OWNER
+#define MBEDTLS_PLATFORM_MEMORY
+
+#define MBEDTLS_PRIVATE(member) member
+
+typedef int32_t mbedtls_key_owner_id_t;
+typedef uint64_t psa_drv_slot_number_t;
+
+typedef struct {
+    psa_key_id_t key_id;
+    mbedtls_key_owner_id_t owner;
+} mbedtls_svc_key_id_t;
+
+#define MBEDTLS_SVC_KEY_ID_INIT ((mbedtls_svc_key_id_t){0, 0})
+
+static inline mbedtls_svc_key_id_t mbedtls_svc_key_id_make(
+        mbedtls_key_owner_id_t owner_id, psa_key_id_t key_id)
+{
+    return (mbedtls_svc_key_id_t){ .key_id = key_id, .owner = owner_id };
+}
+
+typedef struct {
+    size_t volatile_slots;
+    size_t persistent_slots;
+    size_t external_slots;
+    size_t half_filled_slots;
+    size_t cache_slots;
+    size_t empty_slots;
+    size_t locked_slots;
+    psa_key_id_t max_open_internal_key_id;
+    psa_key_id_t max_open_external_key_id;
+} mbedtls_psa_stats_t;
+
+void mbedtls_psa_get_stats(mbedtls_psa_stats_t *stats);
+
+#endif /* __HOST_TEST_PSA_CRYPTO_H__ */
@@ -0,0 +1,19 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __PSA_MANIFEST_TFM_CRYPTO_H__
+#define __PSA_MANIFEST_TFM_CRYPTO_H__
+
+/* Crypto partition manifest of the host test, normally generated from
+ * manifests. The test calls the service function directly.
+ */
+
+#include "psa/service.h"
+
+psa_status_t tfm_crypto_sfn(const psa_msg_t *msg);
+
+#endif /* __PSA_MANIFEST_TFM_CRYPTO_H__ */
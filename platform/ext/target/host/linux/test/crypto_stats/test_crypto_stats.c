@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host test of the Crypto resource usage statistics. The Crypto service
+ * function is called with messages built by the test, so that the requests go
+ * through the IOVec scratch and the dispatcher as on target. Mbed Crypto is
+ * replaced by the stubs below.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "tfm_mbedcrypto_include.h"
+#include "mbedtls/platform.h"
+#include "psa/service.h"
+#include "psa_manifest/tfm_crypto.h"
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+#include "tfm_plat_crypto_keys.h"
+#include "tfm_plat_crypto_nv_seed.h"
+
+#define TEST_SECURE_CLIENT_ID       256
+#define TEST_NS_CLIENT_ID           (-1)
+
+/* Size of the extra input vector used to raise the scratch peak */
+#define TEST_SCRATCH_PAD_SIZE       256
+
+#define TEST_SLAB_ALLOC_SIZE        100
+
+/* Sizes of the smallest and largest slab classes */
+#define TEST_SLAB_MIN_SIZE          16
+#define TEST_SLAB_MAX_SIZE          4096
+#define TEST_SLAB_MAX_CLASS         8
+#define TEST_SLAB_MAX_BLOCKS        (CRYPTO_ENGINE_BUF_SIZE / TEST_SLAB_MIN_SIZE)
+
+#define TEST_CHECK(cond)                                                     \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond);         \
+            test_failures++;                                                 \
+        }                                                                    \
+    } while (0)
+
+static uint32_t test_failures;
+
+/* Client vectors of the message being served */
+static const void *test_in_base[PSA_MAX_IOVEC];
+static void *test_out_base[PSA_MAX_IOVEC];
+
+static size_t test_key_slots_in_use;
+
+/* Stubs of the PSA Secure Partition API. */
+size_t psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
+                void *buffer, size_t num_bytes)
+{
+    (void)msg_handle;
+
+    memcpy(buffer, test_in_base[invec_idx], num_bytes);
+    return num_bytes;
+}
+
+void psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
+               const void *buffer, size_t num_bytes)
+{
+    (void)msg_handle;
+
+    memcpy(test_out_base[outvec_idx], buffer, num_bytes);
+}
+
+/* Stubs of Mbed Crypto and of the platform. */
+int mbedtls_platform_set_calloc_free(void *(*calloc_func)(size_t, size_t),
+                                     void (*free_func)(void *))
+{
+    (void)calloc_func;
+    (void)free_func;
+
+    return 0;
+}
+
+int mbedtls_platform_set_printf(int (*printf_func)(const char *, ...))
+{
+    (void)printf_func;
+
+    return 0;
+}
+
+psa_status_t psa_crypto_init(void)
+{
+    return PSA_SUCCESS;
+}
+
+void mbedtls_psa_get_stats(mbedtls_psa_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    stats->volatile_slots = test_key_slots_in_use;
+    stats->empty_slots = 32 - test_key_slots_in_use;
+}
+
+int tfm_plat_crypto_provision_entropy_seed(void)
+{
+    return TFM_CRYPTO_NV_SEED_SUCCESS;
+}
+
+enum tfm_plat_err_t tfm_plat_load_builtin_keys(void)
+{
+    return TFM_PLAT_ERR_SUCCESS;
+}
+
+/* The other function groups are disabled in the test configuration. */
+psa_status_t tfm_crypto_key_management_interface(psa_invec in_vec[],
+                                            psa_outvec out_vec[],
+                                            mbedtls_svc_key_id_t *encoded_key)
+{
+    (void)in_vec;
+    (void)out_vec;
+    (void)encoded_key;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t tfm_crypto_mac_interface(psa_invec in_vec[],
+                                      psa_outvec out_vec[],
+                                      mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_cipher_interface(psa_invec in_vec[],
+                                         psa_outvec out_vec[],
+                                         mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_aead_interface(psa_invec in_vec[],
+                                       psa_outvec out_vec[],
+                                       mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_asymmetric_sign_interface(psa_invec in_vec[],
+                                             psa_outvec out_vec[],
+                                             mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_asymmetric_encrypt_interface(psa_invec in_vec[],
+                                             psa_outvec out_vec[],
+                                             mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_key_derivation_interface(psa_invec in_vec[],
+                                            psa_outvec out_vec[],
+                                            mbedtls_svc_key_id_t *encoded_key)
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, encoded_key);
+}
+
+psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
+                                         psa_outvec out_vec[])
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, NULL);
+}
+
+psa_status_t tfm_crypto_hash_interface(psa_invec in_vec[],
+                                       psa_outvec out_vec[])
+{
+    return tfm_crypto_key_management_interface(in_vec, out_vec, NULL);
+}
+
+/* Send a statistics request to the Crypto service as the given client. The
+ * request carries an extra input vector of pad_size bytes if it is not 0.
+ */
+static psa_status_t test_stats_call(int32_t client_id, uint32_t function_id,
+                                    size_t pad_size,
+                                    struct tfm_crypto_stats *stats)
+{
+    static uint8_t pad[TEST_SCRATCH_PAD_SIZE];
+    struct tfm_crypto_pack_iovec iov = {
+        .function_id = function_id,
+    };
+    psa_msg_t msg;
+
+    memset(&msg, 0, sizeof(msg));
+    memset(test_in_base, 0, sizeof(test_in_base));
+    memset(test_out_base, 0, sizeof(test_out_base));
+
+    msg.type = PSA_IPC_CALL;
+    msg.client_id = client_id;
+
+    test_in_base[0] = &iov;
+    msg.in_size[0] = sizeof(iov);
+    if (pad_size > 0) {
+        test_in_base[1] = pad;
+        msg.in_size[1] = pad_size;
+    }
+    if (stats != NULL) {
+        test_out_base[0] = stats;
+        msg.out_size[0] = sizeof(*stats);
+    }
+
+    return tfm_crypto_sfn(&msg);
+}
+
+static void test_get_and_reset(void)
+{
+    struct tfm_crypto_stats stats;
+    uint32_t handles[3] = {TFM_CRYPTO_INVALID_HANDLE, TFM_CRYPTO_INVALID_HANDLE,
+                           TFM_CRYPTO_INVALID_HANDLE};
+    void *ctx;
+    void *blocks[3];
+    uint32_t idx;
+
+    /* Three operations allocated, then two released */
+    for (idx = 0; idx < 3; idx++) {
+        TEST_CHECK(tfm_crypto_operation_alloc(TFM_CRYPTO_HASH_OPERATION,
+                                              &handles[idx], &ctx) ==
+                   PSA_SUCCESS);
+    }
+    TEST_CHECK(tfm_crypto_operation_release(&handles[1]) == PSA_SUCCESS);
+    TEST_CHECK(tfm_crypto_operation_release(&handles[2]) == PSA_SUCCESS);
+
+    /* Three heap blocks allocated, then two freed */
+    for (idx = 0; idx < 3; idx++) {
+        blocks[idx] = tfm_crypto_slab_calloc(1, TEST_SLAB_ALLOC_SIZE);
+        TEST_CHECK(blocks[idx] != NULL);
+    }
+    tfm_crypto_slab_free(blocks[1]);
+    tfm_crypto_slab_free(blocks[2]);
+
+    test_key_slots_in_use = 2;
+
+    /* A first request raises the scratch peak with an extra input vector */
+    memset(&stats, 0, sizeof(stats));
+    TEST_CHECK(test_stats_call(TEST_SECURE_CLIENT_ID, TFM_CRYPTO_GET_STATS_SID,
+                               TEST_SCRATCH_PAD_SIZE, &stats) == PSA_SUCCESS);
+
+    memset(&stats, 0, sizeof(stats));
+    TEST_CHECK(test_stats_call(TEST_SECURE_CLIENT_ID, TFM_CRYPTO_GET_STATS_SID,
+                               0, &stats) == PSA_SUCCESS);
+
+    TEST_CHECK(stats.oper_num == CRYPTO_CONC_OPER_NUM);
+    TEST_CHECK(stats.oper_in_use == 1);
+    TEST_CHECK(stats.oper_max_in_use == 3);
+
+    TEST_CHECK(stats.engine_buf_size == CRYPTO_ENGINE_BUF_SIZE);
+    TEST_CHECK(stats.engine_buf_used > 0);
+    TEST_CHECK(stats.engine_buf_max_used == 3 * stats.engine_buf_used);
+
+    TEST_CHECK(stats.scratch_size == CRYPTO_IOVEC_BUFFER_SIZE);
+    TEST_CHECK(stats.scratch_max_used ==
+               TEST_SCRATCH_PAD_SIZE + sizeof(struct tfm_crypto_stats));
+
+    TEST_CHECK(stats.key_slot_num == 32);
+    TEST_CHECK(stats.key_slot_in_use == 2);
+
+    /* The peaks drop to the current values. The reset request itself uses
+     * no scratch.
+     */
+    TEST_CHECK(test_stats_call(TEST_SECURE_CLIENT_ID,
+                               TFM_CRYPTO_RESET_STATS_SID,
+                               0, NULL) == PSA_SUCCESS);
+
+    memset(&stats, 0, sizeof(stats));
+    TEST_CHECK(test_stats_call(TEST_SECURE_CLIENT_ID, TFM_CRYPTO_GET_STATS_SID,
+                               0, &stats) == PSA_SUCCESS);
+
+    TEST_CHECK(stats.oper_in_use == 1);
+    TEST_CHECK(stats.oper_max_in_use == 1);
+    TEST_CHECK(stats.engine_buf_max_used == stats.engine_buf_used);
+    TEST_CHECK(stats.scratch_max_used == sizeof(struct tfm_crypto_stats));
+
+    TEST_CHECK(tfm_crypto_operation_release(&handles[0]) == PSA_SUCCESS);
+    tfm_crypto_slab_free(blocks[0]);
+}
+
+static void test_slab_reclaim(void)
+{
+    static void *blocks[TEST_SLAB_MAX_BLOCKS];
+    struct tfm_crypto_slab_stats_t stats;
+    uint32_t num;
+    uint32_t idx;
+    void *large;
+
+    /* Fill the engine buffer with blocks of the smallest class */
+    for (num = 0; num < TEST_SLAB_MAX_BLOCKS; num++) {
+        blocks[num] = tfm_crypto_slab_calloc(1, TEST_SLAB_MIN_SIZE);
+        if (blocks[num] == NULL) {
+            break;
+        }
+    }
+    TEST_CHECK(num > 1 && num < TEST_SLAB_MAX_BLOCKS);
+
+    /* Keep the first block allocated, the ones carved after it are returned
+     * to the buffer for a block of the largest class.
+     */
+    for (idx = 1; idx < num; idx++) {
+        tfm_crypto_slab_free(blocks[idx]);
+    }
+
+    large = tfm_crypto_slab_calloc(1, TEST_SLAB_MAX_SIZE);
+    TEST_CHECK(large != NULL);
+    TEST_CHECK(tfm_crypto_slab_get_stats(0, &stats) == PSA_SUCCESS);
+    TEST_CHECK(stats.block_size == TEST_SLAB_MIN_SIZE);
+    TEST_CHECK(stats.in_use == 1);
+    TEST_CHECK(stats.carved == stats.in_use);
+
+    /* A block freed twice is only released once */
+    tfm_crypto_slab_free(large);
+    tfm_crypto_slab_free(large);
+    TEST_CHECK(tfm_crypto_slab_get_stats(TEST_SLAB_MAX_CLASS,
+                                         &stats) == PSA_SUCCESS);
+    TEST_CHECK(stats.block_size == TEST_SLAB_MAX_SIZE);
+    TEST_CHECK(stats.in_use == 0);
+
+    tfm_crypto_slab_free(blocks[0]);
+}
+
+static void test_ns_not_permitted(void)
+{
+    struct tfm_crypto_stats stats;
+    struct tfm_crypto_stats zero;
+
+    memset(&stats, 0, sizeof(stats));
+    memset(&zero, 0, sizeof(zero));
+
+    TEST_CHECK(test_stats_call(TEST_NS_CLIENT_ID, TFM_CRYPTO_GET_STATS_SID,
+                               0, &stats) == PSA_ERROR_NOT_PERMITTED);
+    TEST_CHECK(memcmp(&stats, &zero, sizeof(stats)) == 0);
+
+    TEST_CHECK(test_stats_call(TEST_NS_CLIENT_ID, TFM_CRYPTO_RESET_STATS_SID,
+                               0, NULL) == PSA_ERROR_NOT_PERMITTED);
+}
+
+int main(void)
+{
+    if (tfm_crypto_init() != PSA_SUCCESS) {
+        printf("FAIL: tfm_crypto_init()\r\n");
+        return 1;
+    }
+
+    test_get_and_reset();
+    test_slab_reclaim();
+    test_ns_not_permitted();
+
+    if (test_failures != 0) {
+        printf("%u check(s) failed\r\n", (unsigned int)test_failures);
+        return 1;
+    }
+
+    printf("Crypto statistics tests passed\r\n");
+    return 0;
+}
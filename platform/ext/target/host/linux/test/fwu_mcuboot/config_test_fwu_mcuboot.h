@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __CONFIG_TEST_FWU_MCUBOOT_H__
+#define __CONFIG_TEST_FWU_MCUBOOT_H__
+
+/* FWU Partition Configs of the MCUboot shim layer host test */
+
+/* Size of the FWU internal data transfer buffer */
+#define TFM_FWU_BUF_SIZE                       PSA_FWU_MAX_WRITE_SIZE
+
+/* The stack size of the Firmware Update Secure Partition */
+#define FWU_STACK_SIZE                         0x600
+
+/* The image is not installed by the test, so there is nothing to hash */
+#define FWU_STREAMING_HASH                     0
+
+/* Size of the buffer combining the writes to the staging area, 0 to disable */
+#define FWU_WRITE_BUF_SIZE                     0x40
+
+/* Accept delta images, reconstructed from the active image */
+#define FWU_DELTA_IMAGE                        1
+
+/* Sectors of the staging area erased ahead of the writes, 0 to erase it at start */
+#define FWU_ERASE_AHEAD_SECTORS                1
+
+#endif /* __CONFIG_TEST_FWU_MCUBOOT_H__ */
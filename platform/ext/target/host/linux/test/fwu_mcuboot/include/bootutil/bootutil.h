@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOTUTIL_BOOTUTIL_H__
+#define __BOOTUTIL_BOOTUTIL_H__
+
+/* Host replacement of the MCUboot v1.9.0 bootutil/bootutil.h */
+
+int boot_set_pending_multi(int image_index, int permanent);
+int boot_set_confirmed_multi(int image_index);
+
+#endif /* __BOOTUTIL_BOOTUTIL_H__ */
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOTUTIL_IMAGE_H__
+#define __BOOTUTIL_IMAGE_H__
+
+/* Host replacement of the MCUboot v1.9.0 bootutil/image.h */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define IMAGE_MAGIC                 0x96f3b83d
+
+#define IMAGE_TLV_SHA256            0x10
+#define IMAGE_TLV_DEPENDENCY        0x40
+
+struct image_version {
+    uint8_t iv_major;
+    uint8_t iv_minor;
+    uint16_t iv_revision;
+    uint32_t iv_build_num;
+};
+
+struct image_dependency {
+    uint8_t image_id;
+    uint8_t _pad1;
+    uint16_t _pad2;
+    struct image_version image_min_version;
+};
+
+struct image_header {
+    uint32_t ih_magic;
+    uint32_t ih_load_addr;
+    uint16_t ih_hdr_size;
+    uint16_t ih_protect_tlv_size;
+    uint32_t ih_img_size;
+    uint32_t ih_flags;
+    struct image_version ih_ver;
+    uint32_t _pad1;
+};
+
+struct flash_area;
+
+struct image_tlv_iter {
+    const struct image_header *hdr;
+    const struct flash_area *fap;
+    uint16_t type;
+    bool prot;
+    uint32_t prot_end;
+    uint32_t tlv_off;
+    uint32_t tlv_end;
+};
+
+int bootutil_tlv_iter_begin(struct image_tlv_iter *it,
+                            const struct image_header *hdr,
+                            const struct flash_area *fap, uint16_t type,
+                            bool prot);
+int bootutil_tlv_iter_next(struct image_tlv_iter *it, uint32_t *off,
+                           uint16_t *len, uint16_t *type);
+
+#endif /* __BOOTUTIL_IMAGE_H__ */
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOTUTIL_PRIV_H__
+#define __BOOTUTIL_PRIV_H__
+
+/* Host replacement of the definitions of the MCUboot v1.9.0 bootutil_priv.h
+ * used by the FWU partition.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "bootutil/bootutil.h"
+#include "bootutil/image.h"
+
+#define BOOT_TMPBUF_SZ              256
+
+#define BOOT_MAX_IMG_SECTORS        128
+#define BOOT_STATUS_STATE_COUNT     3
+#define BOOT_STATUS_MAX_ENTRIES     BOOT_MAX_IMG_SECTORS
+
+#ifdef MCUBOOT_ENC_IMAGES
+#define BOOT_ENC_KEY_SIZE           16
+#endif
+
+#define BOOT_MAX_ALIGN              8
+#define BOOT_MAGIC_SZ               16
+#define BOOT_MAGIC_ALIGN_SIZE       16
+
+#define BOOT_FLAG_SET               1
+#define BOOT_FLAG_UNSET             3
+
+#define ALIGN_UP(num, align)        (((num) + ((align) - 1)) & ~((align) - 1))
+#define ALIGN_DOWN(num, align)      ((num) & ~((align) - 1))
+
+struct flash_area;
+
+int boot_read_image_ok(const struct flash_area *fap, uint8_t *image_ok);
+
+#endif /* __BOOTUTIL_PRIV_H__ */
@@ -0,0 +1,20 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Flash layout of the FWU host test, on a RAM flash */
+
+#define FLASH_AREA_0_ID                 (1)
+#define FLASH_AREA_2_ID                 (3)
+
+#define TEST_SLOT_SIZE                  (0x8000)
+
+#define TFM_HAL_FLASH_PROGRAM_UNIT      (4)
+
+#endif /* __FLASH_LAYOUT_H__ */
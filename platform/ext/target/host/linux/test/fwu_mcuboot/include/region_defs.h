@@ -0,0 +1,17 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __REGION_DEFS_H__
+#define __REGION_DEFS_H__
+
+#include "flash_layout.h"
+
+/* Shared data between the bootloader and the runtime, unused by the test */
+#define BOOT_TFM_SHARED_DATA_BASE       0x0
+#define BOOT_TFM_SHARED_DATA_SIZE       0x400
+
+#endif /* __REGION_DEFS_H__ */
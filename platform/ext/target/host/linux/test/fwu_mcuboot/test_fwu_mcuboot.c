@@ -0,0 +1,606 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host test of the MCUboot shim layer of the FWU partition. The image slots
+ * are held in RAM, with the program and erase rules of a NOR flash, and are
+ * reported as memory-mapped. The sectors of the slots have different sizes.
+ * The delta images are created by fwu_delta.py, whose path is given on the
+ * command line, and applied by the partition. Built with MCUBOOT_ENC_IMAGES,
+ * the test checks that delta images are rejected.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "psa/crypto.h"
+#include "bootutil/bootutil.h"
+#include "config_fwu.h"
+#include "flash_map_backend/flash_map_backend.h"
+#include "sysflash/sysflash.h"
+#include "tfm_boot_status.h"
+#include "tfm_bootloader_fwu_abstraction.h"
+
+/* Offset of the first sector holding the image trailer */
+#define TEST_TRAILER_OFF            0x7800
+
+#define TEST_ACTIVE_IMAGE_SIZE      20000
+
+#define TEST_MAX_BLOCK_SIZE         300
+
+#define TEST_ACTIVE_IMAGE_FILE      "fwu_test_active.bin"
+#define TEST_NEW_IMAGE_FILE         "fwu_test_new.bin"
+#define TEST_DELTA_IMAGE_FILE       "fwu_test_delta.bin"
+
+#define TEST_CHECK(cond)                                                     \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond);         \
+            test_failures++;                                                 \
+        }                                                                    \
+    } while (0)
+
+static uint32_t test_failures;
+
+/* The primary and the secondary slots of the image. */
+static uint8_t test_flash[2][TEST_SLOT_SIZE];
+
+/* The slots are made of sectors of different sizes, smaller at the end. */
+static const struct flash_sector test_sectors[] = {
+    {0x0000, 0x1000}, {0x1000, 0x1000}, {0x2000, 0x1000}, {0x3000, 0x1000},
+    {0x4000, 0x800}, {0x4800, 0x800}, {0x5000, 0x800}, {0x5800, 0x800},
+    {0x6000, 0x400}, {0x6400, 0x400}, {0x6800, 0x400}, {0x6C00, 0x400},
+    {0x7000, 0x400}, {0x7400, 0x400}, {0x7800, 0x400}, {0x7C00, 0x400},
+};
+
+#define TEST_SECTOR_COUNT   (sizeof(test_sectors) / sizeof(test_sectors[0]))
+
+/* The driver is not used, the sectors are given by the flash map. */
+static ARM_DRIVER_FLASH test_flash_driver;
+
+static const struct flash_area test_areas[2] = {
+    {
+        .fa_id = FLASH_AREA_0_ID,
+        .fa_driver = &test_flash_driver,
+        .fa_off = 0,
+        .fa_size = TEST_SLOT_SIZE,
+    },
+    {
+        .fa_id = FLASH_AREA_2_ID,
+        .fa_driver = &test_flash_driver,
+        .fa_off = TEST_SLOT_SIZE,
+        .fa_size = TEST_SLOT_SIZE,
+    },
+};
+
+/* Programs of data read from the mapped flash. */
+static uint32_t test_mapped_programs;
+
+static uint8_t test_new_image[TEST_SLOT_SIZE];
+static size_t test_new_image_size;
+static uint8_t test_delta[2 * TEST_SLOT_SIZE];
+static size_t test_delta_size;
+
+static uint32_t test_rand_state = 1;
+
+static uint32_t test_rand(void)
+{
+    test_rand_state = test_rand_state * 1103515245U + 12345U;
+    return test_rand_state >> 16;
+}
+
+static uint8_t *test_slot(const struct flash_area *area)
+{
+    return test_flash[area == &test_areas[0] ? 0 : 1];
+}
+
+static uint32_t test_sector_index(uint32_t off)
+{
+    uint32_t i;
+
+    for (i = 0; i < TEST_SECTOR_COUNT - 1; i++) {
+        if (off < test_sectors[i].fs_off + test_sectors[i].fs_size) {
+            break;
+        }
+    }
+    return i;
+}
+
+static bool test_is_sector_boundary(uint32_t off)
+{
+    return (off == TEST_SLOT_SIZE) ||
+           (test_sectors[test_sector_index(off)].fs_off == off);
+}
+
+/* Stubs of the flash map, on the RAM flash. */
+int flash_area_open(uint8_t id, const struct flash_area **area)
+{
+    if (id == FLASH_AREA_0_ID) {
+        *area = &test_areas[0];
+    } else if (id == FLASH_AREA_2_ID) {
+        *area = &test_areas[1];
+    } else {
+        return -1;
+    }
+    return 0;
+}
+
+void flash_area_close(const struct flash_area *area)
+{
+    (void)area;
+}
+
+int flash_area_read(const struct flash_area *area, uint32_t off, void *dst,
+                    uint32_t len)
+{
+    if ((off > area->fa_size) || (len > area->fa_size - off)) {
+        return -1;
+    }
+    memcpy(dst, test_slot(area) + off, len);
+    return 0;
+}
+
+int flash_area_write(const struct flash_area *area, uint32_t off,
+                     const void *src, uint32_t len)
+{
+    const uint8_t *data = src;
+    uint8_t *slot = test_slot(area);
+    uint32_t i;
+
+    if ((off > area->fa_size) || (len > area->fa_size - off)) {
+        return -1;
+    }
+    /* The flash can not be read while it is programmed. */
+    if ((data + len > test_flash[0]) &&
+        (data < test_flash[0] + sizeof(test_flash))) {
+        test_mapped_programs++;
+    }
+    /* Bits can only be programmed from 1 to 0 on an erased flash. */
+    for (i = 0; i < len; i++) {
+        if (slot[off + i] != 0xFF) {
+            printf("FAIL program of non-erased flash at 0x%x\r\n", off + i);
+            test_failures++;
+            return -1;
+        }
+    }
+    memcpy(slot + off, data, len);
+    return 0;
+}
+
+int flash_area_erase(const struct flash_area *area, uint32_t off, uint32_t len)
+{
+    if ((off > area->fa_size) || (len > area->fa_size - off) ||
+        !test_is_sector_boundary(off) || !test_is_sector_boundary(off + len)) {
+        printf("FAIL erase of 0x%x bytes at 0x%x\r\n", len, off);
+        test_failures++;
+        return -1;
+    }
+    memset(test_slot(area) + off, 0xFF, len);
+    return 0;
+}
+
+uint32_t flash_area_align(const struct flash_area *area)
+{
+    (void)area;
+
+    return TFM_HAL_FLASH_PROGRAM_UNIT;
+}
+
+uint8_t flash_area_erased_val(const struct flash_area *area)
+{
+    (void)area;
+
+    return 0xFF;
+}
+
+int flash_area_get_sectors(int fa_id, uint32_t *count,
+                           struct flash_sector *sectors)
+{
+    if (((fa_id != FLASH_AREA_0_ID) && (fa_id != FLASH_AREA_2_ID)) ||
+        (*count < TEST_SECTOR_COUNT)) {
+        return -1;
+    }
+    memcpy(sectors, test_sectors, sizeof(test_sectors));
+    *count = TEST_SECTOR_COUNT;
+    return 0;
+}
+
+int flash_area_driver_init(void)
+{
+    return 0;
+}
+
+int flash_area_get_mapped_ptr(const struct flash_area *area, uint32_t off,
+                              uint32_t len, const void **ptr)
+{
+    if ((off > area->fa_size) || (len > area->fa_size - off)) {
+        return -1;
+    }
+    *ptr = test_slot(area) + off;
+    return 0;
+}
+
+/* Stubs of bootutil, of the boot data and of the Crypto service, which the
+ * test does not reach.
+ */
+int boot_read_image_ok(const struct flash_area *fap, uint8_t *image_ok)
+{
+    (void)fap;
+    (void)image_ok;
+
+    return -1;
+}
+
+int boot_set_pending_multi(int image_index, int permanent)
+{
+    (void)image_index;
+    (void)permanent;
+
+    return -1;
+}
+
+int boot_set_confirmed_multi(int image_index)
+{
+    (void)image_index;
+
+    return -1;
+}
+
+int32_t tfm_core_get_boot_data(uint8_t major_type,
+                               struct tfm_boot_data *boot_data,
+                               uint32_t len)
+{
+    (void)major_type;
+    (void)boot_data;
+    (void)len;
+
+    return -1;
+}
+
+psa_status_t psa_hash_setup(psa_hash_operation_t *operation,
+                            psa_algorithm_t alg)
+{
+    (void)operation;
+    (void)alg;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_update(psa_hash_operation_t *operation,
+                             const uint8_t *input,
+                             size_t input_length)
+{
+    (void)operation;
+    (void)input;
+    (void)input_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_finish(psa_hash_operation_t *operation,
+                             uint8_t *hash,
+                             size_t hash_size,
+                             size_t *hash_length)
+{
+    (void)operation;
+    (void)hash;
+    (void)hash_size;
+    (void)hash_length;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+}
+
+psa_status_t psa_hash_abort(psa_hash_operation_t *operation)
+{
+    (void)operation;
+
+    return PSA_SUCCESS;
+}
+
+static int test_write_file(const char *name, const uint8_t *data, size_t size)
+{
+    FILE *file = fopen(name, "wb");
+    size_t written;
+
+    if (file == NULL) {
+        return -1;
+    }
+    written = fwrite(data, 1, size, file);
+    fclose(file);
+    return written == size ? 0 : -1;
+}
+
+/* Make the active image and a new image which shares most of its data, and
+ * create the delta image between them with fwu_delta.py.
+ */
+static int test_create_delta(const char *python, const char *fwu_delta)
+{
+    uint8_t *active = test_flash[0];
+    char command[1024];
+    size_t i, n = 0;
+    FILE *file;
+
+    for (i = 0; i < TEST_ACTIVE_IMAGE_SIZE; i++) {
+        active[i] = (uint8_t)test_rand();
+    }
+    memset(active + TEST_ACTIVE_IMAGE_SIZE, 0xFF,
+           TEST_SLOT_SIZE - TEST_ACTIVE_IMAGE_SIZE);
+
+    /* Unchanged start, with a few patched bytes. */
+    memcpy(test_new_image, active, 5000);
+    test_new_image[100] ^= 0x5A;
+    test_new_image[2000] ^= 0xA5;
+    n = 5000;
+    /* New data. */
+    for (i = 0; i < 700; i++) {
+        test_new_image[n++] = (uint8_t)test_rand();
+    }
+    /* Data moved from further in the active image, and some removed. */
+    memcpy(test_new_image + n, active + 12000, 6000);
+    n += 6000;
+    memcpy(test_new_image + n, active + 5000, 6000);
+    n += 6000;
+    /* Data copied twice. */
+    memcpy(test_new_image + n, active + 18000, 2000);
+    n += 2000;
+    memcpy(test_new_image + n, active + 18000, 2000);
+    n += 2000;
+    /* New data at the end. */
+    for (i = 0; i < 333; i++) {
+        test_new_image[n++] = (uint8_t)test_rand();
+    }
+    test_new_image_size = n;
+
+    if ((test_write_file(TEST_ACTIVE_IMAGE_FILE, active,
+                         TEST_ACTIVE_IMAGE_SIZE) != 0) ||
+        (test_write_file(TEST_NEW_IMAGE_FILE, test_new_image,
+                         test_new_image_size) != 0)) {
+        printf("FAIL writing the images\r\n");
+        return -1;
+    }
+
+    snprintf(command, sizeof(command), "\"%s\" \"%s\" -a %s -n %s -o %s",
+             python, fwu_delta, TEST_ACTIVE_IMAGE_FILE, TEST_NEW_IMAGE_FILE,
+             TEST_DELTA_IMAGE_FILE);
+    if (system(command) != 0) {
+        printf("FAIL running %s\r\n", command);
+        return -1;
+    }
+
+    file = fopen(TEST_DELTA_IMAGE_FILE, "rb");
+    if (file == NULL) {
+        printf("FAIL reading the delta image\r\n");
+        return -1;
+    }
+    test_delta_size = fread(test_delta, 1, sizeof(test_delta), file);
+    fclose(file);
+
+    return 0;
+}
+
+/* Write the delta image in blocks of random sizes. */
+static psa_status_t test_load_delta(const uint8_t *delta, size_t size)
+{
+    psa_status_t status;
+    size_t off = 0, len;
+
+    while (off < size) {
+        len = 1 + test_rand() % TEST_MAX_BLOCK_SIZE;
+        if ((off == 0) && (len < 8)) {
+            len = 8;
+        }
+        if (len > size - off) {
+            len = size - off;
+        }
+        status = fwu_bootloader_load_image(0, off, delta + off, len);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        off += len;
+    }
+
+    return PSA_SUCCESS;
+}
+
+static void test_staging_area_init(void)
+{
+    /* The staging area holds a previous image. */
+    memset(test_flash[1], 0x5A, TEST_SLOT_SIZE);
+
+    TEST_CHECK(fwu_bootloader_staging_area_init(0, NULL, 0) == PSA_SUCCESS);
+}
+
+static bool test_is_filled(const uint8_t *buf, uint8_t val, size_t len)
+{
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        if (buf[i] != val) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Get the end of the sectors erased ahead of the data written up to end. */
+static uint32_t test_erase_ahead_end(uint32_t end)
+{
+    uint32_t next = test_sector_index(end - 1) + 1 + FWU_ERASE_AHEAD_SECTORS;
+
+    if ((next >= TEST_SECTOR_COUNT) ||
+        (test_sectors[next].fs_off > TEST_TRAILER_OFF)) {
+        return TEST_TRAILER_OFF;
+    }
+    return test_sectors[next].fs_off;
+}
+
+/* Only the sectors holding the image trailer, which are found from the trailer
+ * size, are erased at start.
+ */
+static void test_erase_trailer(void)
+{
+    test_staging_area_init();
+
+    TEST_CHECK(test_is_filled(test_flash[1], 0x5A, TEST_TRAILER_OFF));
+    TEST_CHECK(test_is_filled(test_flash[1] + TEST_TRAILER_OFF, 0xFF,
+                              TEST_SLOT_SIZE - TEST_TRAILER_OFF));
+}
+
+/* The sectors are erased as the image is written, FWU_ERASE_AHEAD_SECTORS
+ * ahead of the data, and the sectors after the image are left as they are.
+ */
+static void test_erase_ahead(uint32_t image_size)
+{
+    static uint8_t image[TEST_SLOT_SIZE];
+    uint32_t off = 0, len, erase_end;
+
+    for (off = 0; off < image_size; off++) {
+        image[off] = (uint8_t)test_rand();
+    }
+    /* Not a delta image. */
+    image[0] = 0;
+
+    test_staging_area_init();
+
+    off = 0;
+    while (off < image_size) {
+        len = 1 + test_rand() % TEST_MAX_BLOCK_SIZE;
+        if (len > image_size - off) {
+            len = image_size - off;
+        }
+        TEST_CHECK(fwu_bootloader_load_image(0, off, image + off,
+                                             len) == PSA_SUCCESS);
+        off += len;
+
+        erase_end = test_erase_ahead_end(off);
+        if (off < erase_end) {
+            TEST_CHECK(test_is_filled(test_flash[1] + off, 0xFF,
+                                      erase_end - off));
+        }
+        if (erase_end < TEST_TRAILER_OFF) {
+            TEST_CHECK(test_flash[1][erase_end] == 0x5A);
+        }
+    }
+
+    TEST_CHECK(fwu_bootloader_finish_image(0) == PSA_SUCCESS);
+
+    TEST_CHECK(memcmp(test_flash[1], image, image_size) == 0);
+    erase_end = test_erase_ahead_end(image_size);
+    TEST_CHECK(test_is_filled(test_flash[1] + erase_end, 0x5A,
+                              TEST_TRAILER_OFF - erase_end));
+}
+
+#ifdef MCUBOOT_ENC_IMAGES
+/* The active image is stored decrypted, so it can not be the base of a delta
+ * image.
+ */
+static void test_delta_not_supported(void)
+{
+    test_staging_area_init();
+
+    TEST_CHECK(test_load_delta(test_delta, test_delta_size) ==
+               PSA_ERROR_NOT_SUPPORTED);
+}
+#else
+/* The image rebuilt from the delta image is the new image. */
+static void test_delta_round_trip(void)
+{
+    static uint8_t active[TEST_SLOT_SIZE];
+    int round;
+
+    memcpy(active, test_flash[0], TEST_SLOT_SIZE);
+
+    for (round = 0; round < 8; round++) {
+        test_staging_area_init();
+        test_mapped_programs = 0;
+
+        TEST_CHECK(test_load_delta(test_delta,
+                                   test_delta_size) == PSA_SUCCESS);
+        TEST_CHECK(fwu_bootloader_finish_image(0) == PSA_SUCCESS);
+
+        TEST_CHECK(memcmp(test_flash[1], test_new_image,
+                          test_new_image_size) == 0);
+        TEST_CHECK(memcmp(test_flash[0], active, TEST_SLOT_SIZE) == 0);
+        /* The copies from the mapped active image go through RAM. */
+        TEST_CHECK(test_mapped_programs == 0);
+    }
+}
+
+/* The header of the delta image must be written in one block. */
+static void test_delta_split_header(void)
+{
+    test_staging_area_init();
+
+    TEST_CHECK(fwu_bootloader_load_image(0, 0, test_delta, 4) ==
+               PSA_ERROR_INVALID_ARGUMENT);
+}
+
+/* A delta image which does not describe the whole image is rejected. */
+static void test_delta_truncated(void)
+{
+    test_staging_area_init();
+
+    TEST_CHECK(test_load_delta(test_delta,
+                               test_delta_size - 3) == PSA_SUCCESS);
+    TEST_CHECK(fwu_bootloader_finish_image(0) == PSA_ERROR_INVALID_ARGUMENT);
+}
+
+/* A copy from outside of the active slot is rejected. */
+static void test_delta_copy_out_of_slot(void)
+{
+    static const uint8_t delta[] = {
+        0x46, 0x44, 0x4C, 0x54,         /* magic */
+        0x00, 0x01, 0x00, 0x00,         /* image_size */
+        0x01,                           /* COPY */
+        0x80, 0x7F, 0x00, 0x00,         /* src_off */
+        0x00, 0x01, 0x00, 0x00,         /* len */
+    };
+
+    test_staging_area_init();
+
+    TEST_CHECK(fwu_bootloader_load_image(0, 0, delta, sizeof(delta)) ==
+               PSA_ERROR_INVALID_ARGUMENT);
+}
+#endif /* MCUBOOT_ENC_IMAGES */
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3) {
+        printf("Usage: %s <python> <fwu_delta.py>\r\n", argv[0]);
+        return 1;
+    }
+
+    if (test_create_delta(argv[1], argv[2]) != 0) {
+        return 1;
+    }
+    TEST_CHECK(test_delta_size < test_new_image_size / 4);
+
+    test_erase_trailer();
+    test_erase_ahead(0x4A31);
+    /* The image goes into the sectors holding the trailer. */
+    test_erase_ahead(TEST_TRAILER_OFF + 0x123);
+
+#ifdef MCUBOOT_ENC_IMAGES
+    test_delta_not_supported();
+#else
+    test_delta_round_trip();
+    test_delta_split_header();
+    test_delta_truncated();
+    test_delta_copy_out_of_slot();
+#endif
+
+    if (test_failures != 0) {
+        printf("%u check(s) failed\r\n", test_failures);
+        return 1;
+    }
+
+    printf("PASS\r\n");
+    return 0;
+}
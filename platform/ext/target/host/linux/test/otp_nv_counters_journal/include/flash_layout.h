@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __FLASH_LAYOUT_H__
+#define __FLASH_LAYOUT_H__
+
+/* Flash layout of the OTP / NV counter journal host test, on a RAM flash */
+
+#define TEST_FLASH_SECTOR_SIZE                  0x200
+#define TEST_FLASH_SIZE                         (5 * TEST_FLASH_SECTOR_SIZE)
+
+#define OTP_NV_COUNTERS_FLASH_DEV               Driver_TEST_FLASH
+#define TFM_HAL_ITS_PROGRAM_UNIT                4
+
+/* The area spans two sectors, NV counters are in both */
+#define TFM_OTP_NV_COUNTERS_AREA_ADDR           0x0
+#define TFM_OTP_NV_COUNTERS_AREA_SIZE           (2 * TEST_FLASH_SECTOR_SIZE)
+#define TFM_OTP_NV_COUNTERS_SECTOR_SIZE         TEST_FLASH_SECTOR_SIZE
+#define TFM_OTP_NV_COUNTERS_BACKUP_AREA_ADDR    (TFM_OTP_NV_COUNTERS_AREA_ADDR + \
+                                                 TFM_OTP_NV_COUNTERS_AREA_SIZE)
+
+#define TFM_OTP_NV_COUNTERS_JOURNAL_AREA_ADDR   (TFM_OTP_NV_COUNTERS_BACKUP_AREA_ADDR + \
+                                                 TFM_OTP_NV_COUNTERS_AREA_SIZE)
+#define TFM_OTP_NV_COUNTERS_JOURNAL_AREA_SIZE   TEST_FLASH_SECTOR_SIZE
+
+#endif /* __FLASH_LAYOUT_H__ */
@@ -0,0 +1,330 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+/*
+ * Host test of the journal of the flash OTP / NV counter backend. The backend
+ * runs on a RAM flash with NOR semantics, which can be made to fail a program
+ * part way, or to lose power in the middle of one. A reboot is simulated by
+ * initializing the backend again on the same flash content.
+ */
+
+#include <setjmp.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "Driver_Flash.h"
+#include "flash_layout.h"
+#include "flash_otp_nv_counters_backend.h"
+#include "tfm_plat_defs.h"
+
+#define TEST_CHECK(cond)                                                     \
+    do {                                                                     \
+        if (!(cond)) {                                                       \
+            printf("FAIL %s:%d: %s\r\n", __FILE__, __LINE__, #cond);         \
+            test_failures++;                                                 \
+        }                                                                    \
+    } while (0)
+
+#define TEST_REGION_OFFSET(field) \
+    offsetof(struct flash_otp_nv_counters_region_t, field)
+
+/* Journalled words in each sector of the area, and an OTP value */
+#define TEST_BL2_COUNTER_OFFSET     TEST_REGION_OFFSET(bl2_nv_counter_0)
+#define TEST_BL2_COUNTER_3_OFFSET   (TEST_REGION_OFFSET(bl2_nv_counter_3) + \
+                                     60)
+#define TEST_FLASH_COUNTER_OFFSET   TEST_REGION_OFFSET(flash_nv_counters)
+#define TEST_HUK_OFFSET             TEST_REGION_OFFSET(huk)
+
+enum test_fault_t {
+    TEST_FAULT_NONE = 0,
+    /* The program stops half way and returns an error */
+    TEST_FAULT_FAIL,
+    /* Power is lost with the same bits of the value and check words of a
+     * journal record left unprogrammed
+     */
+    TEST_FAULT_TEAR,
+};
+
+static uint32_t test_failures;
+
+static uint8_t test_flash[TEST_FLASH_SIZE];
+static uint32_t test_erase_count;
+static enum test_fault_t test_fault;
+static jmp_buf test_power_loss;
+
+static ARM_FLASH_CAPABILITIES test_flash_get_capabilities(void)
+{
+    ARM_FLASH_CAPABILITIES caps = {0};
+
+    /* 8-bit data width */
+    caps.data_width = 0;
+
+    return caps;
+}
+
+static int32_t test_flash_initialize(ARM_Flash_SignalEvent_t cb_event)
+{
+    (void)cb_event;
+
+    return ARM_DRIVER_OK;
+}
+
+static int32_t test_flash_read(uint32_t addr, void *data, uint32_t cnt)
+{
+    if ((addr > sizeof(test_flash)) || (cnt > sizeof(test_flash) - addr)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    memcpy(data, &test_flash[addr], cnt);
+
+    return (int32_t)cnt;
+}
+
+static int32_t test_flash_program(uint32_t addr, const void *data, uint32_t cnt)
+{
+    uint8_t buf[16];
+    uint32_t value, check, mask;
+    uint32_t i;
+
+    if ((addr > sizeof(test_flash)) || (cnt > sizeof(test_flash) - addr)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    switch (test_fault) {
+    case TEST_FAULT_FAIL:
+        test_fault = TEST_FAULT_NONE;
+        for (i = 0; i < cnt / 2; i++) {
+            test_flash[addr + i] &= ((const uint8_t *)data)[i];
+        }
+        return ARM_DRIVER_ERROR;
+    case TEST_FAULT_TEAR:
+        test_fault = TEST_FAULT_NONE;
+        if (cnt > sizeof(buf)) {
+            return ARM_DRIVER_ERROR_PARAMETER;
+        }
+        memcpy(buf, data, cnt);
+        memcpy(&value, &buf[4], sizeof(value));
+        memcpy(&check, &buf[8], sizeof(check));
+        /* Lowest bit which is 0 in both words is left 1 in both */
+        mask = ~value & ~check;
+        mask &= 0U - mask;
+        value |= mask;
+        check |= mask;
+        memcpy(&buf[4], &value, sizeof(value));
+        memcpy(&buf[8], &check, sizeof(check));
+        for (i = 0; i < cnt; i++) {
+            test_flash[addr + i] &= buf[i];
+        }
+        longjmp(test_power_loss, 1);
+    default:
+        break;
+    }
+
+    for (i = 0; i < cnt; i++) {
+        test_flash[addr + i] &= ((const uint8_t *)data)[i];
+    }
+
+    return (int32_t)cnt;
+}
+
+static int32_t test_flash_erase_sector(uint32_t addr)
+{
+    addr -= addr % TEST_FLASH_SECTOR_SIZE;
+    if (addr >= sizeof(test_flash)) {
+        return ARM_DRIVER_ERROR_PARAMETER;
+    }
+
+    memset(&test_flash[addr], 0xFF, TEST_FLASH_SECTOR_SIZE);
+    test_erase_count++;
+
+    return ARM_DRIVER_OK;
+}
+
+ARM_DRIVER_FLASH Driver_TEST_FLASH = {
+    .GetCapabilities = test_flash_get_capabilities,
+    .Initialize = test_flash_initialize,
+    .ReadData = test_flash_read,
+    .ProgramData = test_flash_program,
+    .EraseSector = test_flash_erase_sector,
+};
+
+static uint32_t test_read_word(uint32_t offset)
+{
+    uint32_t value = 0;
+
+    TEST_CHECK(read_otp_nv_counters_flash(offset, &value, sizeof(value)) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    return value;
+}
+
+static enum tfm_plat_err_t test_write_word(uint32_t offset, uint32_t value)
+{
+    return write_otp_nv_counters_flash(offset, &value, sizeof(value));
+}
+
+static void test_reboot(void)
+{
+    test_fault = TEST_FAULT_NONE;
+    TEST_CHECK(init_otp_nv_counters_flash() == TFM_PLAT_ERR_SUCCESS);
+}
+
+static void test_format(void)
+{
+    memset(test_flash, 0xFF, sizeof(test_flash));
+    test_reboot();
+}
+
+/* Single word updates are appended to the journal without any erase */
+static void test_journal_append(void)
+{
+    uint32_t erase_count;
+    uint32_t value;
+
+    test_format();
+
+    erase_count = test_erase_count;
+    for (value = 1; value <= 5; value++) {
+        TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, value) ==
+                   TFM_PLAT_ERR_SUCCESS);
+        TEST_CHECK(test_write_word(TEST_BL2_COUNTER_OFFSET, value) ==
+                   TFM_PLAT_ERR_SUCCESS);
+    }
+    TEST_CHECK(test_erase_count == erase_count);
+
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 5);
+    TEST_CHECK(test_read_word(TEST_BL2_COUNTER_OFFSET) == 5);
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 5);
+    TEST_CHECK(test_read_word(TEST_BL2_COUNTER_OFFSET) == 5);
+}
+
+/* A full journal is compacted into the area */
+static void test_journal_full(void)
+{
+    uint32_t value;
+
+    test_format();
+
+    for (value = 1; value <= 200; value++) {
+        TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, value) ==
+                   TFM_PLAT_ERR_SUCCESS);
+    }
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 200);
+}
+
+/* Writes out of the NV counters rewrite the area, with the journalled words
+ * of every sector.
+ */
+static void test_otp_write(void)
+{
+    uint8_t huk[32];
+    uint8_t read_huk[32];
+
+    test_format();
+
+    TEST_CHECK(test_write_word(TEST_BL2_COUNTER_OFFSET, 7) ==
+               TFM_PLAT_ERR_SUCCESS);
+    TEST_CHECK(test_write_word(TEST_BL2_COUNTER_3_OFFSET, 8) ==
+               TFM_PLAT_ERR_SUCCESS);
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 9) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    memset(huk, 0xA5, sizeof(huk));
+    TEST_CHECK(write_otp_nv_counters_flash(TEST_HUK_OFFSET, huk, sizeof(huk)) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    test_reboot();
+    TEST_CHECK(read_otp_nv_counters_flash(TEST_HUK_OFFSET, read_huk,
+                                          sizeof(read_huk)) ==
+               TFM_PLAT_ERR_SUCCESS);
+    TEST_CHECK(memcmp(huk, read_huk, sizeof(huk)) == 0);
+    TEST_CHECK(test_read_word(TEST_BL2_COUNTER_OFFSET) == 7);
+    TEST_CHECK(test_read_word(TEST_BL2_COUNTER_3_OFFSET) == 8);
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 9);
+}
+
+/* An update whose header program fails is still kept after a reboot */
+static void test_header_program_fails(void)
+{
+    test_format();
+
+    test_fault = TEST_FAULT_FAIL;
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 1) ==
+               TFM_PLAT_ERR_SUCCESS);
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 2) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 2);
+}
+
+/* An update whose record program fails is still kept after a reboot */
+static void test_record_program_fails(void)
+{
+    test_format();
+
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 1) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    test_fault = TEST_FAULT_FAIL;
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 2) ==
+               TFM_PLAT_ERR_SUCCESS);
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 3) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 3);
+}
+
+/* A record torn by a power loss is dropped, not replayed with a wrong value */
+static void test_torn_record(void)
+{
+    test_format();
+
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 6) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    if (setjmp(test_power_loss) == 0) {
+        test_fault = TEST_FAULT_TEAR;
+        (void)test_write_word(TEST_FLASH_COUNTER_OFFSET, 7);
+        TEST_CHECK(0);
+    }
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 6);
+
+    /* The journal is still appended after the torn record */
+    TEST_CHECK(test_write_word(TEST_FLASH_COUNTER_OFFSET, 7) ==
+               TFM_PLAT_ERR_SUCCESS);
+
+    test_reboot();
+    TEST_CHECK(test_read_word(TEST_FLASH_COUNTER_OFFSET) == 7);
+}
+
+int main(void)
+{
+    test_journal_append();
+    test_journal_full();
+    test_otp_write();
+    test_header_program_fails();
+    test_record_program_fails();
+    test_torn_record();
+
+    if (test_failures != 0) {
+        printf("%u check(s) failed\r\n", (unsigned int)test_failures);
+        return 1;
+    }
+
+    printf("OTP / NV counter journal tests passed\r\n");
+    return 0;
+}
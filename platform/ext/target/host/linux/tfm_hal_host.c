@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cmsis.h"
+#include "fih.h"
+#include "tfm_hal_defs.h"
+#include "tfm_hal_interrupt.h"
+#include "tfm_hal_isolation.h"
+#include "tfm_hal_platform.h"
+#include "tfm_hal_spm_logdev.h"
+
+/*
+ * HAL of the host simulation. There is no isolation hardware, all partitions
+ * share one boundary and every memory access is granted.
+ */
+
+#define HOST_BOUNDARY           ((uintptr_t)1)
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_set_up_static_boundaries(
+                                                uintptr_t *p_spm_boundary)
+{
+    *p_spm_boundary = HOST_BOUNDARY;
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_bind_boundary(
+                                    const struct partition_load_info_t *p_ldinf,
+                                    uintptr_t *p_boundary)
+{
+    (void)p_ldinf;
+
+    if (!p_boundary) {
+        FIH_RET(fih_int_encode(TFM_HAL_ERROR_GENERIC));
+    }
+
+    *p_boundary = HOST_BOUNDARY;
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_activate_boundary(
+                            const struct partition_load_info_t *p_ldinf,
+                            uintptr_t boundary)
+{
+    (void)p_ldinf;
+    (void)boundary;
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_memory_check(
+                                           uintptr_t boundary, uintptr_t base,
+                                           size_t size, uint32_t access_type)
+{
+    (void)boundary;
+    (void)access_type;
+
+    /* Wrap around is the only access which is certainly invalid here. */
+    if (base + size < base) {
+        FIH_RET(fih_int_encode(TFM_HAL_ERROR_MEM_FAULT));
+    }
+
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+bool tfm_hal_boundary_need_switch(uintptr_t boundary_from,
+                                  uintptr_t boundary_to)
+{
+    (void)boundary_from;
+    (void)boundary_to;
+
+    return false;
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) tfm_hal_platform_init(void)
+{
+    FIH_RET(fih_int_encode(TFM_HAL_SUCCESS));
+}
+
+void tfm_hal_system_reset(void)
+{
+    fprintf(stderr, "SPM requested a system reset\n");
+    exit(EXIT_FAILURE);
+}
+
+void tfm_hal_system_halt(void)
+{
+    fprintf(stderr, "SPM requested a system halt\n");
+    exit(EXIT_FAILURE);
+}
+
+enum tfm_hal_status_t tfm_hal_irq_enable(uint32_t irq_num)
+{
+    (void)irq_num;
+
+    return TFM_HAL_ERROR_NOT_SUPPORTED;
+}
+
+enum tfm_hal_status_t tfm_hal_irq_disable(uint32_t irq_num)
+{
+    (void)irq_num;
+
+    return TFM_HAL_ERROR_NOT_SUPPORTED;
+}
+
+int32_t tfm_hal_output_spm_log(const char *str, uint32_t len)
+{
+    return (int32_t)fwrite(str, 1, len, stdout);
+}
+
+void tfm_hal_host_wait_for_interrupt(void)
+{
+    /* Nothing can wake up the partitions, all of them are blocked. */
+    fprintf(stderr, "All partitions are blocked\n");
+    exit(EXIT_FAILURE);
+}
+
+#ifdef CONFIG_TFM_SPM_PROFILING
+/* Nanoseconds instead of cycles, a cycle counter is not portable on host. */
+uint32_t spm_prof_get_cycles(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+}
+
+void spm_prof_init(void)
+{
+}
+#endif
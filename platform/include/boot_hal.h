@@ -135,6 +135,17 @@ int boot_store_measurement(uint8_t index,
                            const struct boot_measurement_metadata *metadata,
                            bool lock_measurement);
 
+/**
+ * \brief Pass the boot timeline checkpoints recorded by a boot stage to the
+ *        next stages through the shared data area.
+ *
+ * \param[in] stage                 Boot stage which recorded the checkpoints,
+ *                                  one of the BOOT_TS_STAGE_* values.
+ *
+ * \return Returns 0 on success, non-zero otherwise.
+ */
+int boot_store_timestamps(uint8_t stage);
+
 #ifdef __cplusplus
 }
 #endif
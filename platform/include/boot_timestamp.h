@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __BOOT_TIMESTAMP_H__
+#define __BOOT_TIMESTAMP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Boot stages, also used as the minor type of the shared data TLV entries */
+#define BOOT_TS_STAGE_BL1_1             0x00
+#define BOOT_TS_STAGE_BL1_2             0x01
+#define BOOT_TS_STAGE_BL2               0x02
+#define BOOT_TS_STAGE_SPM               0x03
+
+/* Checkpoints. The meaning of the argument is given for each of them. */
+#define BOOT_TS_STAGE_ENTRY             0x01    /* Stage started            */
+#define BOOT_TS_PLATFORM_INIT_DONE      0x02    /* Platform init done       */
+#define BOOT_TS_OTP_INIT_DONE           0x03    /* OTP and provisioning done */
+#define BOOT_TS_IMAGE_LOAD_DONE         0x04    /* Image ID                 */
+#define BOOT_TS_IMAGE_HASH_DONE         0x05    /* Image ID                 */
+#define BOOT_TS_SIG_VERIFY_DONE         0x06    /* Image ID                 */
+#define BOOT_TS_STAGE_EXIT              0x07    /* Jumping to next stage    */
+#define BOOT_TS_SPM_INIT_DONE           0x10    /* Partitions loaded        */
+#define BOOT_TS_PARTITION_INIT_ENTRY    0x11    /* Partition ID             */
+#define BOOT_TS_PARTITION_INIT_EXIT     0x12    /* Partition ID             */
+#define BOOT_TS_NS_ENTRY                0x13    /* Partition ID of NS agent */
+/* Checkpoints from this value on are defined by platforms */
+#define BOOT_TS_PLATFORM_BASE           0x80
+
+/* Maximum number of checkpoints recorded by a boot stage */
+#ifndef BOOT_TS_MAX_RECORDS
+#define BOOT_TS_MAX_RECORDS             32
+#endif
+
+/**
+ * A checkpoint of the boot timeline. Records are passed to the next stages in
+ * the shared data area as an array, in one TLV entry per stage.
+ */
+struct boot_ts_record_t {
+    uint8_t  stage;                     /* BOOT_TS_STAGE_*                  */
+    uint8_t  checkpoint;                /* BOOT_TS_* checkpoint             */
+    uint16_t arg;                       /* Checkpoint specific argument     */
+    uint32_t time;                      /* boot_ts_get_time()               */
+};
+
+/**
+ * \brief Get the current time of the boot timeline.
+ *
+ * \details The default implementation reads the DWT cycle counter on
+ *          Armv7-M and Armv8-M Mainline cores, and enables it if needed. It
+ *          is never reset, so all the stages share the same time base.
+ *          Platforms can override it with a free running timer.
+ *
+ * \return Current time, in platform defined units.
+ */
+uint32_t boot_ts_get_time(void);
+
+/**
+ * \brief Record a checkpoint of the boot timeline. Checkpoints beyond
+ *        \ref BOOT_TS_MAX_RECORDS are dropped.
+ *
+ * \param[in] stage         Boot stage recording the checkpoint.
+ * \param[in] checkpoint    The checkpoint reached.
+ * \param[in] arg           Checkpoint specific argument.
+ */
+void boot_ts_record(uint8_t stage, uint8_t checkpoint, uint16_t arg);
+
+/**
+ * \brief Get the checkpoints which have not been fetched yet, and mark them
+ *        as fetched.
+ *
+ * \param[out] p_records    Set to the first checkpoint not fetched yet.
+ *
+ * \return Number of checkpoints.
+ */
+size_t boot_ts_fetch_records(const struct boot_ts_record_t **p_records);
+
+#ifdef TFM_BOOT_TIMESTAMPS
+#define BOOT_TS_RECORD(stage, checkpoint, arg)                          \
+    boot_ts_record((stage), (checkpoint), (uint16_t)(arg))
+#else
+#define BOOT_TS_RECORD(stage, checkpoint, arg)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_TIMESTAMP_H__ */
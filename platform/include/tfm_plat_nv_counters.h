@@ -115,6 +115,50 @@ enum tfm_plat_err_t tfm_plat_increment_nv_counter(
 enum tfm_plat_err_t tfm_plat_set_nv_counter(enum tfm_nv_counter_t counter_id,
                                             uint32_t value);
 
+/**
+ * \brief Reads several non-volatile (NV) counters.
+ *
+ * \note A weak implementation reading the counters one by one is provided.
+ *       Platforms which can read several counters in one access of the
+ *       underlying storage can override it.
+ *
+ * \param[in]  counter_ids  NV counter IDs.
+ * \param[in]  num          Number of counters.
+ * \param[out] vals         Array of num elements to store the NV counter
+ *                          values, in the order of counter_ids.
+ *
+ * \return  TFM_PLAT_ERR_SUCCESS if all the values are read correctly.
+ *          Otherwise, the error of the first counter which cannot be read.
+ */
+enum tfm_plat_err_t tfm_plat_read_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num, uint32_t *vals);
+
+/**
+ * \brief Increments several non-volatile (NV) counters by one.
+ *
+ * \note A weak implementation incrementing the counters one by one is
+ *       provided. Platforms which can update several counters in one
+ *       transaction of the underlying storage can override it.
+ *
+ * \note The increment is not atomic in general: on error, the counters before
+ *       the failing one may already be incremented. The template
+ *       implementation only increments the PS counters kept in flash all
+ *       together or not at all. The other counters of a mixed list are
+ *       incremented one by one afterwards.
+ *
+ * \param[in] counter_ids  NV counter IDs.
+ * \param[in] num          Number of counters.
+ *
+ * \return  TFM_PLAT_ERR_SUCCESS if all the counters are incremented.
+ *          Otherwise, the error of the first counter which cannot be
+ *          incremented, TFM_PLAT_ERR_MAX_VALUE if it has reached its maximum
+ *          value.
+ */
+enum tfm_plat_err_t tfm_plat_increment_nv_counters(
+                                    const enum tfm_nv_counter_t *counter_ids,
+                                    uint32_t num);
+
 #ifdef __cplusplus
 }
 #endif
@@ -43,6 +43,51 @@ enum tfm_platform_err_t tfm_platform_hal_ioctl(tfm_platform_ioctl_req_t request,
                                                psa_invec *in_vec,
                                                psa_outvec *out_vec);
 
+/*!
+ * \brief Starts a platform-specific service which completes later
+ *
+ * \details The platform copies what it needs from in_vec before returning,
+ *          and signals the client identified by client_id when the service
+ *          completes, in a platform specific way (e.g. a mailbox doorbell to
+ *          the non-secure side). The result is then collected with
+ *          \ref tfm_platform_hal_ioctl_async_poll. A weak implementation
+ *          returning TFM_PLATFORM_ERR_NOT_SUPPORTED is provided, in which case
+ *          the request is served by \ref tfm_platform_hal_ioctl before the
+ *          ticket is returned to the client.
+ *
+ * \param[in]  client_id    Client which has started the request
+ * \param[in]  ticket       Ticket identifying the request
+ * \param[in]  request      Request identifier (valid values vary
+ *                          based on the platform)
+ * \param[in]  in_vec       Input buffer to the requested service (or NULL)
+ *
+ * \return TFM_PLATFORM_ERR_SUCCESS if the request is started,
+ *         TFM_PLATFORM_ERR_NOT_SUPPORTED if it cannot complete later.
+ *         Otherwise, values as specified by the \ref tfm_platform_err_t
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM", "PSA-ROT")
+enum tfm_platform_err_t
+tfm_platform_hal_ioctl_async_start(int32_t client_id, uint32_t ticket,
+                                   tfm_platform_ioctl_req_t request,
+                                   psa_invec *in_vec);
+
+/*!
+ * \brief Gets the result of a platform-specific service started with
+ *        \ref tfm_platform_hal_ioctl_async_start
+ *
+ * \param[in]  ticket       Ticket identifying the request
+ * \param[out] out_vec      Output buffer to the requested service (or NULL).
+ *                          On completion, its len is set to the size of the
+ *                          output written, as in \ref tfm_platform_hal_ioctl.
+ *
+ * \return TFM_PLATFORM_ERR_IN_PROGRESS if the service is not completed yet.
+ *         Otherwise, the result of the service as specified by the
+ *         \ref tfm_platform_err_t, after which the ticket is released.
+ */
+TFM_LINK_SET_RO_IN_PARTITION_SECTION("TFM_SP_PLATFORM", "PSA-ROT")
+enum tfm_platform_err_t
+tfm_platform_hal_ioctl_async_poll(uint32_t ticket, psa_outvec *out_vec);
+
 #ifdef __cplusplus
 }
 #endif
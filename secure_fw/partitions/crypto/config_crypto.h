@@ -26,6 +26,15 @@
 #define CRYPTO_ENGINE_BUF_SIZE                 0x4000
 #endif
 
+/*
+ * Serve the Mbed Crypto allocations from power of two size classes carved from
+ * the engine buffer, instead of the Mbed TLS buffer allocator
+ */
+#ifndef CRYPTO_ENGINE_SLAB_ALLOC
+#pragma message("CRYPTO_ENGINE_SLAB_ALLOC is defaulted to 0. Please check and set it explicitly.")
+#define CRYPTO_ENGINE_SLAB_ALLOC               0
+#endif
+
 /* The max number of concurrent operations that can be active (allocated) at any time in Crypto */
 #ifndef CRYPTO_CONC_OPER_NUM
 #pragma message("CRYPTO_CONC_OPER_NUM is defaulted to 8. Please check and set it explicitly.")
@@ -86,6 +95,12 @@
 #define CRYPTO_KEY_DERIVATION_MODULE_ENABLED   1
 #endif
 
+/* Enable the Crypto resource usage statistics module */
+#ifndef CRYPTO_STATS_MODULE_ENABLED
+#pragma message("CRYPTO_STATS_MODULE_ENABLED is defaulted to 0. Please check and set it explicitly.")
+#define CRYPTO_STATS_MODULE_ENABLED            0
+#endif
+
 /* Default size of the internal scratch buffer used for PSA FF IOVec allocations */
 #ifndef CRYPTO_IOVEC_BUFFER_SIZE
 #pragma message("CRYPTO_IOVEC_BUFFER_SIZE is defaulted to 5120. Please check and set it explicitly.")
@@ -33,6 +33,10 @@ struct tfm_crypto_operation_s {
 
 static struct tfm_crypto_operation_s operations[CRYPTO_CONC_OPER_NUM] = {{0}};
 
+/* Number of operation contexts in use, and its peak */
+static uint32_t oper_in_use;
+static uint32_t oper_max_in_use;
+
 /*
  * \brief Function used to clear the memory associated to a backend context
  *
@@ -59,6 +63,8 @@ psa_status_t tfm_crypto_init_alloc(void)
 {
     /* Clear the contents of the local contexts */
     (void)memset(operations, 0, sizeof(operations));
+    oper_in_use = 0;
+    oper_max_in_use = 0;
     return PSA_SUCCESS;
 }
 
@@ -93,6 +99,9 @@ psa_status_t tfm_crypto_operation_alloc(enum tfm_crypto_operation_type type,
             operations[i].type = type;
             *handle = i + 1;
             *ctx = (void *) &(operations[i].operation);
+            if (++oper_in_use > oper_max_in_use) {
+                oper_max_in_use = oper_in_use;
+            }
             return PSA_SUCCESS;
         }
     }
@@ -126,6 +135,7 @@ psa_status_t tfm_crypto_operation_release(uint32_t *handle)
         operations[h_val - 1].in_use = TFM_CRYPTO_NOT_IN_USE;
         operations[h_val - 1].type = TFM_CRYPTO_OPERATION_NONE;
         operations[h_val - 1].owner = 0;
+        oper_in_use--;
 
         return PSA_SUCCESS;
     }
@@ -163,4 +173,16 @@ psa_status_t tfm_crypto_operation_lookup(enum tfm_crypto_operation_type type,
 
     return PSA_ERROR_BAD_STATE;
 }
+
+void tfm_crypto_operation_stats(struct tfm_crypto_stats *stats)
+{
+    stats->oper_num = CRYPTO_CONC_OPER_NUM;
+    stats->oper_in_use = oper_in_use;
+    stats->oper_max_in_use = oper_max_in_use;
+}
+
+void tfm_crypto_operation_reset_stats(void)
+{
+    oper_max_in_use = oper_in_use;
+}
 /*!@}*/
@@ -16,6 +16,11 @@
 #error "CRYPTO_RNG_MODULE_ENABLED enables, but not all prerequisites (missing RNG)!"
 #endif
 
+#if CRYPTO_ENGINE_SLAB_ALLOC && \
+    (!defined(MBEDTLS_PLATFORM_MEMORY) || defined(MBEDTLS_PLATFORM_CALLOC_MACRO))
+#error "CRYPTO_ENGINE_SLAB_ALLOC enables, but not all prerequisites (missing MBEDTLS_PLATFORM_MEMORY hooks)!"
+#endif
+
 #if CRYPTO_AEAD_MODULE_ENABLED &&                 \
     (!defined(PSA_WANT_ALG_CCM) && !defined(PSA_WANT_ALG_GCM) && \
      !defined(PSA_WANT_ALG_CHACHA20_POLY1305))
@@ -15,11 +15,13 @@
 #include "crypto_check_config.h"
 #include "tfm_plat_crypto_keys.h"
 
+#if !CRYPTO_ENGINE_SLAB_ALLOC
 /*
  * \brief This Mbed TLS include is needed to initialise the memory allocator
  *        of the library used for internal allocations
  */
 #include "mbedtls/memory_buffer_alloc.h"
+#endif
 
 #include "mbedtls/platform.h"
 
@@ -65,6 +67,17 @@ psa_status_t tfm_crypto_get_caller_id(int32_t *id)
     return PSA_SUCCESS;
 }
 
+void tfm_crypto_scratch_stats(struct tfm_crypto_stats *stats)
+{
+    /* The IOVecs are mapped, no scratch is used */
+    stats->scratch_size = 0;
+    stats->scratch_max_used = 0;
+}
+
+void tfm_crypto_scratch_reset_stats(void)
+{
+}
+
 static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
                                            psa_invec in_vec[],
                                            size_t in_len,
@@ -103,8 +116,9 @@ static struct tfm_crypto_scratch {
     __attribute__((__aligned__(TFM_CRYPTO_IOVEC_ALIGNMENT)))
     uint8_t buf[CRYPTO_IOVEC_BUFFER_SIZE];
     uint32_t alloc_index;
+    uint32_t max_alloc_index;
     int32_t owner;
-} scratch = {.buf = {0}, .alloc_index = 0};
+} scratch = {.buf = {0}, .alloc_index = 0, .max_alloc_index = 0};
 
 static psa_status_t tfm_crypto_set_scratch_owner(int32_t id)
 {
@@ -132,6 +146,9 @@ static psa_status_t tfm_crypto_alloc_scratch(size_t requested_size, void **buf)
 
     /* Increase the allocated size */
     scratch.alloc_index += requested_size;
+    if (scratch.alloc_index > scratch.max_alloc_index) {
+        scratch.max_alloc_index = scratch.alloc_index;
+    }
 
     return PSA_SUCCESS;
 }
@@ -154,6 +171,18 @@ psa_status_t tfm_crypto_get_caller_id(int32_t *id)
     return tfm_crypto_get_scratch_owner(id);
 }
 
+void tfm_crypto_scratch_stats(struct tfm_crypto_stats *stats)
+{
+    stats->scratch_size = sizeof(scratch.buf);
+    stats->scratch_max_used = scratch.max_alloc_index;
+}
+
+void tfm_crypto_scratch_reset_stats(void)
+{
+    /* The peak is reset from the request being served */
+    scratch.max_alloc_index = scratch.alloc_index;
+}
+
 static psa_status_t tfm_crypto_init_iovecs(const psa_msg_t *msg,
                                            psa_invec in_vec[],
                                            size_t in_len,
@@ -263,6 +292,10 @@ static uint8_t mbedtls_mem_buf[CRYPTO_ENGINE_BUF_SIZE] = {0};
 
 static psa_status_t tfm_crypto_engine_init(void)
 {
+#if CRYPTO_ENGINE_SLAB_ALLOC
+    psa_status_t status;
+#endif
+
 #if CRYPTO_NV_SEED
     LOG_INFFMT("[INF][Crypto] ");
     LOG_INFFMT("Provisioning entropy seed... ");
@@ -272,11 +305,26 @@ static psa_status_t tfm_crypto_engine_init(void)
     LOG_INFFMT("\033[0;32mcomplete.\033[0m\r\n");
 #endif /* CRYPTO_NV_SEED */
 
+#if CRYPTO_ENGINE_SLAB_ALLOC
+    /* Serve the Mbed Crypto allocations from size classes carved from the
+     * provided buffer, through the platform memory hooks
+     */
+    status = tfm_crypto_slab_init(mbedtls_mem_buf, CRYPTO_ENGINE_BUF_SIZE);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (mbedtls_platform_set_calloc_free(tfm_crypto_slab_calloc,
+                                         tfm_crypto_slab_free) != 0) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+#else
     /* Initialise the Mbed Crypto memory allocator to use static memory
      * allocation from the provided buffer instead of using the heap
      */
     mbedtls_memory_buffer_alloc_init(mbedtls_mem_buf,
                                      CRYPTO_ENGINE_BUF_SIZE);
+#endif
 
     /* mbedtls_printf is used to print messages including error information. */
 #if (TFM_PARTITION_LOG_LEVEL >= TFM_PARTITION_LOG_LEVEL_ERROR)
@@ -366,7 +414,8 @@ psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
     group_id = TFM_CRYPTO_GET_GROUP_ID(iov->function_id);
 
     is_key_required = !((group_id == TFM_CRYPTO_GROUP_ID_HASH) ||
-                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM));
+                        (group_id == TFM_CRYPTO_GROUP_ID_RANDOM) ||
+                        (group_id == TFM_CRYPTO_GROUP_ID_STATS));
 
     if (is_key_required) {
         status = tfm_crypto_get_caller_id(&caller_id);
@@ -403,6 +452,8 @@ psa_status_t tfm_crypto_api_dispatcher(psa_invec in_vec[],
                                                    &encoded_key);
     case TFM_CRYPTO_GROUP_ID_RANDOM:
         return tfm_crypto_random_interface(in_vec, out_vec);
+    case TFM_CRYPTO_GROUP_ID_STATS:
+        return tfm_crypto_stats_interface(in_vec, out_vec);
     default:
         LOG_ERRFMT("[ERR][Crypto] Unsupported request!\r\n");
         return PSA_ERROR_NOT_SUPPORTED;
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config_crypto.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_sp_log.h"
+
+#if CRYPTO_ENGINE_SLAB_ALLOC
+
+/*
+ * The Mbed Crypto allocations are served from power of two size classes, from
+ * (1 << CRYPTO_SLAB_MIN_SHIFT) to (1 << CRYPTO_SLAB_MAX_SHIFT) bytes. Each
+ * block starts with a header which records its class. Freed blocks are kept
+ * in a free list per class, and classes with an empty free list carve new
+ * blocks from the end of the engine buffer. Once the buffer is fully carved,
+ * the free blocks at the end of the carved memory are returned to it first,
+ * then a free block of a larger class is used instead. Blocks never move from
+ * one class to another otherwise: free blocks followed by a block in use are
+ * only available to their class and the larger ones, so a workload changing
+ * its allocation sizes can exhaust the buffer with free memory left. Release
+ * takes constant time, and so does allocation unless the buffer is fully
+ * carved.
+ */
+#define CRYPTO_SLAB_MIN_SHIFT       4
+#define CRYPTO_SLAB_MAX_SHIFT       12
+#define CRYPTO_SLAB_CLASS_NUM       (CRYPTO_SLAB_MAX_SHIFT - \
+                                     CRYPTO_SLAB_MIN_SHIFT + 1)
+
+/* Alignment of the blocks returned, which is also the size of the header */
+#define CRYPTO_SLAB_ALIGN           8u
+
+struct crypto_slab_block_t {
+    union {
+        struct {
+            uint32_t class_idx;     /*!< Class of the block */
+            uint32_t is_free;       /*!< Whether the block is in a free list */
+        } info;
+        uint8_t align[CRYPTO_SLAB_ALIGN];
+    } hdr;
+    /* Link to the next free block, only valid while the block is free */
+    struct crypto_slab_block_t *next;
+};
+
+static struct {
+    uint8_t *base;                  /*!< Start of the engine buffer */
+    uint8_t *top;                   /*!< Start of the memory not carved yet */
+    uint8_t *end;                   /*!< End of the engine buffer */
+    size_t used;                    /*!< Memory in allocated blocks */
+    size_t max_used;                /*!< Peak of the memory allocated */
+    struct crypto_slab_block_t *free_list[CRYPTO_SLAB_CLASS_NUM];
+    struct tfm_crypto_slab_stats_t stats[CRYPTO_SLAB_CLASS_NUM];
+} slab;
+
+static size_t slab_class_size(uint32_t class_idx)
+{
+    return (size_t)1 << (class_idx + CRYPTO_SLAB_MIN_SHIFT);
+}
+
+static struct crypto_slab_block_t *slab_pop(uint32_t class_idx)
+{
+    struct crypto_slab_block_t *block = slab.free_list[class_idx];
+
+    if (block != NULL) {
+        slab.free_list[class_idx] = block->next;
+        block->hdr.info.is_free = 0;
+    }
+
+    return block;
+}
+
+static void slab_push(struct crypto_slab_block_t *block)
+{
+    uint32_t class_idx = block->hdr.info.class_idx;
+
+    block->hdr.info.is_free = 1;
+    block->next = slab.free_list[class_idx];
+    slab.free_list[class_idx] = block;
+}
+
+/* Return the free blocks at the end of the carved memory to the memory not
+ * carved yet, and rebuild the free lists with the remaining free blocks. This
+ * walks all the carved blocks, so it is only done once the buffer is fully
+ * carved.
+ */
+static void slab_reclaim(void)
+{
+    struct crypto_slab_block_t *block;
+    uint8_t *new_top = slab.base;
+    uint8_t *ptr;
+    uint32_t class_idx;
+
+    ptr = slab.base;
+    while (ptr < slab.top) {
+        block = (struct crypto_slab_block_t *)ptr;
+        ptr += CRYPTO_SLAB_ALIGN + slab_class_size(block->hdr.info.class_idx);
+        if (!block->hdr.info.is_free) {
+            new_top = ptr;
+        }
+    }
+
+    if (new_top == slab.top) {
+        return;
+    }
+
+    for (class_idx = 0; class_idx < CRYPTO_SLAB_CLASS_NUM; class_idx++) {
+        slab.free_list[class_idx] = NULL;
+    }
+
+    ptr = slab.base;
+    while (ptr < slab.top) {
+        block = (struct crypto_slab_block_t *)ptr;
+        ptr += CRYPTO_SLAB_ALIGN + slab_class_size(block->hdr.info.class_idx);
+        if ((uint8_t *)block >= new_top) {
+            slab.stats[block->hdr.info.class_idx].carved--;
+        } else if (block->hdr.info.is_free) {
+            slab_push(block);
+        }
+    }
+
+    slab.top = new_top;
+}
+
+static void *slab_alloc(size_t size)
+{
+    struct crypto_slab_block_t *block;
+    size_t block_size;
+    uint32_t class_idx = 0;
+
+    while (slab_class_size(class_idx) < size) {
+        if (++class_idx == CRYPTO_SLAB_CLASS_NUM) {
+            LOG_DBGFMT("[DBG][Crypto] Allocation too large for the slabs\r\n");
+            return NULL;
+        }
+    }
+
+    block = slab_pop(class_idx);
+    if (block == NULL) {
+        block_size = CRYPTO_SLAB_ALIGN + slab_class_size(class_idx);
+        if ((size_t)(slab.end - slab.top) < block_size) {
+            slab_reclaim();
+        }
+        if ((size_t)(slab.end - slab.top) >= block_size) {
+            block = (struct crypto_slab_block_t *)slab.top;
+            block->hdr.info.class_idx = class_idx;
+            block->hdr.info.is_free = 0;
+            slab.top += block_size;
+            slab.stats[class_idx].carved++;
+        } else {
+            /* Out of memory to carve, fall back to a free larger block */
+            slab.stats[class_idx].failed++;
+            while (block == NULL && ++class_idx < CRYPTO_SLAB_CLASS_NUM) {
+                block = slab_pop(class_idx);
+            }
+            if (block == NULL) {
+                LOG_DBGFMT("[DBG][Crypto] Engine buffer exhausted\r\n");
+                return NULL;
+            }
+        }
+    }
+
+    /* The block is accounted in its own class, even if borrowed */
+    class_idx = block->hdr.info.class_idx;
+    if (++slab.stats[class_idx].in_use > slab.stats[class_idx].max_in_use) {
+        slab.stats[class_idx].max_in_use = slab.stats[class_idx].in_use;
+    }
+
+    slab.used += CRYPTO_SLAB_ALIGN + slab_class_size(class_idx);
+    if (slab.used > slab.max_used) {
+        slab.max_used = slab.used;
+    }
+
+    return (uint8_t *)block + CRYPTO_SLAB_ALIGN;
+}
+
+psa_status_t tfm_crypto_slab_init(uint8_t *buf, size_t size)
+{
+    uintptr_t start = ((uintptr_t)buf + CRYPTO_SLAB_ALIGN - 1) &
+                      ~((uintptr_t)CRYPTO_SLAB_ALIGN - 1);
+
+    if (start - (uintptr_t)buf >= size) {
+        return PSA_ERROR_INSUFFICIENT_MEMORY;
+    }
+
+    (void)memset(&slab, 0, sizeof(slab));
+    slab.base = (uint8_t *)start;
+    slab.top = slab.base;
+    slab.end = buf + size;
+
+    return PSA_SUCCESS;
+}
+
+void *tfm_crypto_slab_calloc(size_t n, size_t size)
+{
+    void *ptr;
+
+    if (n == 0 || size == 0 || n > SIZE_MAX / size) {
+        return NULL;
+    }
+
+    ptr = slab_alloc(n * size);
+    if (ptr != NULL) {
+        (void)memset(ptr, 0, n * size);
+    }
+
+    return ptr;
+}
+
+void tfm_crypto_slab_free(void *ptr)
+{
+    struct crypto_slab_block_t *block;
+    uint32_t class_idx;
+
+    if (ptr == NULL) {
+        return;
+    }
+
+    /* Ignore the pointers which have not been returned by the allocator */
+    if ((uint8_t *)ptr < slab.base + CRYPTO_SLAB_ALIGN ||
+        (uint8_t *)ptr >= slab.top) {
+        return;
+    }
+
+    block = (struct crypto_slab_block_t *)((uint8_t *)ptr - CRYPTO_SLAB_ALIGN);
+    class_idx = block->hdr.info.class_idx;
+    if (class_idx >= CRYPTO_SLAB_CLASS_NUM || block->hdr.info.is_free) {
+        return;
+    }
+
+    slab_push(block);
+    slab.stats[class_idx].in_use--;
+    slab.used -= CRYPTO_SLAB_ALIGN + slab_class_size(class_idx);
+}
+
+psa_status_t tfm_crypto_slab_get_stats(uint32_t class_idx,
+                                       struct tfm_crypto_slab_stats_t *stats)
+{
+    if (class_idx >= CRYPTO_SLAB_CLASS_NUM) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    *stats = slab.stats[class_idx];
+    stats->block_size = slab_class_size(class_idx);
+
+    return PSA_SUCCESS;
+}
+
+void tfm_crypto_slab_get_usage(size_t *used, size_t *max_used)
+{
+    *used = slab.used;
+    *max_used = slab.max_used;
+}
+
+void tfm_crypto_slab_reset_peaks(void)
+{
+    uint32_t class_idx;
+
+    for (class_idx = 0; class_idx < CRYPTO_SLAB_CLASS_NUM; class_idx++) {
+        slab.stats[class_idx].max_in_use = slab.stats[class_idx].in_use;
+    }
+    slab.max_used = slab.used;
+}
+#endif /* CRYPTO_ENGINE_SLAB_ALLOC */
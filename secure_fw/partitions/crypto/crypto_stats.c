@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "config_crypto.h"
+#include "tfm_mbedcrypto_include.h"
+
+#include "tfm_crypto_api.h"
+#include "tfm_crypto_defs.h"
+
+#if !CRYPTO_ENGINE_SLAB_ALLOC && defined(MBEDTLS_MEMORY_DEBUG)
+#include "mbedtls/memory_buffer_alloc.h"
+#endif
+
+#if CRYPTO_STATS_MODULE_ENABLED
+static void engine_buf_stats(struct tfm_crypto_stats *stats)
+{
+    size_t used = 0;
+    size_t max_used = 0;
+#if !CRYPTO_ENGINE_SLAB_ALLOC && defined(MBEDTLS_MEMORY_DEBUG)
+    size_t blocks;
+#endif
+
+#if CRYPTO_ENGINE_SLAB_ALLOC
+    tfm_crypto_slab_get_usage(&used, &max_used);
+#elif defined(MBEDTLS_MEMORY_DEBUG)
+    mbedtls_memory_buffer_alloc_cur_get(&used, &blocks);
+    mbedtls_memory_buffer_alloc_max_get(&max_used, &blocks);
+#endif
+
+    stats->engine_buf_size = CRYPTO_ENGINE_BUF_SIZE;
+    stats->engine_buf_used = (uint32_t)used;
+    stats->engine_buf_max_used = (uint32_t)max_used;
+}
+
+static void engine_buf_reset_stats(void)
+{
+#if CRYPTO_ENGINE_SLAB_ALLOC
+    tfm_crypto_slab_reset_peaks();
+#elif defined(MBEDTLS_MEMORY_DEBUG)
+    mbedtls_memory_buffer_alloc_max_reset();
+#endif
+}
+
+static void key_slot_stats(struct tfm_crypto_stats *stats)
+{
+    mbedtls_psa_stats_t psa_stats;
+
+    mbedtls_psa_get_stats(&psa_stats);
+
+    /* Each slot is either empty, or holds a volatile or persistent key */
+    stats->key_slot_in_use =
+                    (uint32_t)(psa_stats.MBEDTLS_PRIVATE(volatile_slots) +
+                               psa_stats.MBEDTLS_PRIVATE(persistent_slots));
+    stats->key_slot_num = stats->key_slot_in_use +
+                    (uint32_t)psa_stats.MBEDTLS_PRIVATE(empty_slots);
+}
+#endif /* CRYPTO_STATS_MODULE_ENABLED */
+
+/*!
+ * \defgroup stats Resource usage statistics of the Crypto service, reserved to
+ *                 the secure partitions
+ */
+
+/*!@{*/
+psa_status_t tfm_crypto_stats_interface(psa_invec in_vec[],
+                                        psa_outvec out_vec[])
+{
+#if !CRYPTO_STATS_MODULE_ENABLED
+    (void)in_vec;
+    (void)out_vec;
+
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    const struct tfm_crypto_pack_iovec *iov = in_vec[0].base;
+    struct tfm_crypto_stats stats;
+    int32_t caller_id = 0;
+    psa_status_t status;
+
+    status = tfm_crypto_get_caller_id(&caller_id);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    if (TFM_CLIENT_ID_IS_NS(caller_id)) {
+        return PSA_ERROR_NOT_PERMITTED;
+    }
+
+    switch (iov->function_id) {
+    case TFM_CRYPTO_GET_STATS_SID:
+        if (out_vec[0].len != sizeof(struct tfm_crypto_stats)) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+
+        (void)memset(&stats, 0, sizeof(stats));
+        engine_buf_stats(&stats);
+        tfm_crypto_operation_stats(&stats);
+        tfm_crypto_scratch_stats(&stats);
+        key_slot_stats(&stats);
+
+        (void)memcpy(out_vec[0].base, &stats, sizeof(stats));
+        return PSA_SUCCESS;
+    case TFM_CRYPTO_RESET_STATS_SID:
+        engine_buf_reset_stats();
+        tfm_crypto_operation_reset_stats();
+        tfm_crypto_scratch_reset_stats();
+        return PSA_SUCCESS;
+    default:
+        return PSA_ERROR_NOT_SUPPORTED;
+    }
+#endif
+}
+/*!@}*/
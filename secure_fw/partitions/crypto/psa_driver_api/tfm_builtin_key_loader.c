@@ -11,9 +11,12 @@
 #include "tfm_mbedcrypto_include.h"
 #include "tfm_crypto_defs.h"
 #include "mbedtls/hkdf.h"
+#include "mbedtls/platform_util.h"
 #include "psa_manifest/pid.h"
 #include "tfm_plat_crypto_keys.h"
+#include "tfm_plat_otp.h"
 
+#include <stdbool.h>
 #include <string.h>
 
 #ifndef TFM_BUILTIN_MAX_KEY_LEN
@@ -24,6 +27,11 @@
 #define TFM_BUILTIN_MAX_KEYS 8
 #endif /* TFM_BUILTIN_MAX_KEYS */
 
+/* Number of subkeys derived for an owner kept in the cache, 0 to disable it */
+#ifndef TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE
+#define TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE 4
+#endif /* TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE */
+
 struct tfm_builtin_key_t {
     uint8_t key[TFM_BUILTIN_MAX_KEY_LEN];
     size_t key_len;
@@ -34,6 +42,59 @@ struct tfm_builtin_key_t {
 
 static struct tfm_builtin_key_t builtin_key_slots[TFM_BUILTIN_MAX_KEYS] = {0};
 
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+struct tfm_builtin_derived_key_t {
+    uint8_t key[TFM_BUILTIN_MAX_KEY_LEN];
+    size_t key_len;
+    mbedtls_key_owner_id_t owner;
+    psa_drv_slot_number_t slot_number;
+    uint32_t is_valid;
+};
+
+/* Subkeys are derived with HKDF, keep the last ones derived to avoid doing it
+ * for every use of the key. The cache is only valid in the lifecycle state it
+ * has been filled in.
+ */
+static struct tfm_builtin_derived_key_t
+                    derived_key_cache[TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE] = {0};
+static uint32_t derived_key_cache_next;
+static enum plat_otp_lcs_t derived_key_cache_lcs = PLAT_OTP_LCS_UNKNOWN;
+
+static void derived_key_cache_invalidate(struct tfm_builtin_derived_key_t *entry)
+{
+    mbedtls_platform_zeroize(entry, sizeof(*entry));
+}
+
+static void derived_key_cache_flush(void)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE; idx++) {
+        derived_key_cache_invalidate(&derived_key_cache[idx]);
+    }
+}
+
+/* Latch the lifecycle state when the builtin keys are loaded, and invalidate
+ * the whole cache if it has changed since the cache has been filled in. The
+ * lifecycle state is not read again on each use of the cache: code changing it
+ * once the keys are loaded calls tfm_builtin_key_loader_lcs_changed().
+ */
+static void derived_key_cache_latch_lcs(void)
+{
+    enum plat_otp_lcs_t lcs;
+
+    if (tfm_plat_otp_read(PLAT_OTP_ID_LCS, sizeof(lcs),
+                          (uint8_t *)&lcs) != TFM_PLAT_ERR_SUCCESS) {
+        lcs = PLAT_OTP_LCS_UNKNOWN;
+    }
+
+    if (lcs != derived_key_cache_lcs) {
+        derived_key_cache_flush();
+        derived_key_cache_lcs = lcs;
+    }
+}
+#endif /* TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0 */
+
 psa_status_t tfm_builtin_key_loader_load_key(uint8_t *buf, size_t key_len,
                                              psa_key_attributes_t *attr)
 {
@@ -41,6 +102,9 @@ psa_status_t tfm_builtin_key_loader_load_key(uint8_t *buf, size_t key_len,
     psa_drv_slot_number_t slot_number;
     psa_key_lifetime_t lifetime;
     mbedtls_svc_key_id_t key_id;
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+    uint32_t idx;
+#endif
 
     /* Set the owner to 0, as we handle permissions on a granular basis. Having
      * builtin keys being defined with different owners seems to cause a memory
@@ -60,6 +124,17 @@ psa_status_t tfm_builtin_key_loader_load_key(uint8_t *buf, size_t key_len,
         return err;
     }
 
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+    derived_key_cache_latch_lcs();
+
+    /* Drop the subkeys derived from the previous key in the slot. */
+    for (idx = 0; idx < TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE; idx++) {
+        if (derived_key_cache[idx].slot_number == slot_number) {
+            derived_key_cache_invalidate(&derived_key_cache[idx]);
+        }
+    }
+#endif
+
     memcpy(&(builtin_key_slots[slot_number].attr), attr,
            sizeof(psa_key_attributes_t));
     memcpy(&(builtin_key_slots[slot_number].key), buf, key_len);
@@ -69,6 +144,16 @@ psa_status_t tfm_builtin_key_loader_load_key(uint8_t *buf, size_t key_len,
     return PSA_SUCCESS;
 }
 
+void tfm_builtin_key_loader_lcs_changed(void)
+{
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+    /* Always drop the subkeys, the new state may not be readable. */
+    derived_key_cache_flush();
+    derived_key_cache_lcs = PLAT_OTP_LCS_UNKNOWN;
+    derived_key_cache_latch_lcs();
+#endif
+}
+
 psa_status_t tfm_builtin_key_loader_get_key_buffer_size(
         mbedtls_svc_key_id_t key_id, size_t *len)
 {
@@ -146,6 +231,55 @@ static psa_status_t derive_subkey_into_buffer(
     return PSA_SUCCESS;
 }
 
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+static psa_status_t derive_subkey_cached(
+        struct tfm_builtin_key_t *key_slot, psa_drv_slot_number_t slot_number,
+        mbedtls_key_owner_id_t owner,
+        uint8_t *key_buffer, size_t key_buffer_size, size_t *key_buffer_length)
+{
+    struct tfm_builtin_derived_key_t *entry;
+    psa_status_t err;
+    uint32_t idx;
+
+    if ((key_buffer_size > TFM_BUILTIN_MAX_KEY_LEN) ||
+        (derived_key_cache_lcs == PLAT_OTP_LCS_UNKNOWN)) {
+        return derive_subkey_into_buffer(key_slot, owner, key_buffer,
+                                         key_buffer_size, key_buffer_length);
+    }
+
+    for (idx = 0; idx < TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE; idx++) {
+        entry = &derived_key_cache[idx];
+        if (entry->is_valid &&
+            (entry->slot_number == slot_number) &&
+            (entry->owner == owner) &&
+            (entry->key_len == key_buffer_size)) {
+            memcpy(key_buffer, entry->key, entry->key_len);
+            *key_buffer_length = entry->key_len;
+            return PSA_SUCCESS;
+        }
+    }
+
+    err = derive_subkey_into_buffer(key_slot, owner, key_buffer,
+                                    key_buffer_size, key_buffer_length);
+    if (err != PSA_SUCCESS) {
+        return err;
+    }
+
+    /* Replace the entries in turn. */
+    entry = &derived_key_cache[derived_key_cache_next];
+    derived_key_cache_next = (derived_key_cache_next + 1) %
+                             TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE;
+
+    memcpy(entry->key, key_buffer, *key_buffer_length);
+    entry->key_len = *key_buffer_length;
+    entry->owner = owner;
+    entry->slot_number = slot_number;
+    entry->is_valid = 1;
+
+    return PSA_SUCCESS;
+}
+#endif /* TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0 */
+
 static psa_status_t builtin_key_copy_to_buffer(
         struct tfm_builtin_key_t *key_slot, uint8_t *key_buffer,
         size_t key_buffer_size, size_t *key_buffer_length)
@@ -200,10 +334,17 @@ psa_status_t tfm_builtin_key_loader_get_key_buffer(
      * they both need access to the raw builtin key.
      */
     if (psa_get_key_usage_flags(attributes) & PSA_KEY_USAGE_DERIVE) {
+#if TFM_BUILTIN_DERIVED_KEY_CACHE_SIZE > 0
+        err = derive_subkey_cached(key_slot, slot_number,
+                                   MBEDTLS_SVC_KEY_ID_GET_OWNER_ID(key_id),
+                                   key_buffer, key_buffer_size,
+                                   key_buffer_length);
+#else
         err = derive_subkey_into_buffer(key_slot,
                                         MBEDTLS_SVC_KEY_ID_GET_OWNER_ID(key_id),
                                         key_buffer, key_buffer_size,
                                         key_buffer_length);
+#endif
     } else {
         err = builtin_key_copy_to_buffer(key_slot, key_buffer, key_buffer_size,
                                          key_buffer_length);
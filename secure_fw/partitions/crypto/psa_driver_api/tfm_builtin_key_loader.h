@@ -42,6 +42,16 @@ enum psa_drv_slot_number_t {
 psa_status_t tfm_builtin_key_loader_load_key(uint8_t *buf, size_t key_len,
                                              psa_key_attributes_t *attr);
 
+/**
+ * \brief Notify the builtin key driver of a lifecycle state change
+ *
+ * \note The subkeys derived from the builtin keys are cached for the lifecycle
+ *       state read when the keys are loaded. Code writing PLAT_OTP_ID_LCS after
+ *       that, rather than from the provisioning at boot, must call this
+ *       function so that the cached subkeys are zeroised.
+ */
+void tfm_builtin_key_loader_lcs_changed(void);
+
 /**
  * \brief Returns the length of a key from the builtin driver.
  *
@@ -12,6 +12,7 @@
 extern "C" {
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include "tfm_crypto_defs.h"
 #include "psa/crypto_client_struct.h"
@@ -55,6 +56,77 @@ psa_status_t tfm_crypto_init(void);
  */
 psa_status_t tfm_crypto_init_alloc(void);
 
+/**
+ * \brief Usage statistics of a size class of the slab allocator
+ */
+struct tfm_crypto_slab_stats_t {
+    size_t block_size;      /*!< Size of the blocks of the class */
+    uint32_t carved;        /*!< Blocks currently carved from the engine
+                             *   buffer
+                             */
+    uint32_t in_use;        /*!< Blocks currently allocated */
+    uint32_t max_in_use;    /*!< High water mark of the blocks allocated */
+    uint32_t failed;        /*!< Allocations which found the engine
+                             *   buffer fully carved
+                             */
+};
+
+/**
+ * \brief Initialise the slab allocator used by Mbed Crypto over the engine
+ *        buffer
+ *
+ * \param[in] buf   Engine buffer
+ * \param[in] size  Size of the engine buffer in bytes
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_slab_init(uint8_t *buf, size_t size);
+
+/**
+ * \brief Allocate zeroed memory from the slab allocator, with the semantics
+ *        of calloc()
+ *
+ * \param[in] n     Number of elements
+ * \param[in] size  Size of each element in bytes
+ *
+ * \return Pointer to the memory, or NULL if it cannot be allocated
+ */
+void *tfm_crypto_slab_calloc(size_t n, size_t size);
+
+/**
+ * \brief Release memory allocated by \ref tfm_crypto_slab_calloc
+ *
+ * \param[in] ptr   Pointer to the memory, can be NULL
+ */
+void tfm_crypto_slab_free(void *ptr);
+
+/**
+ * \brief Get the memory used by the slab allocator, headers included
+ *
+ * \param[out] used      Memory currently allocated
+ * \param[out] max_used  Peak of the memory allocated
+ */
+void tfm_crypto_slab_get_usage(size_t *used, size_t *max_used);
+
+/**
+ * \brief Reset the peak values of the slab allocator statistics to the
+ *        current values
+ */
+void tfm_crypto_slab_reset_peaks(void);
+
+/**
+ * \brief Get the usage statistics of a size class of the slab allocator. They
+ *        can be used to size CRYPTO_ENGINE_BUF_SIZE for a given workload.
+ *
+ * \param[in]  class_idx  Index of the size class, from the smallest one
+ * \param[out] stats      Statistics of the class
+ *
+ * \return PSA_ERROR_INVALID_ARGUMENT if there is no such class, or
+ *         PSA_SUCCESS otherwise
+ */
+psa_status_t tfm_crypto_slab_get_stats(uint32_t class_idx,
+                                       struct tfm_crypto_slab_stats_t *stats);
+
 /**
  * \brief Returns the ID of the caller
  *
@@ -248,6 +320,41 @@ psa_status_t tfm_crypto_random_interface(psa_invec in_vec[],
 psa_status_t tfm_crypto_hash_interface(psa_invec in_vec[],
                                        psa_outvec out_vec[]);
 
+/**
+ * \brief This function acts as interface for the Statistics module
+ *
+ * \param[in]  in_vec   Array of invec parameters
+ * \param[out] out_vec  Array of outvec parameters
+ *
+ * \return Return values as described in \ref psa_status_t
+ */
+psa_status_t tfm_crypto_stats_interface(psa_invec in_vec[],
+                                        psa_outvec out_vec[]);
+
+/**
+ * \brief Fill the usage of the multipart operation contexts in the statistics
+ *
+ * \param[out] stats  Statistics of the service
+ */
+void tfm_crypto_operation_stats(struct tfm_crypto_stats *stats);
+
+/**
+ * \brief Reset the peak usage of the multipart operation contexts
+ */
+void tfm_crypto_operation_reset_stats(void);
+
+/**
+ * \brief Fill the usage of the IOVec scratch buffer in the statistics
+ *
+ * \param[out] stats  Statistics of the service
+ */
+void tfm_crypto_scratch_stats(struct tfm_crypto_stats *stats);
+
+/**
+ * \brief Reset the peak usage of the IOVec scratch buffer
+ */
+void tfm_crypto_scratch_reset_stats(void);
+
 #ifdef __cplusplus
 }
 #endif
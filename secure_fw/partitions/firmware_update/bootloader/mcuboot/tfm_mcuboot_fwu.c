@@ -16,11 +16,42 @@
 #include "tfm_bootloader_fwu_abstraction.h"
 #include "tfm_boot_status.h"
 #include "service_api.h"
+#include "config_fwu.h"
+#include "compiler_ext_defs.h"
 
 #if (FWU_COMPONENT_NUMBER != MCUBOOT_IMAGE_NUMBER)
     #error "FWU_COMPONENT_NUMBER mismatch with MCUBOOT_IMAGE_NUMBER"
 #endif
 
+#if (FWU_WRITE_BUF_SIZE % TFM_HAL_FLASH_PROGRAM_UNIT) != 0
+    #error "FWU_WRITE_BUF_SIZE must be a multiple of TFM_HAL_FLASH_PROGRAM_UNIT"
+#endif
+
+#if FWU_DELTA_IMAGE
+/*
+ * Delta image format. All the fields are little-endian.
+ *
+ * The delta image starts with a header:
+ *     uint32_t magic         FWU_DELTA_MAGIC
+ *     uint32_t image_size    Size of the reconstructed image
+ *
+ * followed by commands, each of them made of an opcode byte and arguments:
+ *     FWU_DELTA_CMD_COPY     uint32_t src_off, uint32_t len
+ *         Copy len bytes from src_off in the active image slot.
+ *     FWU_DELTA_CMD_INSERT   uint32_t len, followed by len bytes of data
+ *         Insert the data.
+ *
+ * The commands reconstruct the image from offset 0 on.
+ */
+#define FWU_DELTA_MAGIC             0x544C4446U    /* "FDLT" */
+#define FWU_DELTA_HEADER_SIZE       8
+#define FWU_DELTA_CMD_COPY          0x01U
+#define FWU_DELTA_CMD_COPY_SIZE     9
+#define FWU_DELTA_CMD_INSERT        0x02U
+#define FWU_DELTA_CMD_INSERT_SIZE   5
+#define FWU_DELTA_CMD_MAX_SIZE      FWU_DELTA_CMD_COPY_SIZE
+#endif
+
 #if (MCUBOOT_IMAGE_NUMBER == 1)
 #define MAX_IMAGE_INFO_LENGTH    (sizeof(struct image_version) + \
                                   SHARED_DATA_ENTRY_HEADER_SIZE)
@@ -48,6 +79,66 @@ typedef struct tfm_fwu_mcuboot_ctx_s {
 
     /* The size of the downloaded data in the FWU process. */
     size_t loaded_size;
+
+#if FWU_WRITE_BUF_SIZE > 0
+    /* Sequential data to be programmed from write_buf_off on. The buffer is
+     * programmed when it reaches a FWU_WRITE_BUF_SIZE aligned offset.
+     */
+    uint8_t write_buf[FWU_WRITE_BUF_SIZE] __aligned(4);
+    uint32_t write_buf_off;
+    uint32_t write_buf_len;
+#endif
+
+#if FWU_ERASE_AHEAD_SECTORS > 0
+    /* The staging area is erased up to erased_size, the rest of it is erased
+     * as the image is written, once the data goes beyond erase_next. The
+     * sectors from trailer_off on, which hold the image trailer, are erased
+     * when the staging area is initialized.
+     */
+    uint32_t erased_size;
+    uint32_t erase_next;
+    uint32_t trailer_off;
+#endif
+
+#if FWU_DELTA_IMAGE
+    /* The staging area is reconstructed from a delta image. */
+    bool is_delta;
+
+    /* The flash area of the active image, the source of the copies. */
+    const struct flash_area *fap_src;
+
+    /* Size of the delta image received and of the image it describes. */
+    size_t delta_size;
+    uint32_t delta_image_size;
+
+    /* The command being received, and the data left to insert. */
+    uint8_t delta_cmd[FWU_DELTA_CMD_MAX_SIZE];
+    uint8_t delta_cmd_len;
+    uint32_t delta_insert_len;
+#endif
+
+#if FWU_STREAMING_HASH
+    /* Hash of the downloaded data, updated as the blocks are written. */
+    psa_hash_operation_t hash_op;
+
+    /* The hash covers all the downloaded data written so far, in order. */
+    bool hash_valid;
+
+    /* The digest of the downloaded data has been computed. */
+    bool digest_valid;
+    uint8_t digest[TFM_FWU_MAX_DIGEST_SIZE];
+    size_t digest_size;
+
+    /* The image header, captured from the downloaded data. */
+    struct image_header hdr;
+
+    /* End of the data covered by the image hash TLV, 0 if not known yet. */
+    uint32_t img_hash_end;
+
+    /* The hash of the header, payload and protected TLVs has been computed. */
+    bool img_hash_valid;
+    uint8_t img_hash[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+#endif
 } tfm_fwu_mcuboot_ctx_t;
 
 static tfm_fwu_mcuboot_ctx_t mcuboot_ctx[FWU_COMPONENT_NUMBER];
@@ -60,6 +151,402 @@ static int fwu_bootloader_get_shared_data(void)
                                   sizeof(boot_shared_data));
 }
 
+#if FWU_STREAMING_HASH
+static void stream_hash_reset(tfm_fwu_mcuboot_ctx_t *ctx)
+{
+    if (ctx->hash_valid) {
+        psa_hash_abort(&ctx->hash_op);
+    }
+    ctx->hash_valid = false;
+    ctx->digest_valid = false;
+    ctx->img_hash_end = 0;
+    ctx->img_hash_valid = false;
+}
+
+static void stream_hash_start(tfm_fwu_mcuboot_ctx_t *ctx)
+{
+    stream_hash_reset(ctx);
+
+    ctx->hash_op = psa_hash_operation_init();
+    if (psa_hash_setup(&ctx->hash_op, PSA_ALG_SHA_256) == PSA_SUCCESS) {
+        ctx->hash_valid = true;
+    }
+}
+
+/* Capture the image header and find the end of the data the image hash TLV
+ * covers.
+ */
+static void stream_hash_capture_header(tfm_fwu_mcuboot_ctx_t *ctx,
+                                       size_t block_offset,
+                                       const uint8_t *block,
+                                       size_t block_size)
+{
+    size_t len;
+
+    if (block_offset >= sizeof(ctx->hdr)) {
+        return;
+    }
+
+    len = sizeof(ctx->hdr) - block_offset;
+    if (len > block_size) {
+        len = block_size;
+    }
+    memcpy((uint8_t *)&ctx->hdr + block_offset, block, len);
+
+    if ((block_offset + len == sizeof(ctx->hdr)) &&
+        (ctx->hdr.ih_magic == IMAGE_MAGIC)) {
+        ctx->img_hash_end = ctx->hdr.ih_hdr_size + ctx->hdr.ih_img_size +
+                            ctx->hdr.ih_protect_tlv_size;
+        /* Reject wrapped sizes and headers smaller than the structure. */
+        if ((ctx->img_hash_end < ctx->hdr.ih_img_size) ||
+            (ctx->img_hash_end < sizeof(ctx->hdr))) {
+            ctx->img_hash_end = 0;
+        }
+    }
+}
+
+/* Hash a block of downloaded data once it has been written. Blocks which are
+ * not written in order stop the streaming hash, and the data is read back from
+ * flash instead.
+ */
+static void stream_hash_update(tfm_fwu_mcuboot_ctx_t *ctx,
+                               size_t block_offset,
+                               const void *block,
+                               size_t block_size)
+{
+    psa_hash_operation_t img_hash_op = psa_hash_operation_init();
+    const uint8_t *data = block;
+    size_t hash_size;
+    size_t len;
+
+    if (!ctx->hash_valid) {
+        return;
+    }
+
+    if (ctx->digest_valid || (block_offset != ctx->loaded_size)) {
+        stream_hash_reset(ctx);
+        return;
+    }
+
+    stream_hash_capture_header(ctx, block_offset, data, block_size);
+
+    /* Take the image hash when its last byte is written. */
+    if ((ctx->img_hash_end != 0) && !ctx->img_hash_valid &&
+        (block_offset < ctx->img_hash_end) &&
+        (block_size >= ctx->img_hash_end - block_offset)) {
+        len = ctx->img_hash_end - block_offset;
+        if ((psa_hash_update(&ctx->hash_op, data, len) != PSA_SUCCESS) ||
+            (psa_hash_clone(&ctx->hash_op, &img_hash_op) != PSA_SUCCESS)) {
+            stream_hash_reset(ctx);
+            return;
+        }
+        if (psa_hash_finish(&img_hash_op, ctx->img_hash,
+                            sizeof(ctx->img_hash), &hash_size) == PSA_SUCCESS) {
+            ctx->img_hash_valid = true;
+        }
+        data += len;
+        block_size -= len;
+    }
+
+    if (psa_hash_update(&ctx->hash_op, data, block_size) != PSA_SUCCESS) {
+        stream_hash_reset(ctx);
+    }
+}
+
+/* Get the digest of the downloaded data, if it has been hashed as written. */
+static psa_status_t stream_hash_get_digest(tfm_fwu_mcuboot_ctx_t *ctx,
+                                           uint8_t *digest,
+                                           size_t *digest_size)
+{
+    if (!ctx->digest_valid) {
+        if (!ctx->hash_valid) {
+            return PSA_ERROR_BAD_STATE;
+        }
+
+        /* The operation is terminated whatever the result. */
+        ctx->hash_valid = false;
+        if (psa_hash_finish(&ctx->hash_op, ctx->digest, sizeof(ctx->digest),
+                            &ctx->digest_size) != PSA_SUCCESS) {
+            return PSA_ERROR_BAD_STATE;
+        }
+        ctx->digest_valid = true;
+    }
+
+    memcpy(digest, ctx->digest, ctx->digest_size);
+    *digest_size = ctx->digest_size;
+
+    return PSA_SUCCESS;
+}
+
+#ifndef MCUBOOT_ENC_IMAGES
+/* Check the image hash taken as the image was written against the image hash
+ * TLV, so that a corrupted download is rejected before the reboot.
+ */
+static psa_status_t stream_hash_check_image(tfm_fwu_mcuboot_ctx_t *ctx)
+{
+    struct image_tlv_iter it;
+    uint8_t tlv_hash[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+    uint32_t off;
+    uint16_t len;
+    int rc;
+
+    if (!ctx->img_hash_valid) {
+        /* Not hashed as written, leave the validation to the bootloader. */
+        return PSA_SUCCESS;
+    }
+
+    if (bootutil_tlv_iter_begin(&it, &ctx->hdr, ctx->fap, IMAGE_TLV_SHA256,
+                                false)) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    rc = bootutil_tlv_iter_next(&it, &off, &len, NULL);
+    if (rc < 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    } else if ((rc > 0) || (len != sizeof(tlv_hash))) {
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    if (flash_area_read(ctx->fap, off, tlv_hash, len) != 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    if (memcmp(tlv_hash, ctx->img_hash, len) != 0) {
+        LOG_ERRFMT("TFM FWU: image hash mismatch.\r\n");
+        return PSA_ERROR_DATA_CORRUPT;
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* !MCUBOOT_ENC_IMAGES */
+#endif /* FWU_STREAMING_HASH */
+
+#if FWU_WRITE_BUF_SIZE > 0
+/* Program the buffered data, if any. */
+static psa_status_t write_buf_flush(tfm_fwu_mcuboot_ctx_t *ctx)
+{
+    uint32_t len = ctx->write_buf_len;
+
+    if (len == 0) {
+        return PSA_SUCCESS;
+    }
+
+    ctx->write_buf_len = 0;
+    if (flash_area_write(ctx->fap, ctx->write_buf_off, ctx->write_buf,
+                         len) != 0) {
+        LOG_ERRFMT("TFM FWU: write flash failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* Accumulate the data in the buffer, so that the flash is programmed in
+ * FWU_WRITE_BUF_SIZE aligned chunks whatever the size of the blocks.
+ */
+static psa_status_t write_buf_write(tfm_fwu_mcuboot_ctx_t *ctx, uint32_t off,
+                                    const uint8_t *data, size_t len)
+{
+    psa_status_t status;
+    size_t write_size;
+
+    while (len > 0) {
+        /* Only sequential data is combined. */
+        if ((ctx->write_buf_len != 0) &&
+            (off != ctx->write_buf_off + ctx->write_buf_len)) {
+            status = write_buf_flush(ctx);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+
+        if (ctx->write_buf_len == 0) {
+            /* Aligned chunks need no buffering. */
+            if ((off % FWU_WRITE_BUF_SIZE == 0) &&
+                (len >= FWU_WRITE_BUF_SIZE)) {
+                write_size = len - (len % FWU_WRITE_BUF_SIZE);
+                if (flash_area_write(ctx->fap, off, data, write_size) != 0) {
+                    LOG_ERRFMT("TFM FWU: write flash failed.\r\n");
+                    return PSA_ERROR_STORAGE_FAILURE;
+                }
+                off += write_size;
+                data += write_size;
+                len -= write_size;
+                continue;
+            }
+            ctx->write_buf_off = off;
+        }
+
+        /* Fill the buffer up to the next aligned offset. */
+        write_size = FWU_WRITE_BUF_SIZE -
+                     ((ctx->write_buf_off + ctx->write_buf_len) %
+                      FWU_WRITE_BUF_SIZE);
+        if (write_size > len) {
+            write_size = len;
+        }
+        memcpy(ctx->write_buf + ctx->write_buf_len, data, write_size);
+        ctx->write_buf_len += write_size;
+        off += write_size;
+        data += write_size;
+        len -= write_size;
+
+        if ((ctx->write_buf_off + ctx->write_buf_len) %
+            FWU_WRITE_BUF_SIZE == 0) {
+            status = write_buf_flush(ctx);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* FWU_WRITE_BUF_SIZE > 0 */
+
+#if FWU_ERASE_AHEAD_SECTORS > 0
+/* The sectors of the staging area, read when it is to be erased. The partition
+ * serves one request at a time, so they are shared by the components.
+ */
+static struct flash_sector staging_sectors[BOOT_MAX_IMG_SECTORS];
+
+/* Size of the image trailer, computed as boot_trailer_sz() does in bootutil,
+ * which is not built in the partition.
+ */
+static uint32_t staging_area_trailer_sz(const struct flash_area *fap)
+{
+    return BOOT_STATUS_MAX_ENTRIES * BOOT_STATUS_STATE_COUNT *
+           flash_area_align(fap) +
+#ifdef MCUBOOT_ENC_IMAGES
+#if MCUBOOT_SWAP_SAVE_ENCTLV
+           BOOT_ENC_TLV_ALIGN_SIZE * 2 +
+#else
+           BOOT_ENC_KEY_SIZE * 2 +
+#endif
+#endif
+           /* swap_type + copy_done + image_ok + swap_size */
+           BOOT_MAX_ALIGN * 4 +
+           BOOT_MAGIC_ALIGN_SIZE;
+}
+
+static psa_status_t staging_area_get_sectors(const struct flash_area *fap,
+                                             uint32_t *count)
+{
+    *count = BOOT_MAX_IMG_SECTORS;
+    if ((flash_area_get_sectors(fap->fa_id, count, staging_sectors) != 0) ||
+        (*count == 0)) {
+        LOG_ERRFMT("TFM FWU: getting flash sectors failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* Erase the sectors holding the image trailer, so that the previous content
+ * of the staging area can not be taken as a candidate.
+ */
+static psa_status_t staging_area_erase_trailer(tfm_fwu_mcuboot_ctx_t *ctx,
+                                               const struct flash_area *fap)
+{
+    uint32_t trailer_sz = staging_area_trailer_sz(fap);
+    uint32_t count, i;
+    psa_status_t status;
+
+    if (trailer_sz > fap->fa_size) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    status = staging_area_get_sectors(fap, &count);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Find the sector holding the start of the trailer. */
+    for (i = 0; i < count - 1; i++) {
+        if (staging_sectors[i].fs_off + staging_sectors[i].fs_size >
+            fap->fa_size - trailer_sz) {
+            break;
+        }
+    }
+
+    ctx->erased_size = 0;
+    ctx->erase_next = 0;
+    ctx->trailer_off = staging_sectors[i].fs_off;
+
+    if (flash_area_erase(fap, ctx->trailer_off,
+                         fap->fa_size - ctx->trailer_off) != 0) {
+        LOG_ERRFMT("TFM FWU: erasing flash failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    return PSA_SUCCESS;
+}
+
+/* Erase the sectors holding the data up to end, and FWU_ERASE_AHEAD_SECTORS
+ * sectors further so that the erase overlaps with the download. The sectors
+ * of the image trailer are not erased again.
+ */
+static psa_status_t staging_area_erase(tfm_fwu_mcuboot_ctx_t *ctx,
+                                       uint32_t end)
+{
+    const struct flash_area *fap = ctx->fap;
+    uint32_t count, i, last, erase_end;
+    psa_status_t status;
+
+    if (end <= ctx->erase_next) {
+        return PSA_SUCCESS;
+    }
+
+    status = staging_area_get_sectors(fap, &count);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
+    /* Find the sector holding the end of the data. */
+    for (i = 0; i < count - 1; i++) {
+        if (staging_sectors[i].fs_off + staging_sectors[i].fs_size >= end) {
+            break;
+        }
+    }
+
+    last = (FWU_ERASE_AHEAD_SECTORS > count - 1 - i) ?
+           count - 1 : i + FWU_ERASE_AHEAD_SECTORS;
+    erase_end = staging_sectors[last].fs_off + staging_sectors[last].fs_size;
+    if (erase_end > ctx->trailer_off) {
+        erase_end = ctx->trailer_off;
+    }
+
+    /* The next sectors are erased once the data goes beyond this sector. */
+    ctx->erase_next = staging_sectors[i].fs_off + staging_sectors[i].fs_size;
+    if (ctx->erase_next >= ctx->trailer_off) {
+        ctx->erase_next = fap->fa_size;
+    }
+
+    if (erase_end <= ctx->erased_size) {
+        return PSA_SUCCESS;
+    }
+
+    if (flash_area_erase(fap, ctx->erased_size,
+                         erase_end - ctx->erased_size) != 0) {
+        LOG_ERRFMT("TFM FWU: erasing flash failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+    ctx->erased_size = erase_end;
+
+    return PSA_SUCCESS;
+}
+#endif /* FWU_ERASE_AHEAD_SECTORS > 0 */
+
+#if FWU_DELTA_IMAGE
+static void delta_close(tfm_fwu_mcuboot_ctx_t *ctx)
+{
+    if (ctx->fap_src != NULL) {
+        flash_area_close(ctx->fap_src);
+        ctx->fap_src = NULL;
+    }
+    ctx->is_delta = false;
+}
+#endif
+
 static psa_status_t get_active_image_version(psa_fwu_component_t component,
                                              struct image_version *image_ver)
 {
@@ -123,25 +610,269 @@ psa_status_t fwu_bootloader_staging_area_init(psa_fwu_component_t component,
         return PSA_ERROR_STORAGE_FAILURE;
     }
 
+#if FWU_ERASE_AHEAD_SECTORS > 0
+    /* The staging area is erased as the image is written. Only erase the
+     * sectors holding the image trailer now.
+     */
+    if (staging_area_erase_trailer(&mcuboot_ctx[component],
+                                   fap) != PSA_SUCCESS) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
+#else
     if (flash_area_erase(fap, 0, fap->fa_size) != 0) {
         LOG_ERRFMT("TFM FWU: erasing flash failed.\r\n");
         return PSA_ERROR_GENERIC_ERROR;
     }
+#endif
 
     mcuboot_ctx[component].fap = fap;
 
     /* Reset the loaded_size. */
     mcuboot_ctx[component].loaded_size = 0;
+#if FWU_WRITE_BUF_SIZE > 0
+    mcuboot_ctx[component].write_buf_len = 0;
+#endif
+#if FWU_DELTA_IMAGE
+    delta_close(&mcuboot_ctx[component]);
+#endif
+
+#if FWU_STREAMING_HASH
+    stream_hash_start(&mcuboot_ctx[component]);
+#endif
+
+    return PSA_SUCCESS;
+}
+
+/* Write image data into the staging area. */
+static psa_status_t write_image_data(tfm_fwu_mcuboot_ctx_t *ctx,
+                                     size_t offset,
+                                     const void *data,
+                                     size_t size)
+{
+    const struct flash_area *fap = ctx->fap;
+#if (FWU_WRITE_BUF_SIZE > 0) || (FWU_ERASE_AHEAD_SECTORS > 0)
+    psa_status_t status;
+
+    /* Check the range here as the staging area is erased and programmed on
+     * demand.
+     */
+    if ((offset > fap->fa_size) || (size > fap->fa_size - offset)) {
+        LOG_ERRFMT("TFM FWU: write flash failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+#if FWU_ERASE_AHEAD_SECTORS > 0
+    status = staging_area_erase(ctx, offset + size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+#if FWU_WRITE_BUF_SIZE > 0
+    status = write_buf_write(ctx, offset, data, size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#else
+    if (flash_area_write(fap, offset, data, size) != 0) {
+        LOG_ERRFMT("TFM FWU: write flash failed.\r\n");
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
+#if FWU_STREAMING_HASH
+    stream_hash_update(ctx, offset, data, size);
+#endif
+
+    /* The overflow check has been done in flash_area_write. */
+    ctx->loaded_size += size;
+    return PSA_SUCCESS;
+}
+
+#if FWU_DELTA_IMAGE
+/* Data copied from the active image, kept off the partition stack. */
+static uint8_t delta_copy_buf[BOOT_TMPBUF_SZ];
+
+static uint32_t delta_get_u32(const uint8_t *buf)
+{
+    return (uint32_t)buf[0] | ((uint32_t)buf[1] << 8) |
+           ((uint32_t)buf[2] << 16) | ((uint32_t)buf[3] << 24);
+}
+
+/* Start the reconstruction if the first block is a delta image. */
+static psa_status_t delta_start(tfm_fwu_mcuboot_ctx_t *ctx,
+                                psa_fwu_component_t component,
+                                const uint8_t *block,
+                                size_t block_size)
+{
+    uint8_t magic[4];
+
+    magic[0] = (uint8_t)FWU_DELTA_MAGIC;
+    magic[1] = (uint8_t)(FWU_DELTA_MAGIC >> 8);
+    magic[2] = (uint8_t)(FWU_DELTA_MAGIC >> 16);
+    magic[3] = (uint8_t)(FWU_DELTA_MAGIC >> 24);
+
+    if (memcmp(block, magic,
+               block_size < sizeof(magic) ? block_size : sizeof(magic)) != 0) {
+        return PSA_SUCCESS;
+    }
+
+#if defined(MCUBOOT_DIRECT_XIP) || defined(MCUBOOT_RAM_LOAD) || \
+    defined(MCUBOOT_ENC_IMAGES)
+    /* With DIRECT_XIP and RAM_LOAD, the active image may be in either slot,
+     * so there is no base to copy from. With encrypted images, the primary
+     * slot holds the decrypted image while the staging area expects the
+     * encrypted one.
+     */
+    (void)ctx;
+    (void)component;
+    return PSA_ERROR_NOT_SUPPORTED;
+#else
+    /* The header of a delta image must be written in one block. */
+    if (block_size < FWU_DELTA_HEADER_SIZE) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (flash_area_open(FLASH_AREA_IMAGE_PRIMARY(component),
+                        &ctx->fap_src) != 0) {
+        LOG_ERRFMT("TFM FWU: opening flash failed.\r\n");
+        ctx->fap_src = NULL;
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+
+    ctx->is_delta = true;
+    ctx->delta_size = FWU_DELTA_HEADER_SIZE;
+    ctx->delta_image_size = delta_get_u32(block + 4);
+    ctx->delta_cmd_len = 0;
+    ctx->delta_insert_len = 0;
+
+    return PSA_SUCCESS;
+#endif
+}
+
+/* Copy data from the active image into the staging area. */
+static psa_status_t delta_copy(tfm_fwu_mcuboot_ctx_t *ctx,
+                               uint32_t src_off,
+                               uint32_t len)
+{
+    const struct flash_area *fap_src = ctx->fap_src;
+    uint32_t blk_sz;
+    psa_status_t status;
+
+    if ((src_off > fap_src->fa_size) || (len > fap_src->fa_size - src_off)) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* The data is always copied through RAM, even from a memory-mapped slot,
+     * as the flash may not be read while it is programmed.
+     */
+    while (len > 0) {
+        blk_sz = len < sizeof(delta_copy_buf) ? len : sizeof(delta_copy_buf);
+
+        if (flash_area_read(fap_src, src_off, delta_copy_buf, blk_sz) != 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+        status = write_image_data(ctx, ctx->loaded_size, delta_copy_buf,
+                                  blk_sz);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        src_off += blk_sz;
+        len -= blk_sz;
+    }
 
     return PSA_SUCCESS;
 }
 
+/* Get the size of the command starting with the given opcode. */
+static uint8_t delta_cmd_size(uint8_t opcode)
+{
+    switch (opcode) {
+    case FWU_DELTA_CMD_COPY:
+        return FWU_DELTA_CMD_COPY_SIZE;
+    case FWU_DELTA_CMD_INSERT:
+        return FWU_DELTA_CMD_INSERT_SIZE;
+    default:
+        return 0;
+    }
+}
+
+/* Reconstruct the image from a block of the delta image. */
+static psa_status_t delta_load(tfm_fwu_mcuboot_ctx_t *ctx,
+                               size_t block_offset,
+                               const uint8_t *block,
+                               size_t block_size)
+{
+    psa_status_t status;
+    uint8_t cmd_size;
+    size_t len;
+
+    /* The commands can only be applied in order. */
+    if (block_offset != ctx->delta_size) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+    ctx->delta_size += block_size;
+
+    while (block_size > 0) {
+        if (ctx->delta_insert_len > 0) {
+            len = block_size < ctx->delta_insert_len ?
+                  block_size : ctx->delta_insert_len;
+            status = write_image_data(ctx, ctx->loaded_size, block, len);
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+            ctx->delta_insert_len -= len;
+            block += len;
+            block_size -= len;
+            continue;
+        }
+
+        /* Gather the command, which can span several blocks. */
+        cmd_size = ctx->delta_cmd_len == 0 ? 1 :
+                   delta_cmd_size(ctx->delta_cmd[0]);
+        if (cmd_size == 0) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        len = cmd_size - ctx->delta_cmd_len;
+        if (len > block_size) {
+            len = block_size;
+        }
+        memcpy(ctx->delta_cmd + ctx->delta_cmd_len, block, len);
+        ctx->delta_cmd_len += len;
+        block += len;
+        block_size -= len;
+
+        if ((ctx->delta_cmd_len == 1) ||
+            (ctx->delta_cmd_len < delta_cmd_size(ctx->delta_cmd[0]))) {
+            continue;
+        }
+
+        ctx->delta_cmd_len = 0;
+        if (ctx->delta_cmd[0] == FWU_DELTA_CMD_COPY) {
+            status = delta_copy(ctx, delta_get_u32(&ctx->delta_cmd[1]),
+                                delta_get_u32(&ctx->delta_cmd[5]));
+            if (status != PSA_SUCCESS) {
+                return status;
+            }
+        } else {
+            ctx->delta_insert_len = delta_get_u32(&ctx->delta_cmd[1]);
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* FWU_DELTA_IMAGE */
+
 psa_status_t fwu_bootloader_load_image(psa_fwu_component_t component,
                                        size_t block_offset,
                                        const void *block,
                                        size_t block_size)
 {
-    const struct flash_area *fap;
+    tfm_fwu_mcuboot_ctx_t *ctx;
+#if FWU_DELTA_IMAGE
+    psa_status_t status;
+#endif
 
     if (block == NULL || component >= FWU_COMPONENT_NUMBER) {
         return PSA_ERROR_INVALID_ARGUMENT;
@@ -149,18 +880,78 @@ psa_status_t fwu_bootloader_load_image(psa_fwu_component_t component,
 
     /* The component should already be added into the mcuboot_ctx. */
     if (mcuboot_ctx[component].fap != NULL) {
-        fap = mcuboot_ctx[component].fap;
+        ctx = &mcuboot_ctx[component];
     } else {
         return PSA_ERROR_BAD_STATE;
     }
 
-    if (flash_area_write(fap, block_offset, block, block_size) != 0) {
-        LOG_ERRFMT("TFM FWU: write flash failed.\r\n");
-        return PSA_ERROR_STORAGE_FAILURE;
+#if FWU_DELTA_IMAGE
+    if ((block_offset == 0) && (ctx->loaded_size == 0) && !ctx->is_delta) {
+        status = delta_start(ctx, component, block, block_size);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+        if (ctx->is_delta) {
+            return delta_load(ctx, FWU_DELTA_HEADER_SIZE,
+                              (const uint8_t *)block + FWU_DELTA_HEADER_SIZE,
+                              block_size - FWU_DELTA_HEADER_SIZE);
+        }
     }
 
-    /* The overflow check has been done in flash_area_write. */
-    mcuboot_ctx[component].loaded_size += block_size;
+    if (ctx->is_delta) {
+        return delta_load(ctx, block_offset, block, block_size);
+    }
+#endif
+
+    return write_image_data(ctx, block_offset, block, block_size);
+}
+
+psa_status_t fwu_bootloader_finish_image(psa_fwu_component_t component)
+{
+#if (FWU_WRITE_BUF_SIZE > 0) || (FWU_ERASE_AHEAD_SECTORS > 0)
+    psa_status_t status;
+#endif
+
+    if (component >= FWU_COMPONENT_NUMBER) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* The component should already be added into the mcuboot_ctx. */
+    if (mcuboot_ctx[component].fap == NULL) {
+        return PSA_ERROR_BAD_STATE;
+    }
+
+#if FWU_DELTA_IMAGE
+    if (mcuboot_ctx[component].is_delta) {
+        /* The delta image must describe the whole image. */
+        if ((mcuboot_ctx[component].delta_cmd_len != 0) ||
+            (mcuboot_ctx[component].delta_insert_len != 0) ||
+            (mcuboot_ctx[component].loaded_size !=
+             mcuboot_ctx[component].delta_image_size)) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        delta_close(&mcuboot_ctx[component]);
+    }
+#endif
+
+#if FWU_WRITE_BUF_SIZE > 0
+    status = write_buf_flush(&mcuboot_ctx[component]);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
+#if FWU_ERASE_AHEAD_SECTORS > 0
+    /* Make sure that the sectors holding the image are erased. The rest of
+     * the staging area is not read by the bootloader, so it is left as it is.
+     */
+    status = staging_area_erase(&mcuboot_ctx[component],
+                                mcuboot_ctx[component].loaded_size);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+#endif
+
     return PSA_SUCCESS;
 }
 
@@ -202,6 +993,9 @@ static bool is_version_greater_or_equal(const struct image_version *image_ver_1,
 psa_status_t fwu_bootloader_install_image(const psa_fwu_component_t *candidates, uint8_t number)
 {
     uint8_t index_i, cand_index;
+#if FWU_STREAMING_HASH && !defined(MCUBOOT_ENC_IMAGES)
+    psa_status_t status;
+#endif
 #if (MCUBOOT_IMAGE_NUMBER > 1)
     psa_fwu_component_t component;
     const struct flash_area *fap;
@@ -221,6 +1015,21 @@ psa_status_t fwu_bootloader_install_image(const psa_fwu_component_t *candidates,
         return PSA_ERROR_INVALID_ARGUMENT;
     }
 
+#if FWU_STREAMING_HASH && !defined(MCUBOOT_ENC_IMAGES)
+    for (cand_index = 0; cand_index < number; cand_index++) {
+        if (candidates[cand_index] >= FWU_COMPONENT_NUMBER) {
+            return PSA_ERROR_INVALID_ARGUMENT;
+        }
+        if (mcuboot_ctx[candidates[cand_index]].fap == NULL) {
+            continue;
+        }
+        status = stream_hash_check_image(&mcuboot_ctx[candidates[cand_index]]);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+#endif
+
 #if (MCUBOOT_IMAGE_NUMBER > 1)
     for (cand_index = 0; cand_index < number; cand_index++) {
         component = candidates[cand_index];
@@ -497,12 +1306,53 @@ psa_status_t fwu_bootloader_abort(psa_fwu_component_t component)
 
     flash_area_erase(fap, 0, fap->fa_size);
     flash_area_close(fap);
+#if FWU_WRITE_BUF_SIZE > 0
+    /* The buffered data is dropped with the image. */
+    mcuboot_ctx[component].write_buf_len = 0;
+#endif
+#if FWU_DELTA_IMAGE
+    delta_close(&mcuboot_ctx[component]);
+#endif
+#if FWU_STREAMING_HASH
+    stream_hash_reset(&mcuboot_ctx[component]);
+#endif
     mcuboot_ctx[component].fap = NULL;
     mcuboot_ctx[component].loaded_size = 0;
     return PSA_SUCCESS;
 }
 
 
+#ifdef BL2_FLASH_MEMORY_MAPPED
+/* Size of the blocks hashed in place when the flash is memory-mapped */
+#ifndef FWU_MAPPED_HASH_BLOCK_SIZE
+#define FWU_MAPPED_HASH_BLOCK_SIZE    0x10000
+#endif
+
+/* Hash a memory-mapped image in place, without copying it to the stack. */
+static psa_status_t util_img_hash_mapped(psa_hash_operation_t *handle,
+                                         const uint8_t *data,
+                                         size_t data_size)
+{
+    psa_status_t status;
+    uint32_t blk_sz;
+    uint32_t off;
+
+    for (off = 0; off < data_size; off += blk_sz) {
+        blk_sz = data_size - off;
+        if (blk_sz > FWU_MAPPED_HASH_BLOCK_SIZE) {
+            blk_sz = FWU_MAPPED_HASH_BLOCK_SIZE;
+        }
+
+        status = psa_hash_update(handle, data + off, blk_sz);
+        if (status != PSA_SUCCESS) {
+            return status;
+        }
+    }
+
+    return PSA_SUCCESS;
+}
+#endif /* BL2_FLASH_MEMORY_MAPPED */
+
 static psa_status_t util_img_hash(const struct flash_area *fap,
                                  size_t data_size,
                                  uint8_t *hash_result,
@@ -515,6 +1365,9 @@ static psa_status_t util_img_hash(const struct flash_area *fap,
     uint32_t tmp_buf_sz = BOOT_TMPBUF_SZ;
     uint32_t blk_sz;
     uint32_t off;
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    const void *mapped_data;
+#endif
 
     /* Setup the hash object for the desired hash. */
     status = psa_hash_setup(&handle, PSA_ALG_SHA_256);
@@ -522,6 +1375,18 @@ static psa_status_t util_img_hash(const struct flash_area *fap,
         return status;
     }
 
+#ifdef BL2_FLASH_MEMORY_MAPPED
+    if (flash_area_get_mapped_ptr(fap, 0, data_size, &mapped_data) == 0) {
+        status = util_img_hash_mapped(&handle, mapped_data, data_size);
+        if (status != PSA_SUCCESS) {
+            psa_hash_abort(&handle);
+            return status;
+        }
+
+        return psa_hash_finish(&handle, hash_result, buf_size, hash_size);
+    }
+#endif
+
     for (off = 0; off < data_size; off += blk_sz) {
         blk_sz = data_size - off;
         if (blk_sz > tmp_buf_sz) {
@@ -529,10 +1394,12 @@ static psa_status_t util_img_hash(const struct flash_area *fap,
         }
 
         if (flash_area_read(fap, off, tmpbuf, blk_sz)) {
+            psa_hash_abort(&handle);
             return PSA_ERROR_STORAGE_FAILURE;
         }
         status = psa_hash_update(&handle, tmpbuf, blk_sz);
         if (status != PSA_SUCCESS) {
+            psa_hash_abort(&handle);
             return status;
         }
     }
@@ -562,6 +1429,22 @@ static psa_status_t get_second_image_digest(psa_fwu_component_t component,
     } else {
         return PSA_ERROR_INVALID_ARGUMENT;
     }
+
+#if FWU_STREAMING_HASH
+    if (stream_hash_get_digest(&mcuboot_ctx[component], hash,
+                               &hash_size) == PSA_SUCCESS) {
+        memcpy(info->impl.candidate_digest, hash, hash_size);
+        return PSA_SUCCESS;
+    }
+#endif
+
+#if FWU_WRITE_BUF_SIZE > 0
+    /* The digest is calculated on the data read back from flash. */
+    if (write_buf_flush(&mcuboot_ctx[component]) != PSA_SUCCESS) {
+        return PSA_ERROR_STORAGE_FAILURE;
+    }
+#endif
+
     if ((flash_area_open(FLASH_AREA_IMAGE_SECONDARY(component),
                             &fap)) != 0) {
         LOG_ERRFMT("TFM FWU: opening flash failed.\r\n");
@@ -666,6 +1549,15 @@ psa_status_t fwu_bootloader_clean_component(psa_fwu_component_t component)
         if (flash_area_erase(fap, 0, fap->fa_size) != 0) {
             return PSA_ERROR_STORAGE_FAILURE;
         }
+#if FWU_WRITE_BUF_SIZE > 0
+        mcuboot_ctx[component].write_buf_len = 0;
+#endif
+#if FWU_DELTA_IMAGE
+        delta_close(&mcuboot_ctx[component]);
+#endif
+#if FWU_STREAMING_HASH
+        stream_hash_reset(&mcuboot_ctx[component]);
+#endif
         mcuboot_ctx[component].fap = NULL;
     } else {
         return PSA_ERROR_DOES_NOT_EXIST;
@@ -79,6 +79,21 @@ psa_status_t fwu_bootloader_load_image(psa_fwu_component_t component,
                                        const void *block,
                                        size_t block_size);
 
+/**
+ * \brief Complete the load of the image into the target component.
+ *
+ * The component is in WRITING state and all the image data has been passed to
+ * \ref fwu_bootloader_load_image. Program the data which is still buffered
+ * into the staging area.
+ *
+ * \param[in] component The identifier of the target component in bootloader.
+ *
+ * \return PSA_SUCCESS                     On success
+ *         PSA_ERROR_INVALID_ARGUMENT      Invalid input parameter
+ *         PSA_ERROR_STORAGE_FAILURE       The data could not be programmed
+ */
+psa_status_t fwu_bootloader_finish_image(psa_fwu_component_t component);
+
 /**
  * \brief Starts the installation of an image.
  *
@@ -22,4 +22,28 @@
 #define FWU_STACK_SIZE                 0x600
 #endif
 
+/* Hash the image as it is written, instead of reading it back from flash */
+#ifndef FWU_STREAMING_HASH
+#pragma message("FWU_STREAMING_HASH is defaulted to 1. Please check and set it explicitly.")
+#define FWU_STREAMING_HASH             1
+#endif
+
+/* Size of the buffer combining the writes to the staging area, 0 to disable */
+#ifndef FWU_WRITE_BUF_SIZE
+#pragma message("FWU_WRITE_BUF_SIZE is defaulted to 0x400. Please check and set it explicitly.")
+#define FWU_WRITE_BUF_SIZE             0x400
+#endif
+
+/* Accept delta images, reconstructed from the active image */
+#ifndef FWU_DELTA_IMAGE
+#pragma message("FWU_DELTA_IMAGE is defaulted to 0. Please check and set it explicitly.")
+#define FWU_DELTA_IMAGE                0
+#endif
+
+/* Sectors of the staging area erased ahead of the writes, 0 to erase it at start */
+#ifndef FWU_ERASE_AHEAD_SECTORS
+#pragma message("FWU_ERASE_AHEAD_SECTORS is defaulted to 1. Please check and set it explicitly.")
+#define FWU_ERASE_AHEAD_SECTORS        1
+#endif
+
 #endif /* __CONFIG_PARTITION_FWU_H__ */
@@ -167,6 +167,7 @@ static psa_status_t tfm_fwu_write(const psa_msg_t *msg)
 static psa_status_t tfm_fwu_finish(const psa_msg_t *msg)
 {
     psa_fwu_component_t component;
+    psa_status_t status;
 
     /* Check input parameters. */
     if (msg->in_size[0] != sizeof(component)) {
@@ -183,6 +184,12 @@ static psa_status_t tfm_fwu_finish(const psa_msg_t *msg)
         return PSA_ERROR_BAD_STATE;
     }
 
+    /* Program the image data which is still buffered. */
+    status = fwu_bootloader_finish_image(component);
+    if (status != PSA_SUCCESS) {
+        return status;
+    }
+
     /* Validity, authenticity and integrity of the image is deferred to system
      * reboot.
      */
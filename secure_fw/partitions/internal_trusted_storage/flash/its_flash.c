@@ -20,15 +20,18 @@ uint8_t its_block_data[ITS_RAM_FS_SIZE];
 #ifndef ITS_FLASH_NAND_BUF_SIZE
 #error "ITS_FLASH_NAND_BUF_SIZE must be defined by the target in flash_layout.h"
 #endif
-static uint8_t its_write_buf_0[ITS_FLASH_NAND_BUF_SIZE];
-static uint8_t its_write_buf_1[ITS_FLASH_NAND_BUF_SIZE];
+#ifndef ITS_FLASH_NAND_BUF_NUM
+#define ITS_FLASH_NAND_BUF_NUM 2
+#endif
+static uint8_t its_nand_buf_data[ITS_FLASH_NAND_BUF_NUM]
+                                [ITS_FLASH_NAND_BUF_SIZE];
+static struct its_flash_nand_buf_t its_nand_bufs[ITS_FLASH_NAND_BUF_NUM];
 struct its_flash_nand_dev_t its_flash_nand_dev = {
     .driver = &TFM_HAL_ITS_FLASH_DRIVER,
-    .buf_block_id_0 = ITS_BLOCK_INVALID_ID,
-    .buf_block_id_1 = ITS_BLOCK_INVALID_ID,
-    .write_buf_0 = its_write_buf_0,
-    .write_buf_1 = its_write_buf_1,
-    .buf_size = sizeof(its_write_buf_0),
+    .bufs = its_nand_bufs,
+    .buf_num = ITS_FLASH_NAND_BUF_NUM,
+    .buf_data = &its_nand_buf_data[0][0],
+    .buf_size = ITS_FLASH_NAND_BUF_SIZE,
 };
 #endif
 
@@ -43,15 +46,18 @@ uint8_t ps_block_data[PS_RAM_FS_SIZE];
 #ifndef PS_FLASH_NAND_BUF_SIZE
 #error "PS_FLASH_NAND_BUF_SIZE must be defined by the target in flash_layout.h"
 #endif
-static uint8_t ps_write_buf_0[PS_FLASH_NAND_BUF_SIZE];
-static uint8_t ps_write_buf_1[PS_FLASH_NAND_BUF_SIZE];
+#ifndef PS_FLASH_NAND_BUF_NUM
+#define PS_FLASH_NAND_BUF_NUM 2
+#endif
+static uint8_t ps_nand_buf_data[PS_FLASH_NAND_BUF_NUM]
+                               [PS_FLASH_NAND_BUF_SIZE];
+static struct its_flash_nand_buf_t ps_nand_bufs[PS_FLASH_NAND_BUF_NUM];
 struct its_flash_nand_dev_t ps_flash_nand_dev = {
     .driver = &TFM_HAL_PS_FLASH_DRIVER,
-    .buf_block_id_0 = ITS_BLOCK_INVALID_ID,
-    .buf_block_id_1 = ITS_BLOCK_INVALID_ID,
-    .write_buf_0 = ps_write_buf_0,
-    .write_buf_1 = ps_write_buf_1,
-    .buf_size = sizeof(ps_write_buf_0),
+    .bufs = ps_nand_bufs,
+    .buf_num = PS_FLASH_NAND_BUF_NUM,
+    .buf_data = &ps_nand_buf_data[0][0],
+    .buf_size = PS_FLASH_NAND_BUF_SIZE,
 };
 #endif
 #endif /* TFM_PARTITION_PROTECTED_STORAGE */
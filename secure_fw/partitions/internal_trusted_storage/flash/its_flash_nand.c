@@ -33,13 +33,169 @@ static uint32_t get_phys_address(const struct its_flash_fs_config_t *cfg,
     return cfg->flash_area_addr + (block_id * cfg->block_size) + offset;
 }
 
+/**
+ * \brief Finds the buffer holding the given block.
+ *
+ * \param[in] flash_dev  NAND flash device
+ * \param[in] block_id   Block ID
+ *
+ * \return Returns the buffer, or NULL if the block is not buffered.
+ */
+static struct its_flash_nand_buf_t *nand_buf_find(
+                                    struct its_flash_nand_dev_t *flash_dev,
+                                    uint32_t block_id)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < flash_dev->buf_num; idx++) {
+        if (flash_dev->bufs[idx].block_id == block_id) {
+            return &flash_dev->bufs[idx];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Gets a buffer for a block which is not buffered yet. An unused
+ *        buffer is taken first, otherwise the least recently used buffer
+ *        without pending writes is evicted.
+ *
+ * \param[in] flash_dev  NAND flash device
+ *
+ * \return Returns the buffer, or NULL if all the buffers hold pending writes.
+ */
+static struct its_flash_nand_buf_t *nand_buf_alloc(
+                                    struct its_flash_nand_dev_t *flash_dev)
+{
+    struct its_flash_nand_buf_t *victim = NULL;
+    struct its_flash_nand_buf_t *buf;
+    uint32_t idx;
+
+    for (idx = 0; idx < flash_dev->buf_num; idx++) {
+        buf = &flash_dev->bufs[idx];
+
+        if (buf->block_id == ITS_BLOCK_INVALID_ID) {
+            return buf;
+        }
+
+        /* Ages are compared so that the use stamp can wrap around */
+        if (!buf->dirty &&
+            (victim == NULL ||
+             (flash_dev->use_count - buf->last_use) >
+             (flash_dev->use_count - victim->last_use))) {
+            victim = buf;
+        }
+    }
+
+    if (victim != NULL) {
+        victim->block_id = ITS_BLOCK_INVALID_ID;
+    }
+
+    return victim;
+}
+
+static void nand_buf_touch(struct its_flash_nand_dev_t *flash_dev,
+                           struct its_flash_nand_buf_t *buf)
+{
+    buf->last_use = ++flash_dev->use_count;
+}
+
+/**
+ * \brief Reads data from the flash device, handling the unaligned head and
+ *        tail of the range.
+ *
+ * \param[in]  cfg       Flash FS configuration
+ * \param[in]  block_id  Block ID
+ * \param[out] buff      Buffer pointer to store the data read
+ * \param[in]  offset    Offset position from the init of the block
+ * \param[in]  size      Number of bytes to read
+ *
+ * \return Returns error code as specified in \ref psa_status_t
+ */
+static psa_status_t nand_read_flash(const struct its_flash_fs_config_t *cfg,
+                                    uint32_t block_id, uint8_t *buff,
+                                    size_t offset, size_t size)
+{
+    struct its_flash_nand_dev_t *flash_dev =
+        (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    uint32_t addr;
+    uint32_t remaining_len, read_length = 0;
+    uint32_t aligned_addr;
+    uint32_t item_number;
+    uint8_t data_width = flash_dev->data_width;
+
+    /* The max size of flash data_width is 4 bytes. */
+    uint8_t temp_buffer[sizeof(uint32_t)];
+    int ret;
+
+    addr = get_phys_address(cfg, block_id, offset);
+    remaining_len = size;
+
+    /*
+     * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
+     * aligned. Data type size is specified by the data_width in
+     * ARM_FLASH_CAPABILITIES.
+     */
+    aligned_addr = (addr / data_width) * data_width;
+
+    /* Read the first data_width bytes data if `addr` is not aligned. */
+    if (aligned_addr != addr) {
+        ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+
+        /* Record how many target data have been read. */
+        read_length = ((addr - aligned_addr + size >= data_width) ?
+                            (data_width - (addr - aligned_addr)) : size);
+        /* Copy the read data. */
+        memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
+        remaining_len -= read_length;
+    }
+
+    /*
+     * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
+     * data items to read.
+     */
+    if (remaining_len) {
+        item_number = remaining_len / data_width;
+        if (item_number) {
+            ret = flash_dev->driver->ReadData(addr + read_length,
+                                              (uint8_t *)buff + read_length,
+                                              item_number);
+            if (ret < 0) {
+                return PSA_ERROR_STORAGE_FAILURE;
+            }
+            read_length += item_number * data_width;
+            remaining_len -= item_number * data_width;
+        }
+    }
+
+    /* Read the last data item if there is still remaing data. */
+    if (remaining_len) {
+        ret = flash_dev->driver->ReadData(addr + read_length,
+                                          temp_buffer, 1);
+        if (ret < 0) {
+            return PSA_ERROR_STORAGE_FAILURE;
+        }
+        /* Copy the read data. */
+        memcpy(buff + read_length, temp_buffer, remaining_len);
+    }
+
+    return PSA_SUCCESS;
+}
+
 static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
 {
     int32_t err;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    ARM_FLASH_CAPABILITIES DriverCapabilities;
+    uint32_t idx;
 
-    if (flash_dev->buf_size < cfg->block_size) {
+    /* The metadata block and the file block can be written at the same time */
+    if (flash_dev->buf_size < cfg->block_size || flash_dev->buf_num < 2) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
@@ -48,6 +204,18 @@ static psa_status_t its_flash_nand_init(const struct its_flash_fs_config_t *cfg)
         return PSA_ERROR_STORAGE_FAILURE;
     }
 
+    DriverCapabilities = flash_dev->driver->GetCapabilities();
+    flash_dev->data_width = data_width_byte[DriverCapabilities.data_width];
+
+    for (idx = 0; idx < flash_dev->buf_num; idx++) {
+        flash_dev->bufs[idx].data = flash_dev->buf_data +
+                                    (idx * flash_dev->buf_size);
+        flash_dev->bufs[idx].block_id = ITS_BLOCK_INVALID_ID;
+        flash_dev->bufs[idx].last_use = 0;
+        flash_dev->bufs[idx].dirty = false;
+    }
+    flash_dev->use_count = 0;
+
     return PSA_SUCCESS;
 }
 
@@ -57,83 +225,43 @@ static psa_status_t its_flash_nand_read(const struct its_flash_fs_config_t *cfg,
 {
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
-    uint32_t addr;
-    uint32_t remaining_len, read_length = 0;
-    uint32_t aligned_addr;
-    uint32_t item_number;
-
-    /* The max size of flash data_width is 4 bytes. */
-    uint8_t temp_buffer[sizeof(uint32_t)];
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
-    uint8_t data_width;
-    int ret;
+    struct its_flash_nand_buf_t *buf;
+    psa_status_t err;
 
     if (block_id == ITS_BLOCK_INVALID_ID) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(buff, flash_dev->write_buf_0 + offset, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(buff, flash_dev->write_buf_1 + offset, size);
-    } else {
-        addr = get_phys_address(cfg, block_id, offset);
-        remaining_len = size;
-        DriverCapabilities = flash_dev->driver->GetCapabilities();
-        data_width = data_width_byte[DriverCapabilities.data_width];
-
-        /*
-         * CMSIS ARM_FLASH_ReadData API requires the `addr` data type size
-         * aligned. Data type size is specified by the data_width in
-         * ARM_FLASH_CAPABILITIES.
+    buf = nand_buf_find(flash_dev, block_id);
+    if (buf == NULL) {
+        /* The metadata blocks are read in small pieces several times per
+         * request, so read them whole into a buffer without pending writes
+         * and serve the following reads from RAM. The other blocks, and the
+         * metadata blocks when all the buffers hold pending writes, are read
+         * directly from flash for the requested range only.
          */
-        aligned_addr = (addr / data_width) * data_width;
-
-        /* Read the first data_width bytes data if `addr` is not aligned. */
-        if (aligned_addr != addr) {
-            ret = flash_dev->driver->ReadData(aligned_addr, temp_buffer, 1);
-            if (ret < 0) {
-                return PSA_ERROR_STORAGE_FAILURE;
-            }
-
-            /* Record how many target data have been read. */
-            read_length = ((addr - aligned_addr + size >= data_width) ?
-                                (data_width - (addr - aligned_addr)) : size);
-            /* Copy the read data. */
-            memcpy(buff, temp_buffer + addr - aligned_addr, read_length);
-            remaining_len -= read_length;
+        if ((block_id != ITS_METADATA_BLOCK0) &&
+            (block_id != ITS_METADATA_BLOCK1)) {
+            return nand_read_flash(cfg, block_id, buff, offset, size);
         }
 
-        /*
-         * The `cnt` parameter in CMSIS ARM_FLASH_ReadData indicates number of
-         * data items to read.
-         */
-        if (remaining_len) {
-            item_number = remaining_len / data_width;
-            if (item_number) {
-                ret = flash_dev->driver->ReadData(addr + read_length,
-                                                  (uint8_t *)buff + read_length,
-                                                  item_number);
-                if (ret < 0) {
-                    return PSA_ERROR_STORAGE_FAILURE;
-                }
-                read_length += item_number * data_width;
-                remaining_len -= item_number * data_width;
-            }
+        buf = nand_buf_alloc(flash_dev);
+        if (buf == NULL) {
+            return nand_read_flash(cfg, block_id, buff, offset, size);
         }
 
-        /* Read the last data item if there is still remaing data. */
-        if (remaining_len) {
-            ret = flash_dev->driver->ReadData(addr + read_length,
-                                              temp_buffer, 1);
-            if (ret < 0) {
-                return PSA_ERROR_STORAGE_FAILURE;
-            }
-            /* Copy the read data. */
-            memcpy(buff + read_length, temp_buffer, remaining_len);
+        err = nand_read_flash(cfg, block_id, buf->data, 0, cfg->block_size);
+        if (err != PSA_SUCCESS) {
+            return err;
         }
+
+        buf->block_id = block_id;
+        buf->dirty = false;
     }
 
+    nand_buf_touch(flash_dev, buf);
+    (void)memcpy(buff, buf->data + offset, size);
+
     return PSA_SUCCESS;
 }
 
@@ -144,28 +272,34 @@ static psa_status_t its_flash_nand_write(
 {
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_buf_t *buf;
 
     if (block_id == ITS_BLOCK_INVALID_ID) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    /* Write to the match block buffer if exists. Otherwise use the empty
-     * buffer if exists. If no more empty buffer, return error.
+    /* Write to the match block buffer if it holds pending writes. Otherwise
+     * start a new write buffer, evicting a cached block if needed. If all
+     * the buffers hold pending writes, return error.
      */
-    if (block_id == flash_dev->buf_block_id_0) {
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_0 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_0 = block_id;
-        (void)memcpy(flash_dev->write_buf_0 + offset, buff, size);
-    } else if (flash_dev->buf_block_id_1 == ITS_BLOCK_INVALID_ID) {
-        flash_dev->buf_block_id_1 = block_id;
-        (void)memcpy(flash_dev->write_buf_1 + offset, buff, size);
-    } else {
-        return PSA_ERROR_PROGRAMMER_ERROR;
+    buf = nand_buf_find(flash_dev, block_id);
+    if (buf == NULL || !buf->dirty) {
+        if (buf == NULL) {
+            buf = nand_buf_alloc(flash_dev);
+            if (buf == NULL) {
+                return PSA_ERROR_PROGRAMMER_ERROR;
+            }
+        }
+
+        /* The block is programmed as a whole, from a cleared buffer */
+        (void)memset(buf->data, 0, flash_dev->buf_size);
+        buf->block_id = block_id;
+        buf->dirty = true;
     }
 
+    nand_buf_touch(flash_dev, buf);
+    (void)memcpy(buf->data + offset, buff, size);
+
     return PSA_SUCCESS;
 }
 
@@ -176,45 +310,30 @@ static psa_status_t its_flash_nand_flush(
     int32_t err;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_buf_t *buf;
     uint32_t addr;
-    ARM_FLASH_CAPABILITIES DriverCapabilities;
-    uint8_t data_width;
-
-    DriverCapabilities = flash_dev->driver->GetCapabilities();
-    data_width = data_width_byte[DriverCapabilities.data_width];
-    if (block_id == flash_dev->buf_block_id_0) {
-        addr = get_phys_address(cfg, flash_dev->buf_block_id_0, 0);
 
-        /*
-         * Flush the buffered write data to flash. For NAND flash,
-         * cfg->block_size should always be a multiplier of data_width.
-         */
-        err = flash_dev->driver->ProgramData(addr, flash_dev->write_buf_0,
-                                             cfg->block_size / data_width);
-        if (err < 0) {
-            return PSA_ERROR_STORAGE_FAILURE;
-        }
+    buf = nand_buf_find(flash_dev, block_id);
+    if (buf == NULL || !buf->dirty) {
+        return PSA_ERROR_GENERIC_ERROR;
+    }
 
-        /* Clear the write buffer */
-        (void)memset(flash_dev->write_buf_0, 0, flash_dev->buf_size);
-        flash_dev->buf_block_id_0 = ITS_BLOCK_INVALID_ID;
-    } else if (block_id == flash_dev->buf_block_id_1) {
-        addr = get_phys_address(cfg, flash_dev->buf_block_id_1, 0);
+    addr = get_phys_address(cfg, block_id, 0);
 
-        /* Flush the buffered write data to flash*/
-        err = flash_dev->driver->ProgramData(addr, flash_dev->write_buf_1,
-                                             cfg->block_size / data_width);
-        if (err < 0) {
-            return PSA_ERROR_STORAGE_FAILURE;
-        }
-
-        /* Clear the write buffer */
-        (void)memset(flash_dev->write_buf_1, 0, flash_dev->buf_size);
-        flash_dev->buf_block_id_1 = ITS_BLOCK_INVALID_ID;
-    } else {
-        return PSA_ERROR_GENERIC_ERROR;
+    /*
+     * Flush the buffered write data to flash. For NAND flash,
+     * cfg->block_size should always be a multiplier of data_width.
+     */
+    err = flash_dev->driver->ProgramData(addr, buf->data,
+                                         cfg->block_size /
+                                         flash_dev->data_width);
+    if (err < 0) {
+        return PSA_ERROR_STORAGE_FAILURE;
     }
 
+    /* The buffer now matches the flash content, keep it as a cached block */
+    buf->dirty = false;
+
     return PSA_SUCCESS;
 }
 
@@ -226,6 +345,13 @@ static psa_status_t its_flash_nand_erase(const struct its_flash_fs_config_t *cfg
     size_t offset;
     struct its_flash_nand_dev_t *flash_dev =
         (struct its_flash_nand_dev_t *)cfg->flash_dev;
+    struct its_flash_nand_buf_t *buf;
+
+    /* Drop the cached copy of the block, pending writes are kept */
+    buf = nand_buf_find(flash_dev, block_id);
+    if (buf != NULL && !buf->dirty) {
+        buf->block_id = ITS_BLOCK_INVALID_ID;
+    }
 
     for (offset = 0; offset < cfg->block_size; offset += cfg->sector_size) {
         addr = get_phys_address(cfg, block_id, offset);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -15,6 +15,7 @@
 #ifndef __ITS_FLASH_NAND_H__
 #define __ITS_FLASH_NAND_H__
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 
@@ -24,16 +25,28 @@
 extern "C" {
 #endif
 
+/* A block buffer of the NAND flash device */
+struct its_flash_nand_buf_t {
+    uint8_t *data;              /* Set by init, from the device buf_data  */
+    uint32_t block_id;          /* Cached block, or ITS_BLOCK_INVALID_ID  */
+    uint32_t last_use;          /* Use stamp for the LRU replacement      */
+    bool dirty;                 /* Holds writes not flushed to flash yet  */
+};
+
 struct its_flash_nand_dev_t {
     ARM_DRIVER_FLASH *driver;
-    /* Two write buffers are reserved as the metadata block and the file block
-     * write can be mixed in the file system operation.
+    /* Block buffers. Writes are buffered until the block is flushed, so at
+     * least two are needed as the metadata block and the file block write
+     * can be mixed in the file system operation. Buffers which hold no
+     * pending writes keep the blocks flushed and cache the metadata blocks
+     * read, and are reused in least recently used order.
      */
-    uint32_t buf_block_id_0;
-    uint32_t buf_block_id_1;
-    uint8_t *write_buf_0;
-    uint8_t *write_buf_1;
+    struct its_flash_nand_buf_t *bufs;
+    uint32_t buf_num;
+    uint8_t *buf_data;          /* buf_num buffers of buf_size bytes      */
     size_t buf_size;
+    uint32_t use_count;         /* Current use stamp                      */
+    uint8_t data_width;         /* Driver data width in bytes, from init  */
 };
 
 extern const struct its_flash_fs_ops_t its_flash_fs_ops_nand;
@@ -42,6 +42,13 @@ extern "C" {
 /* Invalid block index */
 #define ITS_BLOCK_INVALID_ID 0xFFFFFFFFU
 
+/* Physical ID of the two metadata blocks */
+/* NOTE: the earmarked area may not always start at block number 0.
+ *       However, the flash interface can always add the required offset.
+ */
+#define ITS_METADATA_BLOCK0  0
+#define ITS_METADATA_BLOCK1  1
+
 /**
  * \struct its_flash_fs_config_t
  *
@@ -15,13 +15,6 @@
 #define ITS_MAX_BLOCK_DATA_COPY 256
 #endif
 
-/* Physical ID of the two metadata blocks */
-/* NOTE: the earmarked area may not always start at block number 0.
- *       However, the flash interface can always add the required offset.
- */
-#define ITS_METADATA_BLOCK0  0
-#define ITS_METADATA_BLOCK1  1
-
 /*!
  * \def ITS_OTHER_META_BLOCK
  *
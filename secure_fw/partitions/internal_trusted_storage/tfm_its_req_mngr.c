@@ -19,6 +19,7 @@
 #include "psa/service.h"
 #include "psa_manifest/tfm_internal_trusted_storage.h"
 #include "tfm_its_defs.h"
+#include "tfm_psa_rw_vec.h"
 #if PSA_FRAMEWORK_HAS_MM_IOVEC != 1
 #include "flash/its_flash.h"
 #endif /* PSA_FRAMEWORK_HAS_MM_IOVEC != 1 */
@@ -42,6 +43,10 @@ static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
     psa_storage_create_flags_t create_flags;
     struct its_asset_info asset_info;
     size_t num;
+    struct tfm_psa_rw_seg_t segs[] = {
+        {0, &uid, sizeof(uid)},
+        {2, &create_flags, sizeof(create_flags)},
+    };
 
     if (msg->in_size[0] != sizeof(uid) ||
         msg->in_size[2] != sizeof(create_flags)) {
@@ -49,13 +54,9 @@ static psa_status_t tfm_its_set_req(const psa_msg_t *msg)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
-    if (num != sizeof(uid)) {
-        return PSA_ERROR_PROGRAMMER_ERROR;
-    }
-
-    num = psa_read(msg->handle, 2, &create_flags, sizeof(create_flags));
-    if (num != sizeof(create_flags)) {
+    /* Fetch the fixed size arguments in one request */
+    num = tfm_psa_read_vec(msg->handle, segs, sizeof(segs) / sizeof(segs[0]));
+    if (num != sizeof(uid) + sizeof(create_flags)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
@@ -108,6 +109,10 @@ static psa_status_t tfm_its_get_req(const psa_msg_t *msg)
     size_t num;
     struct its_asset_info asset_info;
     bool first_get;
+    struct tfm_psa_rw_seg_t segs[] = {
+        {0, &uid, sizeof(uid)},
+        {1, &data_offset, sizeof(data_offset)},
+    };
 
     if (msg->in_size[0] != sizeof(uid) ||
         msg->in_size[1] != sizeof(data_offset)) {
@@ -115,13 +120,9 @@ static psa_status_t tfm_its_get_req(const psa_msg_t *msg)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
-    if (num != sizeof(uid)) {
-        return PSA_ERROR_PROGRAMMER_ERROR;
-    }
-
-    num = psa_read(msg->handle, 1, &data_offset, sizeof(data_offset));
-    if (num != sizeof(data_offset)) {
+    /* Fetch the fixed size arguments in one request */
+    num = tfm_psa_read_vec(msg->handle, segs, sizeof(segs) / sizeof(segs[0]));
+    if (num != sizeof(uid) + sizeof(data_offset)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2020, Arm Limited. All rights reserved.
+ * Copyright (c) 2020-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -22,4 +22,18 @@ int32_t tfm_core_get_boot_data(uint8_t major_type,
                                struct tfm_boot_data *boot_data,
                                uint32_t len);
 
+#ifdef CONFIG_TFM_SPM_PROFILING
+/**
+ * \brief Dump the SPM profiling counters through the SPM log device. Only
+ *        privileged partitions are allowed to call it.
+ *
+ * \param[in] flags       SPM_PROFILER_DUMP_RESET to clear the counters after
+ *                        dumping, or 0.
+ *
+ * \retval PSA_SUCCESS               The counters are dumped.
+ * \retval PSA_ERROR_NOT_PERMITTED   The caller is not privileged.
+ */
+int32_t tfm_spm_profiler_dump(uint32_t flags);
+#endif
+
 #endif /* __SERVICE_API_H__ */
@@ -31,6 +31,12 @@ __used static uintptr_t runtime_init_c(void)
 #pragma required = runtime_init_c
 #endif
 
+#ifdef TFM_SPM_HOST_BUILD
+void sprt_main(void)
+{
+    ((void (*)(void))runtime_init_c())();
+}
+#else
 __naked void sprt_main(void)
 {
     __asm volatile(
@@ -41,3 +47,4 @@ __naked void sprt_main(void)
         "bx r0              \n"
     );
 }
+#endif
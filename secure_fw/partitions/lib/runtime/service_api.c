@@ -31,3 +31,14 @@ void tfm_flih_func_return(psa_flih_result_t result)
                    );
 }
 #endif /* TFM_LVL != 1 */
+
+#ifdef CONFIG_TFM_SPM_PROFILING
+__attribute__((naked))
+int32_t tfm_spm_profiler_dump(uint32_t flags)
+{
+    __ASM volatile(
+        "SVC    "M2S(TFM_SVC_SPM_PROFILER_DUMP)"           \n"
+        "BX     lr                                         \n"
+        );
+}
+#endif /* CONFIG_TFM_SPM_PROFILING */
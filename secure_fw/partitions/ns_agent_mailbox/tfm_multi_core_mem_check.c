@@ -14,6 +14,7 @@
 #include "region.h"
 #include "region_defs.h"
 #include "tfm_hal_multi_core.h"
+#include "tfm_mailbox.h"
 #include "tfm_multi_core.h"
 #include "tfm_arch.h"
 #include "utilities.h"
@@ -31,35 +32,22 @@
 #define MEM_CHECK_NONSECURE             (MEM_CHECK_AU_NONSECURE | \
                                          MEM_CHECK_MPU_NONSECURE)
 
-void tfm_get_mem_region_security_attr(const void *p, size_t s,
-                                      struct security_attr_info_t *p_attr)
-{
-    p_attr->is_valid = true;
+#if NUM_MAILBOX_SHM_BUF > 0
+/* A non-secure shared memory buffer registered by NSPE */
+struct shm_buf_t {
+    uintptr_t base;
+    uintptr_t limit;            /* The last byte of the buffer */
+    uint32_t  flags;            /* Granted access types. 0 if not in use. */
+};
 
-    if (check_address_range(p, s, NS_DATA_START,
-                            NS_DATA_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_secure = false;
-        return;
-    }
+#define SHM_ID_TO_IDX(id)               ((id) - 1)
+#define SHM_IDX_TO_ID(idx)              ((int32_t)(idx) + 1)
 
-    if (check_address_range(p, s, NS_CODE_START,
-                            NS_CODE_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_secure = false;
-        return;
-    }
+static struct shm_buf_t shm_bufs[NUM_MAILBOX_SHM_BUF];
 
-    if (check_address_range(p, s, S_DATA_START, S_DATA_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_secure = true;
-        return;
-    }
-
-    if (check_address_range(p, s, S_CODE_START, S_CODE_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_secure = true;
-        return;
-    }
-
-    p_attr->is_valid = false;
-}
+/* The buffer selected by the PSA client call under processing */
+static const struct shm_buf_t *p_selected_shm;
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
 
 #if TFM_LVL == 2
 REGION_DECLARE(Image$$, TFM_UNPRIV_CODE, $$RO$$Base);
@@ -74,147 +62,316 @@ REGION_DECLARE(Image$$, TFM_APP_RW_STACK_START, $$Base);
 REGION_DECLARE(Image$$, TFM_APP_RW_STACK_END, $$Base);
 #endif
 
-void tfm_get_secure_mem_region_attr(const void *p, size_t s,
-                                    struct mem_attr_info_t *p_attr)
+/* Attributes of a memory region in a region table */
+#define REGION_ATTR_SECURE              (1U << 0)
+#define REGION_ATTR_PRIV_RD             (1U << 1)
+#define REGION_ATTR_PRIV_WR             (1U << 2)
+#define REGION_ATTR_UNPRIV_RD           (1U << 3)
+#define REGION_ATTR_UNPRIV_WR           (1U << 4)
+#define REGION_ATTR_XN                  (1U << 5)
+
+/* Data region accessible to both privileged and unprivileged software */
+#define REGION_ATTR_DATA                (REGION_ATTR_PRIV_RD   | \
+                                         REGION_ATTR_PRIV_WR   | \
+                                         REGION_ATTR_UNPRIV_RD | \
+                                         REGION_ATTR_UNPRIV_WR | \
+                                         REGION_ATTR_XN)
+/* Code region accessible to both privileged and unprivileged software */
+#define REGION_ATTR_CODE                (REGION_ATTR_PRIV_RD   | \
+                                         REGION_ATTR_UNPRIV_RD)
+
+#define REGION_TABLE_SIZE_MAX           8
+
+struct mem_region_t {
+    uintptr_t base;
+    uintptr_t limit;                    /* The last byte of the region */
+    uint32_t  attr;                     /* REGION_ATTR_* bitmask */
+};
+
+/*
+ * A table of memory regions. When regions overlap, the one added first takes
+ * precedence. If no regions overlap, the regions are looked up by binary
+ * search on the base address, with the last matched region checked first.
+ */
+struct mem_region_table_t {
+    struct mem_region_t regions[REGION_TABLE_SIZE_MAX]; /* In added order */
+    uint8_t             sorted[REGION_TABLE_SIZE_MAX];  /*
+                                                         * Region indexes in
+                                                         * base address order
+                                                         */
+    uint8_t             nr_regions;
+    uint8_t             last_hit;       /* Index of the last matched region */
+    bool                is_disjoint;    /* Whether no regions overlap */
+};
+
+/* Security attributes of all the memory regions */
+static struct mem_region_table_t security_regions;
+/* Access attributes of the secure memory regions */
+static struct mem_region_table_t secure_regions;
+#if TFM_LVL == 2
+/* The default attributes of the secure regions not in secure_regions */
+static struct mem_region_table_t secure_default_regions;
+#endif
+/* Access attributes of the non-secure memory regions */
+static struct mem_region_table_t ns_regions;
+
+static bool region_tables_ready;
+
+static void region_table_add(struct mem_region_table_t *p_table,
+                             uintptr_t base, uintptr_t limit, uint32_t attr)
 {
-#if TFM_LVL == 1
-    p_attr->is_mpu_enabled = false;
-    p_attr->is_valid = true;
+    struct mem_region_t *p_region;
 
-    if (check_address_range(p, s, S_DATA_START, S_DATA_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
+    /* Skip empty regions */
+    if (limit < base) {
         return;
     }
 
-    if (check_address_range(p, s, S_CODE_START, S_CODE_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+    if (p_table->nr_regions >= REGION_TABLE_SIZE_MAX) {
+        tfm_core_panic();
     }
 
-    p_attr->is_valid = false;
-#elif TFM_LVL == 2
-    uintptr_t base, limit;
+    p_region = &p_table->regions[p_table->nr_regions];
+    p_region->base = base;
+    p_region->limit = limit;
+    p_region->attr = attr;
 
-    p_attr->is_mpu_enabled = false;
-    p_attr->is_valid = true;
+    p_table->nr_regions++;
+}
 
-    /* TFM Core unprivileged code region */
-    base = (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE, $$RO$$Base);
-    limit = (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE, $$RO$$Limit) - 1;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+/* Sort the regions by base address and check whether they overlap. */
+static void region_table_seal(struct mem_region_table_t *p_table)
+{
+    const struct mem_region_t *p_regions = p_table->regions;
+    uint8_t i, j, idx;
+
+    /* Insertion sort. The tables only have a few entries. */
+    for (i = 0; i < p_table->nr_regions; i++) {
+        idx = i;
+        for (j = i; (j > 0) &&
+             (p_regions[p_table->sorted[j - 1]].base > p_regions[idx].base);
+             j--) {
+            p_table->sorted[j] = p_table->sorted[j - 1];
+        }
+        p_table->sorted[j] = idx;
+    }
+
+    p_table->is_disjoint = true;
+    for (i = 1; i < p_table->nr_regions; i++) {
+        if (p_regions[p_table->sorted[i - 1]].limit >=
+            p_regions[p_table->sorted[i]].base) {
+            p_table->is_disjoint = false;
+            break;
+        }
+    }
+
+    p_table->last_hit = 0;
+}
+
+/*
+ * Find the region containing the range [p, p + s - 1].
+ * Return NULL if no region contains the whole range.
+ */
+static const struct mem_region_t *region_table_lookup(
+                                        struct mem_region_table_t *p_table,
+                                        const void *p, size_t s)
+{
+    const struct mem_region_t *p_regions = p_table->regions;
+    const struct mem_region_t *p_region;
+    uint8_t lo, hi, mid;
+
+    if (p_table->nr_regions == 0) {
+        return NULL;
+    }
+
+    if (!p_table->is_disjoint) {
+        /* Keep the precedence of overlapping regions */
+        for (lo = 0; lo < p_table->nr_regions; lo++) {
+            if (check_address_range(p, s, p_regions[lo].base,
+                                    p_regions[lo].limit) == TFM_SUCCESS) {
+                return &p_regions[lo];
+            }
+        }
+
+        return NULL;
+    }
+
+    /*
+     * The same buffers are usually checked repeatedly. Disjoint regions
+     * guarantee that the last matched region is the only candidate if it
+     * contains the range.
+     */
+    p_region = &p_regions[p_table->last_hit];
+    if (check_address_range(p, s, p_region->base,
+                            p_region->limit) == TFM_SUCCESS) {
+        return p_region;
     }
 
+    /* Find the last region whose base is not above p */
+    lo = 0;
+    hi = p_table->nr_regions;
+    while (lo < hi) {
+        mid = (uint8_t)((lo + hi) / 2);
+        if (p_regions[p_table->sorted[mid]].base <= (uintptr_t)p) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return NULL;
+    }
+
+    p_region = &p_regions[p_table->sorted[lo - 1]];
+    if (check_address_range(p, s, p_region->base,
+                            p_region->limit) != TFM_SUCCESS) {
+        return NULL;
+    }
+
+    p_table->last_hit = p_table->sorted[lo - 1];
+
+    return p_region;
+}
+
+/*
+ * Build the region tables from the memory layout. It is done at the first
+ * check since the region boundaries in isolation level 2 are linker symbols.
+ */
+static void region_tables_init(void)
+{
+    /* Non-secure regions are added first to keep the original precedence */
+    region_table_add(&security_regions, NS_DATA_START, NS_DATA_LIMIT, 0);
+    region_table_add(&security_regions, NS_CODE_START, NS_CODE_LIMIT, 0);
+    region_table_add(&security_regions, S_DATA_START, S_DATA_LIMIT,
+                     REGION_ATTR_SECURE);
+    region_table_add(&security_regions, S_CODE_START, S_CODE_LIMIT,
+                     REGION_ATTR_SECURE);
+    region_table_seal(&security_regions);
+
+#if TFM_LVL == 1
+    region_table_add(&secure_regions, S_DATA_START, S_DATA_LIMIT,
+                     REGION_ATTR_DATA);
+    region_table_add(&secure_regions, S_CODE_START, S_CODE_LIMIT,
+                     REGION_ATTR_CODE);
+    region_table_seal(&secure_regions);
+#elif TFM_LVL == 2
+    /* TFM Core unprivileged code region */
+    region_table_add(&secure_regions,
+        (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE, $$RO$$Base),
+        (uintptr_t)&REGION_NAME(Image$$, TFM_UNPRIV_CODE, $$RO$$Limit) - 1,
+        REGION_ATTR_CODE);
+
 #ifdef CONFIG_TFM_PARTITION_META
     /* TFM partition metadata pointer region */
-    base = (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Base);
-    limit = (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Limit) - 1;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
-    }
+    region_table_add(&secure_regions,
+        (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Base),
+        (uintptr_t)&REGION_NAME(Image$$, TFM_SP_META_PTR, $$ZI$$Limit) - 1,
+        REGION_ATTR_DATA);
 #endif
 
     /* APP RoT partition RO region */
-    base = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_START, $$Base);
-    limit = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_END, $$Base) - 1;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
-    }
+    region_table_add(&secure_regions,
+        (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_START, $$Base),
+        (uintptr_t)&REGION_NAME(Image$$, TFM_APP_CODE_END, $$Base) - 1,
+        REGION_ATTR_CODE);
 
     /* RW, ZI and stack as one region */
-    base = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_START, $$Base);
-    limit = (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_END, $$Base) - 1;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
-    }
+    region_table_add(&secure_regions,
+        (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_START, $$Base),
+        (uintptr_t)&REGION_NAME(Image$$, TFM_APP_RW_STACK_END, $$Base) - 1,
+        REGION_ATTR_DATA);
+    region_table_seal(&secure_regions);
 
     /*
      * Treat the remaining parts in secure data section and secure code section
      * as privileged regions
      */
-    base = (uintptr_t)S_DATA_START;
-    limit = (uintptr_t)S_DATA_LIMIT;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = false;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = true;
+    region_table_add(&secure_default_regions, S_DATA_START, S_DATA_LIMIT,
+                     REGION_ATTR_PRIV_RD | REGION_ATTR_PRIV_WR |
+                     REGION_ATTR_XN);
+    region_table_add(&secure_default_regions, S_CODE_START, S_CODE_LIMIT,
+                     REGION_ATTR_PRIV_RD);
+    region_table_seal(&secure_default_regions);
+#else
+#error "Cannot support current TF-M isolation level"
+#endif
+
+    region_table_add(&ns_regions, NS_DATA_START, NS_DATA_LIMIT,
+                     REGION_ATTR_DATA);
+    region_table_add(&ns_regions, NS_CODE_START, NS_CODE_LIMIT,
+                     REGION_ATTR_CODE);
+    region_table_seal(&ns_regions);
+
+    region_tables_ready = true;
+}
+
+static void region_attr_to_mem_attr(const struct mem_region_t *p_region,
+                                    struct mem_attr_info_t *p_attr)
+{
+    if (!p_region) {
+        p_attr->is_valid = false;
         return;
     }
 
-    base = (uintptr_t)S_CODE_START;
-    limit = (uintptr_t)S_CODE_LIMIT;
-    if (check_address_range(p, s, base, limit) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = false;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
+    p_attr->is_valid = true;
+    p_attr->is_priv_rd_allow = !!(p_region->attr & REGION_ATTR_PRIV_RD);
+    p_attr->is_priv_wr_allow = !!(p_region->attr & REGION_ATTR_PRIV_WR);
+    p_attr->is_unpriv_rd_allow = !!(p_region->attr & REGION_ATTR_UNPRIV_RD);
+    p_attr->is_unpriv_wr_allow = !!(p_region->attr & REGION_ATTR_UNPRIV_WR);
+    p_attr->is_xn = !!(p_region->attr & REGION_ATTR_XN);
+}
+
+void tfm_get_mem_region_security_attr(const void *p, size_t s,
+                                      struct security_attr_info_t *p_attr)
+{
+    const struct mem_region_t *p_region;
+
+    if (!region_tables_ready) {
+        region_tables_init();
+    }
+
+    p_region = region_table_lookup(&security_regions, p, s);
+    if (!p_region) {
+        p_attr->is_valid = false;
         return;
     }
 
-    p_attr->is_valid = false;
-#else
-#error "Cannot support current TF-M isolation level"
-#endif
+    p_attr->is_valid = true;
+    p_attr->is_secure = !!(p_region->attr & REGION_ATTR_SECURE);
 }
 
-void tfm_get_ns_mem_region_attr(const void *p, size_t s,
-                                struct mem_attr_info_t *p_attr)
+void tfm_get_secure_mem_region_attr(const void *p, size_t s,
+                                    struct mem_attr_info_t *p_attr)
 {
+    const struct mem_region_t *p_region;
+
+    if (!region_tables_ready) {
+        region_tables_init();
+    }
+
     p_attr->is_mpu_enabled = false;
-    p_attr->is_valid = true;
 
-    if (check_address_range(p, s, NS_DATA_START,
-                            NS_DATA_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = true;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = true;
-        p_attr->is_xn = true;
-        return;
+    p_region = region_table_lookup(&secure_regions, p, s);
+#if TFM_LVL == 2
+    if (!p_region) {
+        p_region = region_table_lookup(&secure_default_regions, p, s);
     }
+#endif
 
-    if (check_address_range(p, s, NS_CODE_START,
-                            NS_CODE_LIMIT) == TFM_SUCCESS) {
-        p_attr->is_priv_rd_allow = true;
-        p_attr->is_priv_wr_allow = false;
-        p_attr->is_unpriv_rd_allow = true;
-        p_attr->is_unpriv_wr_allow = false;
-        p_attr->is_xn = false;
-        return;
+    region_attr_to_mem_attr(p_region, p_attr);
+}
+
+void tfm_get_ns_mem_region_attr(const void *p, size_t s,
+                                struct mem_attr_info_t *p_attr)
+{
+    if (!region_tables_ready) {
+        region_tables_init();
     }
 
-    p_attr->is_valid = false;
+    p_attr->is_mpu_enabled = false;
+
+    region_attr_to_mem_attr(region_table_lookup(&ns_regions, p, s), p_attr);
 }
 
 static void security_attr_init(struct security_attr_info_t *p_attr)
@@ -390,29 +547,43 @@ static enum tfm_status_e mem_attr_check(struct mem_attr_info_t attr,
     return secure_mem_attr_check(attr, flags);
 }
 
-enum tfm_status_e tfm_has_access_to_region(const void *p, size_t s,
-                                           uint32_t flags)
+#if NUM_MAILBOX_SHM_BUF > 0
+/**
+ * \brief Check whether the access to a non-secure memory range is covered by
+ *        the selected shared memory buffer.
+ *
+ * \param[in] p      The start address of the range to check
+ * \param[in] s      The size of the range to check
+ * \param[in] flags  The flags indicating the access permissions.
+ *
+ * \return true if the range is inside the selected buffer and the buffer was
+ *         registered with the required access,
+ *         false otherwise.
+ */
+static bool shm_covers_region(const void *p, size_t s, uint32_t flags)
 {
-    struct security_attr_info_t security_attr;
-    struct mem_attr_info_t mem_attr;
+    const struct shm_buf_t *p_shm = p_selected_shm;
 
-    /* If size is zero, this indicates an empty buffer and base is ignored */
-    if (s == 0) {
-        return TFM_SUCCESS;
+    if (!p_shm || !(flags & MEM_CHECK_NONSECURE)) {
+        return false;
     }
 
-    if (!p) {
-        return TFM_ERROR_GENERIC;
+    if ((flags & MEM_CHECK_MPU_READWRITE) &&
+        !(p_shm->flags & MEM_CHECK_MPU_READWRITE)) {
+        return false;
     }
 
-    if ((uintptr_t)p > (UINTPTR_MAX - s)) {
-        return TFM_ERROR_GENERIC;
-    }
+    return check_address_range(p, s, p_shm->base,
+                               p_shm->limit) == TFM_SUCCESS;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
 
-    /* Abort if current check doesn't run in PSA RoT */
-    if (!tfm_arch_is_priv()) {
-        tfm_core_panic();
-    }
+/* Check the access against the memory layout and the isolation settings */
+static enum tfm_status_e region_access_check(const void *p, size_t s,
+                                             uint32_t flags)
+{
+    struct security_attr_info_t security_attr;
+    struct mem_attr_info_t mem_attr;
 
     security_attr_init(&security_attr);
 
@@ -443,6 +614,127 @@ enum tfm_status_e tfm_has_access_to_region(const void *p, size_t s,
     return mem_attr_check(mem_attr, flags);
 }
 
+enum tfm_status_e tfm_has_access_to_region(const void *p, size_t s,
+                                           uint32_t flags)
+{
+    /* If size is zero, this indicates an empty buffer and base is ignored */
+    if (s == 0) {
+        return TFM_SUCCESS;
+    }
+
+    if (!p) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    if ((uintptr_t)p > (UINTPTR_MAX - s)) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    /* Abort if current check doesn't run in PSA RoT */
+    if (!tfm_arch_is_priv()) {
+        tfm_core_panic();
+    }
+
+#if NUM_MAILBOX_SHM_BUF > 0
+    /*
+     * The whole buffer passed the check below at registration. Memory layout
+     * and non-secure access attributes don't change at runtime, so the result
+     * still holds for any range inside the buffer.
+     */
+    if (shm_covers_region(p, s, flags)) {
+        return TFM_SUCCESS;
+    }
+#endif
+
+    return region_access_check(p, s, flags);
+}
+
+#if NUM_MAILBOX_SHM_BUF > 0
+enum tfm_status_e tfm_multi_core_shm_register(const void *p, size_t s,
+                                              uint32_t flags,
+                                              int32_t *shm_id)
+{
+    uint32_t i;
+
+    if (!shm_id || !p || (s == 0) || ((uintptr_t)p > (UINTPTR_MAX - s))) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    /* Only non-secure buffers can be shared */
+    if (!(flags & MEM_CHECK_NONSECURE) ||
+        !(flags & (MEM_CHECK_MPU_READ | MEM_CHECK_MPU_READWRITE))) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    if (region_access_check(p, s, flags) != TFM_SUCCESS) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    for (i = 0; i < NUM_MAILBOX_SHM_BUF; i++) {
+        if (shm_bufs[i].flags == 0) {
+            shm_bufs[i].base = (uintptr_t)p;
+            shm_bufs[i].limit = (uintptr_t)p + s - 1;
+            shm_bufs[i].flags = flags;
+
+            *shm_id = SHM_IDX_TO_ID(i);
+            return TFM_SUCCESS;
+        }
+    }
+
+    return TFM_ERROR_GENERIC;
+}
+
+/* Get the buffer in use with the ID */
+static struct shm_buf_t *shm_get_buf(int32_t shm_id)
+{
+    if ((shm_id <= 0) || (shm_id > NUM_MAILBOX_SHM_BUF)) {
+        return NULL;
+    }
+
+    if (shm_bufs[SHM_ID_TO_IDX(shm_id)].flags == 0) {
+        return NULL;
+    }
+
+    return &shm_bufs[SHM_ID_TO_IDX(shm_id)];
+}
+
+enum tfm_status_e tfm_multi_core_shm_unregister(int32_t shm_id)
+{
+    struct shm_buf_t *p_shm = shm_get_buf(shm_id);
+
+    if (!p_shm) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    if (p_selected_shm == p_shm) {
+        p_selected_shm = NULL;
+    }
+
+    spm_memset(p_shm, 0, sizeof(*p_shm));
+
+    return TFM_SUCCESS;
+}
+
+enum tfm_status_e tfm_multi_core_shm_select(int32_t shm_id)
+{
+    struct shm_buf_t *p_shm;
+
+    if (shm_id == MAILBOX_SHM_NULL_ID) {
+        p_selected_shm = NULL;
+        return TFM_SUCCESS;
+    }
+
+    p_shm = shm_get_buf(shm_id);
+    if (!p_shm) {
+        return TFM_ERROR_GENERIC;
+    }
+
+    p_selected_shm = p_shm;
+
+    return TFM_SUCCESS;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 enum tfm_status_e check_address_range(const void *p, size_t s,
                                       uintptr_t region_start,
                                       uintptr_t region_limit)
@@ -34,4 +34,10 @@
 #define PLATFORM_NV_COUNTER_MODULE_DISABLED    0
 #endif
 
+/* Number of asynchronous IOCTL requests in flight, 0 disables them */
+#ifndef PLATFORM_IOCTL_ASYNC_SLOT_NUM
+#pragma message("PLATFORM_IOCTL_ASYNC_SLOT_NUM is defaulted to 0. Please check and set it explicitly.")
+#define PLATFORM_IOCTL_ASYNC_SLOT_NUM          0
+#endif
+
 #endif /* __CONFIG_PARTITION_PLATFORM_H__ */
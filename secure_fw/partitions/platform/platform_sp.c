@@ -5,6 +5,8 @@
  *
  */
 
+#include <string.h>
+
 #include "config_platform.h"
 #include "platform_sp.h"
 
@@ -172,6 +174,104 @@ static psa_status_t platform_sp_nv_increment_psa_api(const psa_msg_t *msg)
 
     return TFM_PLATFORM_ERR_SUCCESS;
 }
+
+/*
+ * Reads the counter IDs of a multiple counter request, and checks the caller
+ * is allowed to access all of them before any counter is accessed.
+ */
+static enum tfm_platform_err_t nv_multi_read_ids(
+        const psa_msg_t *msg,
+        size_t out_len_expected,
+        bool is_read,
+        enum tfm_nv_counter_t counter_ids[TFM_PLATFORM_NV_COUNTER_MULTI_MAX],
+        uint32_t *counter_num)
+{
+    size_t in_len = PSA_MAX_IOVEC, out_len = PSA_MAX_IOVEC, num = 0;
+    uint32_t ids[TFM_PLATFORM_NV_COUNTER_MULTI_MAX];
+    uint32_t i;
+
+    /* Check the number of in_vec filled */
+    while ((in_len > 0) && (msg->in_size[in_len - 1] == 0)) {
+        in_len--;
+    }
+
+    /* Check the number of out_vec filled */
+    while ((out_len > 0) && (msg->out_size[out_len - 1] == 0)) {
+        out_len--;
+    }
+
+    if (in_len != 1 || out_len != out_len_expected ||
+        msg->in_size[0] == 0 || msg->in_size[0] > sizeof(ids) ||
+        msg->in_size[0] % sizeof(uint32_t) != 0) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    num = psa_read(msg->handle, 0, ids, msg->in_size[0]);
+    if (num != msg->in_size[0]) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    *counter_num = num / sizeof(uint32_t);
+    for (i = 0; i < *counter_num; i++) {
+        counter_ids[i] = (enum tfm_nv_counter_t)ids[i];
+        if (msg->client_id < 0) {
+            counter_ids[i] += PLAT_NV_COUNTER_NS_0;
+        }
+
+        if (nv_counter_permissions_check(msg->client_id, counter_ids[i],
+                                         is_read)
+            != TFM_PLATFORM_ERR_SUCCESS) {
+            return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+        }
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
+static psa_status_t platform_sp_nv_read_multi_psa_api(const psa_msg_t *msg)
+{
+    enum tfm_nv_counter_t counter_ids[TFM_PLATFORM_NV_COUNTER_MULTI_MAX];
+    uint32_t counter_vals[TFM_PLATFORM_NV_COUNTER_MULTI_MAX];
+    uint32_t counter_num = 0;
+    enum tfm_platform_err_t ret;
+
+    ret = nv_multi_read_ids(msg, 1, true, counter_ids, &counter_num);
+    if (ret != TFM_PLATFORM_ERR_SUCCESS) {
+        return ret;
+    }
+
+    if (msg->out_size[0] != counter_num * sizeof(uint32_t)) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    if (tfm_plat_read_nv_counters(counter_ids, counter_num, counter_vals)
+        != TFM_PLAT_ERR_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    psa_write(msg->handle, 0, counter_vals, msg->out_size[0]);
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
+static psa_status_t platform_sp_nv_increment_multi_psa_api(const psa_msg_t *msg)
+{
+    enum tfm_nv_counter_t counter_ids[TFM_PLATFORM_NV_COUNTER_MULTI_MAX];
+    uint32_t counter_num = 0;
+    enum tfm_platform_err_t ret;
+
+    ret = nv_multi_read_ids(msg, 0, false, counter_ids, &counter_num);
+    if (ret != TFM_PLATFORM_ERR_SUCCESS) {
+        return ret;
+    }
+
+    if (tfm_plat_increment_nv_counters(counter_ids, counter_num)
+        != TFM_PLAT_ERR_SUCCESS) {
+        return TFM_PLATFORM_ERR_SYSTEM_ERROR;
+    }
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
 #endif /* !PLATFORM_NV_COUNTER_MODULE_DISABLED*/
 
 static psa_status_t platform_sp_ioctl_psa_api(const psa_msg_t *msg)
@@ -239,6 +339,231 @@ static psa_status_t platform_sp_ioctl_psa_api(const psa_msg_t *msg)
     return ret;
 }
 
+#if PLATFORM_IOCTL_ASYNC_SLOT_NUM > 0
+/*
+ * A client can hold at most half of the slots, so that a client which does not
+ * collect its tickets cannot starve the others.
+ */
+#define IOCTL_ASYNC_CLIENT_SLOT_MAX ((PLATFORM_IOCTL_ASYNC_SLOT_NUM + 1) / 2)
+
+/* An asynchronous IOCTL request in flight, the slot is free if ticket is 0 */
+struct ioctl_async_slot_t {
+    uint32_t ticket;
+    int32_t client_id;
+    bool done;                      /* The result is known, no need to poll */
+    enum tfm_platform_err_t result;
+    size_t output_size;             /* Size of the output requested */
+    size_t output_len;              /* Size of the output produced */
+    uint8_t output[PLATFORM_SERVICE_OUTPUT_BUFFER_SIZE];
+};
+
+static struct ioctl_async_slot_t ioctl_async_slots[PLATFORM_IOCTL_ASYNC_SLOT_NUM];
+static uint32_t ioctl_async_last_ticket;
+
+static struct ioctl_async_slot_t *ioctl_async_alloc(int32_t client_id,
+                                                    size_t output_size)
+{
+    struct ioctl_async_slot_t *slot = NULL;
+    uint32_t client_slots = 0;
+    uint32_t i;
+
+    for (i = 0; i < PLATFORM_IOCTL_ASYNC_SLOT_NUM; i++) {
+        if (ioctl_async_slots[i].ticket == 0) {
+            if (slot == NULL) {
+                slot = &ioctl_async_slots[i];
+            }
+        } else if (ioctl_async_slots[i].client_id == client_id) {
+            client_slots++;
+        }
+    }
+
+    if ((slot == NULL) || (client_slots >= IOCTL_ASYNC_CLIENT_SLOT_MAX)) {
+        return NULL;
+    }
+
+    /* Skip the 0 value when the ticket counter wraps */
+    if (++ioctl_async_last_ticket == 0) {
+        ioctl_async_last_ticket++;
+    }
+    slot->ticket = ioctl_async_last_ticket;
+    slot->client_id = client_id;
+    slot->done = false;
+    slot->output_size = output_size;
+    slot->output_len = 0;
+    /* Do not return the output of a previous request */
+    memset(slot->output, 0, sizeof(slot->output));
+
+    return slot;
+}
+
+/* Record the output produced by the HAL, which updates out_vec->len */
+static void ioctl_async_set_output_len(struct ioctl_async_slot_t *slot,
+                                       const psa_outvec *out_vec)
+{
+    slot->output_len = out_vec->len < slot->output_size ?
+                       out_vec->len : slot->output_size;
+}
+
+static struct ioctl_async_slot_t *ioctl_async_find(int32_t client_id,
+                                                   uint32_t ticket)
+{
+    uint32_t i;
+
+    if (ticket == 0) {
+        return NULL;
+    }
+
+    /* A ticket can only be collected by the client which has started it */
+    for (i = 0; i < PLATFORM_IOCTL_ASYNC_SLOT_NUM; i++) {
+        if (ioctl_async_slots[i].ticket == ticket &&
+            ioctl_async_slots[i].client_id == client_id) {
+            return &ioctl_async_slots[i];
+        }
+    }
+
+    return NULL;
+}
+
+static psa_status_t platform_sp_ioctl_async_psa_api(const psa_msg_t *msg)
+{
+    void *input = NULL;
+    psa_invec invec = {0};
+    psa_outvec outvec = {0};
+    uint8_t input_buffer[PLATFORM_SERVICE_INPUT_BUFFER_SIZE] = {0};
+    tfm_platform_ioctl_req_t request = 0;
+    struct ioctl_async_slot_t *slot;
+    enum tfm_platform_err_t ret;
+    uint32_t output_size = 0;
+    size_t num = 0;
+    uint32_t in_len = PSA_MAX_IOVEC;
+    uint32_t out_len = PSA_MAX_IOVEC;
+
+    while ((in_len > 0) && (msg->in_size[in_len - 1] == 0)) {
+        in_len--;
+    }
+
+    while ((out_len > 0) && (msg->out_size[out_len - 1] == 0)) {
+        out_len--;
+    }
+
+    if ((in_len < 2) || (in_len > 3) || (out_len != 1) ||
+        (msg->out_size[0] != sizeof(slot->ticket))) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 0, &request, sizeof(request));
+    if (num != sizeof(request)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 1, &output_size, sizeof(output_size));
+    if (num != sizeof(output_size) ||
+        output_size > PLATFORM_SERVICE_OUTPUT_BUFFER_SIZE) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    if (in_len > 2) {
+        if (msg->in_size[2] > PLATFORM_SERVICE_INPUT_BUFFER_SIZE) {
+            return PSA_ERROR_BUFFER_TOO_SMALL;
+        }
+        num = psa_read(msg->handle, 2, input_buffer, msg->in_size[2]);
+        if (num != msg->in_size[2]) {
+            return PSA_ERROR_PROGRAMMER_ERROR;
+        }
+        invec.base = input_buffer;
+        invec.len = num;
+        input = &invec;
+    }
+
+    slot = ioctl_async_alloc(msg->client_id, output_size);
+    if (slot == NULL) {
+        return TFM_PLATFORM_ERR_BUSY;
+    }
+
+    ret = tfm_platform_hal_ioctl_async_start(msg->client_id, slot->ticket,
+                                             request, input);
+    if (ret == TFM_PLATFORM_ERR_NOT_SUPPORTED) {
+        /*
+         * The request cannot complete later, so serve it now. The client
+         * collects its result the same way.
+         */
+        outvec.base = slot->output;
+        outvec.len = output_size;
+        slot->result = tfm_platform_hal_ioctl(request, input,
+                                              output_size > 0 ? &outvec : NULL);
+        ioctl_async_set_output_len(slot, &outvec);
+        slot->done = true;
+    } else if (ret != TFM_PLATFORM_ERR_SUCCESS) {
+        slot->ticket = 0;
+        return ret;
+    }
+
+    psa_write(msg->handle, 0, &slot->ticket, sizeof(slot->ticket));
+
+    return TFM_PLATFORM_ERR_SUCCESS;
+}
+
+static psa_status_t platform_sp_ioctl_async_result_psa_api(const psa_msg_t *msg)
+{
+    psa_outvec outvec = {0};
+    struct ioctl_async_slot_t *slot;
+    enum tfm_platform_err_t ret;
+    uint32_t ticket = 0;
+    size_t num = 0;
+    uint32_t in_len = PSA_MAX_IOVEC;
+    uint32_t out_len = PSA_MAX_IOVEC;
+
+    while ((in_len > 0) && (msg->in_size[in_len - 1] == 0)) {
+        in_len--;
+    }
+
+    while ((out_len > 0) && (msg->out_size[out_len - 1] == 0)) {
+        out_len--;
+    }
+
+    if ((in_len != 1) || (out_len > 1)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    num = psa_read(msg->handle, 0, &ticket, sizeof(ticket));
+    if (num != sizeof(ticket)) {
+        return PSA_ERROR_PROGRAMMER_ERROR;
+    }
+
+    slot = ioctl_async_find(msg->client_id, ticket);
+    if (slot == NULL) {
+        return TFM_PLATFORM_ERR_INVALID_PARAM;
+    }
+
+    if ((out_len > 0) && (msg->out_size[0] < slot->output_size)) {
+        return PSA_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    if (!slot->done) {
+        outvec.base = slot->output;
+        outvec.len = slot->output_size;
+        ret = tfm_platform_hal_ioctl_async_poll(ticket,
+                                                slot->output_size > 0 ?
+                                                &outvec : NULL);
+        if (ret == TFM_PLATFORM_ERR_IN_PROGRESS) {
+            return ret;
+        }
+        ioctl_async_set_output_len(slot, &outvec);
+        slot->result = ret;
+        slot->done = true;
+    }
+
+    if (out_len > 0) {
+        psa_write(msg->handle, 0, slot->output, slot->output_len);
+    }
+
+    /* The result is collected, so the ticket is released */
+    slot->ticket = 0;
+
+    return slot->result;
+}
+#endif /* PLATFORM_IOCTL_ASYNC_SLOT_NUM > 0 */
+
 psa_status_t tfm_platform_service_sfn(const psa_msg_t *msg)
 {
     switch (msg->type) {
@@ -247,11 +572,21 @@ psa_status_t tfm_platform_service_sfn(const psa_msg_t *msg)
         return platform_sp_nv_read_psa_api(msg);
     case TFM_PLATFORM_API_ID_NV_INCREMENT:
         return platform_sp_nv_increment_psa_api(msg);
+    case TFM_PLATFORM_API_ID_NV_READ_MULTI:
+        return platform_sp_nv_read_multi_psa_api(msg);
+    case TFM_PLATFORM_API_ID_NV_INCREMENT_MULTI:
+        return platform_sp_nv_increment_multi_psa_api(msg);
 #endif /* PLATFORM_NV_COUNTER_MODULE_DISABLED */
     case TFM_PLATFORM_API_ID_SYSTEM_RESET:
         return platform_sp_system_reset_psa_api(msg);
     case TFM_PLATFORM_API_ID_IOCTL:
         return platform_sp_ioctl_psa_api(msg);
+#if PLATFORM_IOCTL_ASYNC_SLOT_NUM > 0
+    case TFM_PLATFORM_API_ID_IOCTL_ASYNC:
+        return platform_sp_ioctl_async_psa_api(msg);
+    case TFM_PLATFORM_API_ID_IOCTL_ASYNC_RESULT:
+        return platform_sp_ioctl_async_result_psa_api(msg);
+#endif /* PLATFORM_IOCTL_ASYNC_SLOT_NUM > 0 */
     default:
         return PSA_ERROR_NOT_SUPPORTED;
     }
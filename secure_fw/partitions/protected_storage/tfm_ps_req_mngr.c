@@ -18,6 +18,7 @@
 #include "psa/service.h"
 #include "psa_manifest/tfm_protected_storage.h"
 #include "tfm_ps_defs.h"
+#include "tfm_psa_rw_vec.h"
 
 static const psa_msg_t *p_msg;
 
@@ -27,6 +28,10 @@ static psa_status_t tfm_ps_set_req(const psa_msg_t *msg)
     int32_t client_id;
     psa_storage_create_flags_t create_flags;
     size_t num = 0;
+    struct tfm_psa_rw_seg_t segs[] = {
+        {0, &uid, sizeof(uid)},
+        {2, &create_flags, sizeof(create_flags)},
+    };
 
     client_id = msg->client_id;
 
@@ -36,13 +41,9 @@ static psa_status_t tfm_ps_set_req(const psa_msg_t *msg)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 0, &uid, sizeof(uid));
-    if (num != sizeof(uid)) {
-        return PSA_ERROR_PROGRAMMER_ERROR;
-    }
-
-    num = psa_read(msg->handle, 2, &create_flags, sizeof(create_flags));
-    if (num != sizeof(create_flags)) {
+    /* Fetch the fixed size arguments in one request */
+    num = tfm_psa_read_vec(msg->handle, segs, sizeof(segs) / sizeof(segs[0]));
+    if (num != sizeof(uid) + sizeof(create_flags)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
@@ -55,6 +56,10 @@ static psa_status_t tfm_ps_get_req(const psa_msg_t *msg)
     uint32_t data_offset;
     size_t num = 0;
     size_t p_data_length;
+    struct tfm_psa_rw_seg_t segs[] = {
+        {0, &uid, sizeof(uid)},
+        {1, &data_offset, sizeof(data_offset)},
+    };
 
     if (msg->in_size[0] != sizeof(uid) ||
         msg->in_size[1] != sizeof(data_offset)) {
@@ -62,13 +67,9 @@ static psa_status_t tfm_ps_get_req(const psa_msg_t *msg)
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
-    num = psa_read(msg->handle, 0, &uid,  sizeof(uid));
-    if (num != sizeof(psa_storage_uid_t)) {
-        return PSA_ERROR_PROGRAMMER_ERROR;
-    }
-
-    num = psa_read(msg->handle, 1, &data_offset, sizeof(data_offset));
-    if (num != sizeof(data_offset)) {
+    /* Fetch the fixed size arguments in one request */
+    num = tfm_psa_read_vec(msg->handle, segs, sizeof(segs) / sizeof(segs[0]));
+    if (num != sizeof(uid) + sizeof(data_offset)) {
         return PSA_ERROR_PROGRAMMER_ERROR;
     }
 
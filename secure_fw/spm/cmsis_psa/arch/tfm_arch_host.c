@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <ucontext.h>
+#include "aapcs_local.h"
+#include "compiler_ext_defs.h"
+#include "config_impl.h"
+#include "spm_ipc.h"
+#include "tfm_arch.h"
+#include "thread.h"
+#include "utilities.h"
+
+/*
+ * Host simulation of the architecture layer.
+ *
+ * Each thread context is a ucontext running on a stack allocated from a host
+ * side pool, because partition stacks are sized for Arm targets and are too
+ * small for host code and C libraries. The 'sp' member of the context control
+ * points to the host context. Thread stacks in the load info are not used for
+ * execution, but still hold the runtime metadata allocated by the SPM.
+ *
+ * All the SPM structures keep addresses in 32-bit fields, so the host image
+ * must be linked at low addresses (32-bit or non-PIE 64-bit executable).
+ */
+
+#ifndef TFM_HOST_THREAD_NUM_MAX
+#define TFM_HOST_THREAD_NUM_MAX         8
+#endif
+
+#ifndef TFM_HOST_THREAD_STACK_SIZE
+#define TFM_HOST_THREAD_STACK_SIZE      0x10000
+#endif
+
+struct host_context_t {
+    ucontext_t  uc;
+    uint8_t     stack[TFM_HOST_THREAD_STACK_SIZE] __aligned(16);
+};
+
+static struct host_context_t host_contexts[TFM_HOST_THREAD_NUM_MAX];
+static uint32_t host_context_count;
+
+/* The context loaded by tfm_arch_refresh_hardware_context() */
+static struct host_context_t *p_hw_context;
+
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+static bool pendsv_pending;
+#endif
+
+/* Interrupts are masked and SPM runs in 'SVC' until the first thread runs */
+uint32_t tfm_arch_host_primask = 1;
+uint32_t tfm_arch_host_exc_num = EXC_NUM_SVCALL;
+
+uint32_t scheduler_lock = SCHEDULER_UNLOCKED;
+
+#define HOST_CONTEXT(p_ctx_ctrl)                                        \
+    ((struct host_context_t *)(uintptr_t)                               \
+                    ((struct context_ctrl_t *)(p_ctx_ctrl))->sp)
+
+static void host_thread_entry(uint32_t pfn, uint32_t param, uint32_t pfnlr)
+{
+    ((thrd_fn_t)(uintptr_t)pfn)((void *)(uintptr_t)param);
+
+    /* Threads returning to a valid position continue there, like LR. */
+    if (pfnlr != (uint32_t)(uintptr_t)THRD_GENERAL_EXIT) {
+        ((void (*)(void))(uintptr_t)pfnlr)();
+    }
+
+    tfm_core_panic();
+}
+
+void tfm_arch_host_pendsv_check(void)
+{
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+    AAPCS_DUAL_U32_T ctx_ctrls;
+    struct host_context_t *p_curr, *p_next;
+
+    if (!pendsv_pending || tfm_arch_host_primask ||
+        tfm_arch_host_exc_num != EXC_NUM_THREAD_MODE) {
+        return;
+    }
+
+    pendsv_pending = false;
+
+    AAPCS_DUAL_U32_AS_U64(ctx_ctrls) = ipc_schedule();
+    if (ctx_ctrls.u32_regs.r0 == ctx_ctrls.u32_regs.r1) {
+        return;
+    }
+
+    p_curr = HOST_CONTEXT((uintptr_t)ctx_ctrls.u32_regs.r0);
+    p_next = HOST_CONTEXT((uintptr_t)ctx_ctrls.u32_regs.r1);
+
+    /* Execution continues here when the current thread is scheduled again */
+    if (swapcontext(&p_curr->uc, &p_next->uc) != 0) {
+        tfm_core_panic();
+    }
+#endif
+}
+
+void tfm_arch_free_msp_and_exc_ret(uint32_t msp_base, uint32_t exc_return)
+{
+    (void)msp_base;
+    (void)exc_return;
+
+    if (!p_hw_context) {
+        tfm_core_panic();
+    }
+
+    /*
+     * 'Return' to thread mode with interrupts enabled. The PendSV triggered
+     * by the scheduler start is served first, as on target, and it does not
+     * switch away from the context loaded already.
+     */
+    tfm_arch_host_exc_num = EXC_NUM_THREAD_MODE;
+    __restore_irq(0);
+
+    setcontext(&p_hw_context->uc);
+
+    /* setcontext() does not return on success */
+    tfm_core_panic();
+}
+
+#if CONFIG_TFM_SPM_BACKEND_IPC == 1
+void tfm_arch_set_context_ret_code(void *p_ctx_ctrl, uint32_t ret_code)
+{
+    struct context_ctrl_t *ctx_ctrl = (struct context_ctrl_t *)p_ctx_ctrl;
+
+    /* Only the cross call ABI is simulated, which returns through the frame */
+    if (!ctx_ctrl->cross_frame) {
+        tfm_core_panic();
+    }
+
+    ((struct cross_call_abi_frame_t *)(uintptr_t)ctx_ctrl->cross_frame)->a0 =
+                                                                    ret_code;
+    ctx_ctrl->retcode_status = CROSS_RETCODE_UPDATED;
+}
+
+uint32_t tfm_arch_trigger_pendsv(void)
+{
+    pendsv_pending = true;
+    tfm_arch_host_pendsv_check();
+
+    return 0;
+}
+#endif
+
+void tfm_arch_init_context(void *p_ctx_ctrl,
+                           uintptr_t pfn, void *param, uintptr_t pfnlr)
+{
+    struct context_ctrl_t *ctx_ctrl = (struct context_ctrl_t *)p_ctx_ctrl;
+    struct host_context_t *p_hctx;
+
+    if (host_context_count >= TFM_HOST_THREAD_NUM_MAX) {
+        tfm_core_panic();
+    }
+
+    p_hctx = &host_contexts[host_context_count++];
+
+    if (getcontext(&p_hctx->uc) != 0) {
+        tfm_core_panic();
+    }
+
+    p_hctx->uc.uc_stack.ss_sp = p_hctx->stack;
+    p_hctx->uc.uc_stack.ss_size = sizeof(p_hctx->stack);
+    p_hctx->uc.uc_link = NULL;
+
+    makecontext(&p_hctx->uc, (void (*)(void))host_thread_entry, 3,
+                (uint32_t)pfn, (uint32_t)(uintptr_t)param, (uint32_t)pfnlr);
+
+    ctx_ctrl->exc_ret = EXC_RETURN_THREAD_S_PSP;
+    ctx_ctrl->sp      = (uint32_t)(uintptr_t)p_hctx;
+}
+
+uint32_t tfm_arch_refresh_hardware_context(void *p_ctx_ctrl)
+{
+    p_hw_context = HOST_CONTEXT(p_ctx_ctrl);
+
+    return ((struct context_ctrl_t *)p_ctx_ctrl)->exc_ret;
+}
+
+#if CONFIG_TFM_PSA_API_CROSS_CALL == 1
+psa_status_t cross_call_entering_c(uintptr_t fn_addr, uintptr_t frame_addr);
+void cross_call_exiting_c(psa_status_t status, uintptr_t frame_addr);
+
+/*
+ * Same sequence as the Arm implementations. The call is not moved to the SPM
+ * stack since the host stacks are large enough.
+ */
+void arch_non_preempt_call(uintptr_t fn_addr, uintptr_t frame_addr,
+                           uint32_t stk_base, uint32_t stk_limit)
+{
+    psa_status_t status;
+
+    (void)stk_base;
+    (void)stk_limit;
+
+    tfm_arch_host_primask = 1;
+    scheduler_lock = SCHEDULER_LOCKED;
+    __restore_irq(0);
+
+    status = cross_call_entering_c(fn_addr, frame_addr);
+
+    tfm_arch_host_primask = 1;
+    cross_call_exiting_c(status, frame_addr);
+    scheduler_lock = SCHEDULER_UNLOCKED;
+
+    /* A pending schedule happens here, as PendSV does on target */
+    __restore_irq(0);
+}
+#endif
+
+void tfm_arch_set_secure_exception_priorities(void)
+{
+}
+
+void tfm_arch_config_extensions(void)
+{
+}
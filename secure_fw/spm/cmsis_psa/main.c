@@ -7,6 +7,7 @@
 
 #include "build_config_check.h"
 #include "fih.h"
+#include "ffm/spm_boot_ts.h"
 #include "ffm/tfm_boot_data.h"
 #include "region.h"
 #include "spm_ipc.h"
@@ -46,6 +47,8 @@ static fih_int tfm_core_init(void)
         FIH_RET(fih_int_encode(TFM_ERROR_GENERIC));
     }
 
+    SPM_BOOT_TS_RECORD(BOOT_TS_PLATFORM_INIT_DONE, 0);
+
     plat_err = tfm_plat_otp_init();
     if (plat_err != TFM_PLAT_ERR_SUCCESS) {
         FIH_RET(fih_int_encode(TFM_ERROR_GENERIC));
@@ -61,6 +64,8 @@ static fih_int tfm_core_init(void)
         tfm_plat_provisioning_check_for_dummy_keys();
     }
 
+    SPM_BOOT_TS_RECORD(BOOT_TS_OTP_INIT_DONE, 0);
+
     /* Configures architecture */
     tfm_arch_config_extensions();
 
@@ -90,6 +95,8 @@ int main(void)
     tfm_arch_set_msplim((uint32_t)&REGION_NAME(Image$$, ARM_LIB_STACK,
                                                                    $$ZI$$Base));
 
+    SPM_BOOT_TS_RECORD(BOOT_TS_STAGE_ENTRY, 0);
+
     fih_delay_init();
 
     FIH_CALL(tfm_core_init, fih_rc);
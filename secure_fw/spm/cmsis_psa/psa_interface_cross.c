@@ -12,6 +12,7 @@
 #include "spm_ipc.h"
 #include "svc_num.h"
 #include "tfm_psa_call_pack.h"
+#include "tfm_psa_rw_vec.h"
 #include "psa/client.h"
 #include "psa/lifecycle.h"
 #include "psa/service.h"
@@ -163,6 +164,40 @@ void psa_write_cross(psa_handle_t msg_handle, uint32_t outvec_idx,
     );
 }
 
+__naked
+__section(".psa_interface_cross_call")
+size_t tfm_psa_read_vec_cross(psa_handle_t msg_handle,
+                              struct tfm_psa_rw_seg_t *segs,
+                              uint32_t num_segs)
+{
+    __asm volatile(
+#if !defined(__ICCARM__)
+        ".syntax unified                                    \n"
+#endif
+        "push   {r0-r4, lr}                                 \n"
+        "ldr    r0, =tfm_spm_partition_psa_read_vec         \n"
+        "mov    r1, sp                                      \n"
+        "b      psa_interface_cross_unified_entry           \n"
+    );
+}
+
+__naked
+__section(".psa_interface_cross_call")
+void tfm_psa_write_vec_cross(psa_handle_t msg_handle,
+                             const struct tfm_psa_rw_seg_t *segs,
+                             uint32_t num_segs)
+{
+    __asm volatile(
+#if !defined(__ICCARM__)
+        ".syntax unified                                    \n"
+#endif
+        "push   {r0-r4, lr}                                 \n"
+        "ldr    r0, =tfm_spm_partition_psa_write_vec        \n"
+        "mov    r1, sp                                      \n"
+        "b      psa_interface_cross_unified_entry           \n"
+    );
+}
+
 __naked
 __section(".psa_interface_cross_call")
 void psa_reply_cross(psa_handle_t msg_handle, psa_status_t status)
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "config_spm.h"
+#include "ffm/psa_api.h"
+#include "spm_ipc.h"
+#include "tfm_arch.h"
+#include "tfm_psa_call_pack.h"
+#include "tfm_psa_rw_vec.h"
+#include "psa/client.h"
+#include "psa/lifecycle.h"
+#include "psa/service.h"
+
+/*
+ * Cross call ABI veneers of the host simulation build. They build the same
+ * frame as the assembly veneers in 'psa_interface_cross.c' and enter the
+ * common dispatcher. The return value is collected from the frame, as it may
+ * be updated while the caller is blocked.
+ */
+
+void spm_interface_cross_dispatcher(uintptr_t fn_addr, uintptr_t frame_addr);
+
+static uint32_t psa_interface_cross_unified_entry(uintptr_t fn_addr,
+                                                  uint32_t a0, uint32_t a1,
+                                                  uint32_t a2, uint32_t a3)
+{
+    struct cross_call_abi_frame_t frame = {
+        .a0 = a0,
+        .a1 = a1,
+        .a2 = a2,
+        .a3 = a3,
+    };
+
+    spm_interface_cross_dispatcher(fn_addr, (uintptr_t)&frame);
+
+    return frame.a0;
+}
+
+#define CROSS_CALL(fn, a0, a1, a2, a3)                                  \
+    psa_interface_cross_unified_entry((uintptr_t)(fn),                  \
+                                      (uint32_t)(uintptr_t)(a0),        \
+                                      (uint32_t)(uintptr_t)(a1),        \
+                                      (uint32_t)(uintptr_t)(a2),        \
+                                      (uint32_t)(uintptr_t)(a3))
+
+uint32_t psa_framework_version_cross(void)
+{
+    return (uint32_t)CROSS_CALL(tfm_spm_client_psa_framework_version,
+                                0, 0, 0, 0);
+}
+
+uint32_t psa_version_cross(uint32_t sid)
+{
+    return (uint32_t)CROSS_CALL(tfm_spm_client_psa_version, sid, 0, 0, 0);
+}
+
+psa_status_t tfm_psa_call_pack_cross(psa_handle_t handle,
+                                     uint32_t ctrl_param,
+                                     const psa_invec *in_vec,
+                                     psa_outvec *out_vec)
+{
+    return (psa_status_t)CROSS_CALL(tfm_spm_client_psa_call,
+                                    handle, ctrl_param, in_vec, out_vec);
+}
+
+psa_signal_t psa_wait_cross(psa_signal_t signal_mask, uint32_t timeout)
+{
+    return (psa_signal_t)CROSS_CALL(tfm_spm_partition_psa_wait,
+                                    signal_mask, timeout, 0, 0);
+}
+
+psa_status_t psa_get_cross(psa_signal_t signal, psa_msg_t *msg)
+{
+    return (psa_status_t)CROSS_CALL(tfm_spm_partition_psa_get,
+                                    signal, msg, 0, 0);
+}
+
+size_t psa_read_cross(psa_handle_t msg_handle, uint32_t invec_idx,
+                      void *buffer, size_t num_bytes)
+{
+    return (size_t)CROSS_CALL(tfm_spm_partition_psa_read,
+                              msg_handle, invec_idx, buffer, num_bytes);
+}
+
+size_t psa_skip_cross(psa_handle_t msg_handle,
+                      uint32_t invec_idx, size_t num_bytes)
+{
+    return (size_t)CROSS_CALL(tfm_spm_partition_psa_skip,
+                              msg_handle, invec_idx, num_bytes, 0);
+}
+
+void psa_write_cross(psa_handle_t msg_handle, uint32_t outvec_idx,
+                     const void *buffer, size_t num_bytes)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_write,
+                     msg_handle, outvec_idx, buffer, num_bytes);
+}
+
+size_t tfm_psa_read_vec_cross(psa_handle_t msg_handle,
+                              struct tfm_psa_rw_seg_t *segs,
+                              uint32_t num_segs)
+{
+    return (size_t)CROSS_CALL(tfm_spm_partition_psa_read_vec,
+                              msg_handle, segs, num_segs, 0);
+}
+
+void tfm_psa_write_vec_cross(psa_handle_t msg_handle,
+                             const struct tfm_psa_rw_seg_t *segs,
+                             uint32_t num_segs)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_write_vec,
+                     msg_handle, segs, num_segs, 0);
+}
+
+void psa_reply_cross(psa_handle_t msg_handle, psa_status_t status)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_reply, msg_handle, status, 0, 0);
+}
+
+#if CONFIG_TFM_DOORBELL_API == 1
+void psa_notify_cross(int32_t partition_id)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_notify, partition_id, 0, 0, 0);
+}
+
+void psa_clear_cross(void)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_clear, 0, 0, 0, 0);
+}
+#endif /* CONFIG_TFM_DOORBELL_API == 1 */
+
+void psa_panic_cross(void)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_panic, 0, 0, 0, 0);
+}
+
+uint32_t psa_rot_lifecycle_state_cross(void)
+{
+    return (uint32_t)CROSS_CALL(tfm_spm_get_lifecycle_state, 0, 0, 0, 0);
+}
+
+#if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
+psa_handle_t psa_connect_cross(uint32_t sid, uint32_t version)
+{
+    return (psa_handle_t)CROSS_CALL(tfm_spm_client_psa_connect,
+                                    sid, version, 0, 0);
+}
+
+void psa_close_cross(psa_handle_t handle)
+{
+    (void)CROSS_CALL(tfm_spm_client_psa_close, handle, 0, 0, 0);
+}
+
+void psa_set_rhandle_cross(psa_handle_t msg_handle, void *rhandle)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_set_rhandle,
+                     msg_handle, rhandle, 0, 0);
+}
+#endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API */
+
+#if CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1
+void psa_irq_enable_cross(psa_signal_t irq_signal)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_irq_enable, irq_signal, 0, 0, 0);
+}
+
+psa_irq_status_t psa_irq_disable_cross(psa_signal_t irq_signal)
+{
+    return (psa_irq_status_t)CROSS_CALL(tfm_spm_partition_psa_irq_disable,
+                                        irq_signal, 0, 0, 0);
+}
+
+#if CONFIG_TFM_FLIH_API == 1
+void psa_reset_signal_cross(psa_signal_t irq_signal)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_reset_signal, irq_signal, 0, 0, 0);
+}
+#endif /* CONFIG_TFM_FLIH_API == 1 */
+
+#if CONFIG_TFM_SLIH_API == 1
+void psa_eoi_cross(psa_signal_t irq_signal)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_eoi, irq_signal, 0, 0, 0);
+}
+#endif /* CONFIG_TFM_SLIH_API */
+#endif /* CONFIG_TFM_FLIH_API == 1 || CONFIG_TFM_SLIH_API == 1 */
+
+#if PSA_FRAMEWORK_HAS_MM_IOVEC
+const void *psa_map_invec_cross(psa_handle_t msg_handle, uint32_t invec_idx)
+{
+    return (const void *)CROSS_CALL(tfm_spm_partition_psa_map_invec,
+                                    msg_handle, invec_idx, 0, 0);
+}
+
+void psa_unmap_invec_cross(psa_handle_t msg_handle, uint32_t invec_idx)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_unmap_invec,
+                     msg_handle, invec_idx, 0, 0);
+}
+
+void *psa_map_outvec_cross(psa_handle_t msg_handle, uint32_t outvec_idx)
+{
+    return (void *)CROSS_CALL(tfm_spm_partition_psa_map_outvec,
+                              msg_handle, outvec_idx, 0, 0);
+}
+
+void psa_unmap_outvec_cross(psa_handle_t msg_handle, uint32_t outvec_idx,
+                            size_t len)
+{
+    (void)CROSS_CALL(tfm_spm_partition_psa_unmap_outvec,
+                     msg_handle, outvec_idx, len, 0);
+}
+#endif /* PSA_FRAMEWORK_HAS_MM_IOVEC */
@@ -8,6 +8,7 @@
 #include <stdint.h>
 #include "current.h"
 #include "tfm_psa_call_pack.h"
+#include "tfm_psa_rw_vec.h"
 #include "ffm/backend.h"
 #include "ffm/psa_api.h"
 #include "psa/client.h"
@@ -94,6 +95,29 @@ void psa_write_sfn(psa_handle_t msg_handle, uint32_t outvec_idx,
     tfm_spm_partition_psa_write(msg_handle, outvec_idx, buffer, num_bytes);
 }
 
+size_t tfm_psa_read_vec_sfn(psa_handle_t msg_handle,
+                            struct tfm_psa_rw_seg_t *segs, uint32_t num_segs)
+{
+    if (__get_active_exc_num() != EXC_NUM_THREAD_MODE) {
+        /* PSA APIs must be called from Thread mode */
+        tfm_core_panic();
+    }
+
+    return tfm_spm_partition_psa_read_vec(msg_handle, segs, num_segs);
+}
+
+void tfm_psa_write_vec_sfn(psa_handle_t msg_handle,
+                           const struct tfm_psa_rw_seg_t *segs,
+                           uint32_t num_segs)
+{
+    if (__get_active_exc_num() != EXC_NUM_THREAD_MODE) {
+        /* PSA APIs must be called from Thread mode */
+        tfm_core_panic();
+    }
+
+    tfm_spm_partition_psa_write_vec(msg_handle, segs, num_segs);
+}
+
 void psa_panic_sfn(void)
 {
     if (__get_active_exc_num() != EXC_NUM_THREAD_MODE) {
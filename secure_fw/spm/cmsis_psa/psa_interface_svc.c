@@ -10,6 +10,7 @@
 #include "config_spm.h"
 #include "svc_num.h"
 #include "tfm_psa_call_pack.h"
+#include "tfm_psa_rw_vec.h"
 #include "utilities.h"
 #include "psa/client.h"
 #include "psa/lifecycle.h"
@@ -69,6 +70,22 @@ __naked void psa_write_svc(psa_handle_t msg_handle, uint32_t outvec_idx,
                    "bx      lr                                 \n");
 }
 
+__naked size_t tfm_psa_read_vec_svc(psa_handle_t msg_handle,
+                                    struct tfm_psa_rw_seg_t *segs,
+                                    uint32_t num_segs)
+{
+    __asm volatile("svc     "M2S(TFM_SVC_PSA_READ_VEC)"        \n"
+                   "bx      lr                                 \n");
+}
+
+__naked void tfm_psa_write_vec_svc(psa_handle_t msg_handle,
+                                   const struct tfm_psa_rw_seg_t *segs,
+                                   uint32_t num_segs)
+{
+    __asm volatile("svc     "M2S(TFM_SVC_PSA_WRITE_VEC)"       \n"
+                   "bx      lr                                 \n");
+}
+
 __naked void psa_reply_svc(psa_handle_t msg_handle, psa_status_t retval)
 {
     __asm volatile("svc     "M2S(TFM_SVC_PSA_REPLY)"           \n"
@@ -36,6 +36,8 @@
 #include "region.h"
 #include "psa_manifest/pid.h"
 #include "ffm/backend.h"
+#include "ffm/spm_boot_ts.h"
+#include "ffm/spm_profiler.h"
 #include "load/partition_defs.h"
 #include "load/service_defs.h"
 #include "load/asset_defs.h"
@@ -56,89 +58,76 @@ TFM_POOL_DECLARE(conn_handle_pool, sizeof(struct conn_handle_t),
 
 /*********************** Connection handle conversion APIs *******************/
 
-#define CONVERSION_FACTOR_BITOFFSET    3
-#define CONVERSION_FACTOR_VALUE        (1 << CONVERSION_FACTOR_BITOFFSET)
-/* Set 32 as the maximum */
-#define CONVERSION_FACTOR_VALUE_MAX    0x20
-
-#if CONVERSION_FACTOR_VALUE > CONVERSION_FACTOR_VALUE_MAX
-#error "CONVERSION FACTOR OUT OF RANGE"
-#endif
-
-static uint32_t loop_index;
-
 /*
- * A handle instance psa_handle_t allocated inside SPM is actually a memory
- * address among the handle pool. Return this handle to the client directly
- * exposes information of secure memory address. In this case, converting the
- * handle into another value does not represent the memory address to avoid
- * exposing secure memory directly to clients.
+ * A handle instance allocated inside SPM is a memory address among the handle
+ * pool. Returning it to the client directly exposes secure memory addresses,
+ * so the SPM hands out a user handle instead, which encodes the pool chunk
+ * index and a generation tag:
  *
- * This function converts the handle instance into another value by scaling the
- * handle in pool offset, the converted value is named as a user handle.
+ *  user_handle = ((generation << CONN_HANDLE_IDX_BIT_WIDTH) | index) +
+ *                CLIENT_HANDLE_VALUE_MIN
  *
- * The formula:
- *  user_handle = (handle_instance - POOL_START) * CONVERSION_FACTOR_VALUE +
- *                CLIENT_HANDLE_VALUE_MIN + loop_index
- * where:
- *  CONVERSION_FACTOR_VALUE = 1 << CONVERSION_FACTOR_BITOFFSET, and should not
- *  exceed CONVERSION_FACTOR_VALUE_MAX.
- *
- *  handle_instance in RANGE[POOL_START, POOL_END]
+ *  index           in RANGE[0, CONFIG_TFM_CONN_HANDLE_MAX_NUM - 1]
+ *  generation      in RANGE[0, CONN_HANDLE_GEN_MASK]
  *  user_handle     in RANGE[CLIENT_HANDLE_VALUE_MIN, 0x3FFFFFFF]
- *  loop_index      in RANGE[0, CONVERSION_FACTOR_VALUE - 1]
  *
- *  note:
- *  loop_index is used to promise same handle instance is converted into
- *  different user handles in short time.
+ * The generation is bumped on every handle creation, and the user handle
+ * currently bound to each pool chunk is recorded in 'conn_user_handles'. A
+ * freed chunk records PSA_NULL_HANDLE. Converting a user handle back into a
+ * handle instance is then one bounds check on the index plus one comparison
+ * against the recorded user handle, which also rejects stale handles referring
+ * to a chunk that has been freed or reused since.
  */
-psa_handle_t tfm_spm_to_user_handle(struct conn_handle_t *handle_instance)
-{
-    psa_handle_t user_handle;
+#define CONN_HANDLE_IDX_BIT_WIDTH       8
+#define CONN_HANDLE_IDX_MASK            ((1UL << CONN_HANDLE_IDX_BIT_WIDTH) - 1)
+#define CONN_HANDLE_GEN_BIT_WIDTH       21
+#define CONN_HANDLE_GEN_MASK            ((1UL << CONN_HANDLE_GEN_BIT_WIDTH) - 1)
+
+#define CONN_HANDLE_ENCODE(index, gen)                                  \
+    ((psa_handle_t)((((uint32_t)(gen) << CONN_HANDLE_IDX_BIT_WIDTH) |   \
+                     (uint32_t)(index)) + CLIENT_HANDLE_VALUE_MIN))
+#define CONN_HANDLE_GET_INDEX(user_handle)                              \
+    (((uint32_t)(user_handle) - CLIENT_HANDLE_VALUE_MIN) & CONN_HANDLE_IDX_MASK)
+
+#if CONFIG_TFM_CONN_HANDLE_MAX_NUM > (CONN_HANDLE_IDX_MASK + 1)
+#error "CONFIG_TFM_CONN_HANDLE_MAX_NUM exceeds the handle index range."
+#endif
 
-    loop_index = (loop_index + 1) % CONVERSION_FACTOR_VALUE;
-    user_handle = (psa_handle_t)((((uintptr_t)handle_instance -
-                  (uintptr_t)conn_handle_pool) << CONVERSION_FACTOR_BITOFFSET) +
-                  CLIENT_HANDLE_VALUE_MIN + loop_index);
+/* User handle currently bound to each chunk of the connection handle pool */
+static psa_handle_t conn_user_handles[CONFIG_TFM_CONN_HANDLE_MAX_NUM];
+static uint32_t conn_handle_generation;
 
-    return user_handle;
+psa_handle_t tfm_spm_to_user_handle(struct conn_handle_t *handle_instance)
+{
+    return conn_user_handles[tfm_pool_chunk_index(conn_handle_pool,
+                                                  handle_instance)];
 }
 
-/*
- * This function converts a user handle into a corresponded handle instance.
- * The converted value is validated before returning, an invalid handle instance
- * is returned as NULL.
- *
- * The formula:
- *  handle_instance = ((user_handle - CLIENT_HANDLE_VALUE_MIN) /
- *                    CONVERSION_FACTOR_VALUE) + POOL_START
- * where:
- *  CONVERSION_FACTOR_VALUE = 1 << CONVERSION_FACTOR_BITOFFSET, and should not
- *  exceed CONVERSION_FACTOR_VALUE_MAX.
- *
- *  handle_instance in RANGE[POOL_START, POOL_END]
- *  user_handle     in RANGE[CLIENT_HANDLE_VALUE_MIN, 0x3FFFFFFF]
- *  loop_index      in RANGE[0, CONVERSION_FACTOR_VALUE - 1]
- */
 struct conn_handle_t *tfm_spm_to_handle_instance(psa_handle_t user_handle)
 {
-    struct conn_handle_t *handle_instance;
+    uint32_t index;
 
     if (user_handle == PSA_NULL_HANDLE) {
         return NULL;
     }
 
-    handle_instance = (struct conn_handle_t *)((((uintptr_t)user_handle -
-                      CLIENT_HANDLE_VALUE_MIN) >> CONVERSION_FACTOR_BITOFFSET) +
-                      (uintptr_t)conn_handle_pool);
+    index = CONN_HANDLE_GET_INDEX(user_handle);
+    if (index >= CONFIG_TFM_CONN_HANDLE_MAX_NUM) {
+        return NULL;
+    }
+
+    if (conn_user_handles[index] != user_handle) {
+        return NULL;
+    }
 
-    return handle_instance;
+    return (struct conn_handle_t *)tfm_pool_chunk_data(conn_handle_pool, index);
 }
 
 /* Service handle management functions */
 struct conn_handle_t *tfm_spm_create_conn_handle(void)
 {
     struct conn_handle_t *p_handle;
+    size_t index;
 
     /* Get buffer for handle list structure from handle pool */
     p_handle = (struct conn_handle_t *)tfm_pool_alloc(conn_handle_pool);
@@ -150,18 +139,14 @@ struct conn_handle_t *tfm_spm_create_conn_handle(void)
 
     p_handle->status = TFM_HANDLE_STATUS_IDLE;
 
-    return p_handle;
-}
+    /* Bind a new generation of user handle to the chunk */
+    conn_handle_generation = (conn_handle_generation + 1) &
+                             CONN_HANDLE_GEN_MASK;
+    index = tfm_pool_chunk_index(conn_handle_pool, p_handle);
+    conn_user_handles[index] = CONN_HANDLE_ENCODE(index,
+                                                  conn_handle_generation);
 
-psa_status_t tfm_spm_validate_conn_handle(const struct conn_handle_t *handle)
-{
-    /* Check the handle address is valid */
-    if (is_valid_chunk_data_in_pool(conn_handle_pool,
-                                    (uint8_t *)handle) != true) {
-        return SPM_ERROR_GENERIC;
-    }
-
-    return PSA_SUCCESS;
+    return p_handle;
 }
 
 void tfm_spm_free_conn_handle(struct conn_handle_t *conn_handle)
@@ -171,6 +156,9 @@ void tfm_spm_free_conn_handle(struct conn_handle_t *conn_handle)
     SPM_ASSERT(conn_handle != NULL);
 
     CRITICAL_SECTION_ENTER(cs_assert);
+    /* Invalidate the user handle bound to it */
+    conn_user_handles[tfm_pool_chunk_index(conn_handle_pool, conn_handle)] =
+                                                            PSA_NULL_HANDLE;
     /* Back handle buffer to pool */
     tfm_pool_free(conn_handle_pool, conn_handle);
     CRITICAL_SECTION_LEAVE(cs_assert);
@@ -315,7 +303,7 @@ struct conn_handle_t *spm_get_handle_by_client_handle(psa_handle_t handle,
 {
     struct conn_handle_t *p_conn_handle = tfm_spm_to_handle_instance(handle);
 
-    if (tfm_spm_validate_conn_handle(p_conn_handle) != PSA_SUCCESS) {
+    if (!p_conn_handle) {
         return NULL;
     }
 
@@ -333,8 +321,8 @@ struct conn_handle_t *spm_get_handle_by_msg_handle(psa_handle_t msg_handle)
     /*
      * The message handler passed by the caller is considered invalid in the
      * following cases:
-     *   1. Not a valid message handle. (The address of a message is not the
-     *      address of a possible handle from the pool
+     *   1. Not a valid message handle. (It does not match the user handle
+     *      currently bound to a handle from the pool)
      *   2. Handle not belongs to the caller partition (The handle is either
      *      unused, or owned by another partition)
      * Check the conditions above
@@ -343,7 +331,7 @@ struct conn_handle_t *spm_get_handle_by_msg_handle(psa_handle_t msg_handle)
     struct conn_handle_t *p_conn_handle =
                                     tfm_spm_to_handle_instance(msg_handle);
 
-    if (tfm_spm_validate_conn_handle(p_conn_handle) != PSA_SUCCESS) {
+    if (!p_conn_handle) {
         return NULL;
     }
 
@@ -401,6 +389,8 @@ void spm_fill_message(struct conn_handle_t *conn_handle,
     conn_handle->msg.handle = handle;
     conn_handle->msg.rhandle = conn_handle->rhandle;
 
+    SPM_PROF_MSG_QUEUED(conn_handle);
+
     /* Set the private data of NSPE client caller in multi-core topology */
     if (TFM_CLIENT_ID_IS_NS(client_id)) {
         tfm_rpc_set_caller_data(conn_handle, client_id);
@@ -465,6 +455,8 @@ uint32_t tfm_spm_init(void)
     /* Init the nonsecure context. */
     tfm_nspm_ctx_init();
 
+    spm_prof_init();
+
     while (1) {
         partition = load_a_partition_assuredly(PARTITION_LIST_ADDR);
         if (partition == NO_MORE_PARTITION) {
@@ -489,6 +481,8 @@ uint32_t tfm_spm_init(void)
         backend_init_comp_assuredly(partition, service_setting);
     }
 
+    SPM_BOOT_TS_RECORD(BOOT_TS_SPM_INIT_DONE, 0);
+
     return backend_system_run();
 }
 
@@ -21,6 +21,9 @@
 #include "psa/service.h"
 #include "load/partition_defs.h"
 #include "load/interrupt_defs.h"
+#ifdef CONFIG_TFM_SPM_PROFILING
+#include "ffm/spm_profiler.h"
+#endif
 
 #define TFM_HANDLE_STATUS_IDLE          0 /* Handle created             */
 #define TFM_HANDLE_STATUS_ACTIVE        1 /* Handle in use              */
@@ -107,6 +110,9 @@ struct conn_handle_t {
 #endif
 #if PSA_FRAMEWORK_HAS_MM_IOVEC
     uint32_t iovec_status;              /* MM-IOVEC status                */
+#endif
+#ifdef CONFIG_TFM_SPM_PROFILING
+    struct spm_prof_msg_t prof;         /* Profiling timestamps           */
 #endif
     struct conn_handle_t *p_handles;    /* Handle(s) link                 */
 };
@@ -126,6 +132,12 @@ struct partition_t {
     struct thread_t                    thrd;            /* IPC model */
 #else
     uint32_t                           state;           /* SFN model */
+#endif
+#ifdef CONFIG_TFM_SPM_PROFILING
+    struct spm_prof_partition_t        prof;
+#endif
+#ifdef TFM_BOOT_TIMESTAMPS
+    uint32_t                           boot_ts_state;   /* Init checkpoints */
 #endif
     struct conn_handle_t               *p_handles;
     struct partition_t                 *next;
@@ -135,6 +147,9 @@ struct partition_t {
 struct service_t {
     const struct service_load_info_t *p_ldinf;     /* Service load info      */
     struct partition_t *partition;                 /* Owner of the service   */
+#ifdef CONFIG_TFM_SPM_PROFILING
+    struct spm_prof_service_t prof;                /* Profiling counters     */
+#endif
     struct service_t *next;                        /* For list operation     */
 };
 
@@ -155,16 +170,6 @@ int32_t tfm_spm_partition_get_running_partition_id(void);
  */
 struct conn_handle_t *tfm_spm_create_conn_handle(void);
 
-/**
- * \brief                   Validate connection handle for client connect
- *
- * \param[in] conn_handle   Handle to be validated
- *
- * \retval PSA_SUCCESS        Success
- * \retval SPM_ERROR_GENERIC  Invalid handle
- */
-psa_status_t tfm_spm_validate_conn_handle(const struct conn_handle_t *conn_handle);
-
 /**
  * \brief                   Free connection handle which not used anymore.
  *
@@ -351,6 +356,9 @@ psa_handle_t tfm_spm_to_user_handle(struct conn_handle_t *handle_instance);
 
 /**
  * \brief Converts a user handle into a corresponded handle instance.
+ *
+ * \retval NULL             The user handle is not bound to a live handle
+ * \retval "Not NULL"       The handle instance bound to the user handle
  */
 struct conn_handle_t *tfm_spm_to_handle_instance(psa_handle_t user_handle);
 
@@ -19,6 +19,7 @@
 #include "ffm/interrupt.h"
 #include "ffm/tfm_boot_data.h"
 #include "ffm/psa_api.h"
+#include "ffm/spm_profiler.h"
 #include "tfm_hal_isolation.h"
 #include "tfm_hal_spm_logdev.h"
 #include "load/partition_defs.h"
@@ -59,6 +60,15 @@ static int32_t SVC_Handler_IPC(uint8_t svc_num, uint32_t *ctx,
         tfm_spm_partition_psa_write((psa_handle_t)ctx[0], ctx[1],
                                     (void *)ctx[2], (size_t)ctx[3]);
         break;
+    case TFM_SVC_PSA_READ_VEC:
+        return tfm_spm_partition_psa_read_vec((psa_handle_t)ctx[0],
+                                              (struct tfm_psa_rw_seg_t *)ctx[1],
+                                              ctx[2]);
+    case TFM_SVC_PSA_WRITE_VEC:
+        tfm_spm_partition_psa_write_vec((psa_handle_t)ctx[0],
+                                        (const struct tfm_psa_rw_seg_t *)ctx[1],
+                                        ctx[2]);
+        break;
 #if CONFIG_TFM_DOORBELL_API == 1
     case TFM_SVC_PSA_NOTIFY:
         tfm_spm_partition_psa_notify((int32_t)ctx[0]);
@@ -185,6 +195,11 @@ uint32_t tfm_core_svc_handler(uint32_t *msp, uint32_t exc_return,
                                             (struct context_flih_ret_t *)msp);
         break;
 #endif
+#ifdef CONFIG_TFM_SPM_PROFILING
+    case TFM_SVC_SPM_PROFILER_DUMP:
+        tfm_spm_profiler_dump_handler(svc_args);
+        break;
+#endif
 #if TFM_SP_LOG_RAW_ENABLED
     case TFM_SVC_OUTPUT_UNPRIV_STRING:
         svc_args[0] = tfm_hal_output_spm_log((const char *)svc_args[0],
@@ -126,4 +126,50 @@ int32_t tfm_inter_core_comm_init(void);
 enum tfm_status_e check_address_range(const void *p, size_t s,
                                       uintptr_t region_start,
                                       uintptr_t region_limit);
+
+/* NUM_MAILBOX_SHM_BUF is defined in tfm_mailbox_config.h */
+#if NUM_MAILBOX_SHM_BUF > 0
+/**
+ * \brief Register a non-secure shared memory buffer.
+ *
+ * \param[in]  p             The base address of the buffer
+ * \param[in]  s             The size of the buffer
+ * \param[in]  flags         The memory access types granted on the buffer. It
+ *                           must contain \ref MEM_CHECK_NONSECURE.
+ * \param[out] shm_id        The ID assigned to the buffer. Always positive.
+ *
+ * \return TFM_SUCCESS if the whole buffer passes the access check with
+ *         \p flags and is registered,
+ *         TFM_ERROR_GENERIC otherwise.
+ */
+enum tfm_status_e tfm_multi_core_shm_register(const void *p, size_t s,
+                                              uint32_t flags,
+                                              int32_t *shm_id);
+
+/**
+ * \brief Unregister a non-secure shared memory buffer.
+ *
+ * \param[in] shm_id         The ID of the buffer
+ *
+ * \return TFM_SUCCESS if the buffer is unregistered,
+ *         TFM_ERROR_GENERIC otherwise.
+ */
+enum tfm_status_e tfm_multi_core_shm_unregister(int32_t shm_id);
+
+/**
+ * \brief Select the shared memory buffer used by the following access checks
+ *        of the current PSA client call.
+ *
+ * \details While a buffer is selected, \ref tfm_has_access_to_region accepts
+ *          a non-secure range inside that buffer after a bounds check only.
+ *
+ * \param[in] shm_id         The ID of the buffer, or \ref MAILBOX_SHM_NULL_ID
+ *                           to deselect.
+ *
+ * \return TFM_SUCCESS if the buffer is selected,
+ *         TFM_ERROR_GENERIC if \p shm_id doesn't refer to a registered buffer.
+ */
+enum tfm_status_e tfm_multi_core_shm_select(int32_t shm_id);
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 #endif /* __TFM_MULTI_CORE_H__ */
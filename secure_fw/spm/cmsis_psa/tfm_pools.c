@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -94,7 +94,7 @@ bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
     }
 
     pool_chunk_address =
-        (uint32_t)TO_CONTAINER(data, struct tfm_pool_chunk_t, data);
+        (uintptr_t)TO_CONTAINER(data, struct tfm_pool_chunk_t, data);
 
     /* Make sure that the chunk containing the message is aligned on */
     /* chunk boundary in the pool. */
@@ -103,3 +103,22 @@ bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
     }
     return true;
 }
+
+size_t tfm_pool_chunk_index(const struct tfm_pool_instance_t *pool,
+                            const void *data)
+{
+    const size_t chunks_size = pool->chunksz + sizeof(struct tfm_pool_chunk_t);
+    uintptr_t pool_chunk_address =
+        (uintptr_t)TO_CONTAINER(data, struct tfm_pool_chunk_t, data);
+
+    return (pool_chunk_address - (uintptr_t)pool->chunks) / chunks_size;
+}
+
+void *tfm_pool_chunk_data(struct tfm_pool_instance_t *pool, size_t index)
+{
+    const size_t chunks_size = pool->chunksz + sizeof(struct tfm_pool_chunk_t);
+    struct tfm_pool_chunk_t *pchunk =
+        (struct tfm_pool_chunk_t *)&pool->chunks[chunks_size * index];
+
+    return &pchunk->data;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2018-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -97,4 +97,29 @@ void tfm_pool_free(struct tfm_pool_instance_t *pool, void *ptr);
 bool is_valid_chunk_data_in_pool(struct tfm_pool_instance_t *pool,
                                  uint8_t *data);
 
+/**
+ * \brief Get the index of a chunk in the pool by its data pointer.
+ *
+ * \param[in] pool              Pointer to memory pool declared by
+ *                              \ref TFM_POOL_DECLARE.
+ * \param[in] data              Chunk data pointer returned by
+ *                              \ref tfm_pool_alloc.
+ *
+ * \return The chunk index in RANGE[0, chunk_count - 1]. The caller must
+ *         ensure 'data' belongs to the pool.
+ */
+size_t tfm_pool_chunk_index(const struct tfm_pool_instance_t *pool,
+                            const void *data);
+
+/**
+ * \brief Get the data pointer of a chunk in the pool by its index.
+ *
+ * \param[in] pool              Pointer to memory pool declared by
+ *                              \ref TFM_POOL_DECLARE.
+ * \param[in] index             Chunk index in RANGE[0, chunk_count - 1].
+ *
+ * \return The chunk data pointer. The caller must ensure 'index' is in range.
+ */
+void *tfm_pool_chunk_data(struct tfm_pool_instance_t *pool, size_t index);
+
 #endif /* __TFM_POOLS_H__ */
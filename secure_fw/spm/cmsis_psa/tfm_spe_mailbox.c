@@ -18,6 +18,35 @@
 
 static struct secure_mailbox_queue_t spe_mailbox_queue;
 
+#if NUM_MAILBOX_SHM_BUF > 0
+static psa_status_t mailbox_shm_register(
+                                    const struct psa_client_params_t *params)
+{
+    uint32_t flags = MEM_CHECK_NONSECURE;
+    int32_t shm_id;
+
+    switch (params->shm_register_params.access) {
+    case MAILBOX_SHM_ACCESS_RO:
+        flags |= MEM_CHECK_MPU_READ;
+        break;
+    case MAILBOX_SHM_ACCESS_RW:
+        flags |= MEM_CHECK_MPU_READWRITE;
+        break;
+    default:
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (tfm_multi_core_shm_register(params->shm_register_params.base,
+                                    params->shm_register_params.size,
+                                    flags, &shm_id) != TFM_SUCCESS) {
+        return PSA_ERROR_INVALID_ARGUMENT;
+    }
+
+    /* The positive buffer ID is returned in place of the status */
+    return (psa_status_t)shm_id;
+}
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
+
 static int32_t tfm_mailbox_dispatch(uint32_t call_type,
                                     const struct psa_client_params_t *params,
                                     int32_t client_id,
@@ -45,7 +74,21 @@ static int32_t tfm_mailbox_dispatch(uint32_t call_type,
         spm_params.in_len = params->psa_call_params.in_len;
         spm_params.out_vec = params->psa_call_params.out_vec;
         spm_params.out_len = params->psa_call_params.out_len;
+#if NUM_MAILBOX_SHM_BUF > 0
+        /*
+         * The iovecs are checked when the request is delivered to SPM, so the
+         * shared memory buffer is only selected during tfm_rpc_psa_call().
+         */
+        if (tfm_multi_core_shm_select(params->psa_call_params.shm_id) !=
+                                                                TFM_SUCCESS) {
+            *psa_ret = PSA_ERROR_INVALID_ARGUMENT;
+            return MAILBOX_SUCCESS;
+        }
+        *psa_ret = tfm_rpc_psa_call(&spm_params);
+        (void)tfm_multi_core_shm_select(MAILBOX_SHM_NULL_ID);
+#else
         *psa_ret = tfm_rpc_psa_call(&spm_params);
+#endif
         return MAILBOX_SUCCESS;
 /* Following cases are only needed by connection-based services */
 #if CONFIG_TFM_CONNECTION_BASED_SERVICE_API == 1
@@ -59,6 +102,19 @@ static int32_t tfm_mailbox_dispatch(uint32_t call_type,
         tfm_rpc_psa_close(&spm_params);
         return MAILBOX_SUCCESS;
 #endif /* CONFIG_TFM_CONNECTION_BASED_SERVICE_API */
+#if NUM_MAILBOX_SHM_BUF > 0
+    case MAILBOX_SHM_REGISTER:
+        *psa_ret = mailbox_shm_register(params);
+        return MAILBOX_SUCCESS;
+    case MAILBOX_SHM_UNREGISTER:
+        if (tfm_multi_core_shm_unregister(
+                    params->shm_unregister_params.shm_id) != TFM_SUCCESS) {
+            *psa_ret = PSA_ERROR_INVALID_ARGUMENT;
+        } else {
+            *psa_ret = PSA_SUCCESS;
+        }
+        return MAILBOX_SUCCESS;
+#endif /* NUM_MAILBOX_SHM_BUF > 0 */
     default:
         return MAILBOX_INVAL_PARAMS;
     }
@@ -156,10 +212,26 @@ __STATIC_INLINE struct mailbox_reply_t *get_nspe_reply_addr(uint8_t idx)
     return &spe_mailbox_queue.ns_queue->queue[ns_slot_idx].reply;
 }
 
+static int32_t alloc_spe_queue_slot(uint8_t *idx)
+{
+    uint8_t i;
+
+    for (i = 0; i < NUM_MAILBOX_QUEUE_SLOT; i++) {
+        if (get_spe_queue_empty_status(i)) {
+            clear_spe_queue_empty_status(i);
+            *idx = i;
+            return MAILBOX_SUCCESS;
+        }
+    }
+
+    return MAILBOX_QUEUE_FULL;
+}
+
 static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 {
     struct mailbox_reply_t *reply_ptr;
     uint32_t ret_result = result;
+    uint8_t ns_slot_idx = spe_mailbox_queue.queue[idx].ns_slot_idx;
 
     /* Get reply address */
     reply_ptr = get_nspe_reply_addr(idx);
@@ -170,8 +242,43 @@ static void mailbox_direct_reply(uint8_t idx, uint32_t result)
 
     /*
      * Skip NSPE queue status update after single reply.
-     * Update NSPE queue status after all the mailbox messages are completed
+     * The replied NSPE slots are collected and NSPE queue status is updated
+     * by mailbox_flush_replies(), to notify NSPE once for multiple replies.
      */
+    tfm_mailbox_hal_enter_critical();
+    spe_mailbox_queue.reply_ns_slots |= (mailbox_queue_status_t)(1UL <<
+                                                                ns_slot_idx);
+    tfm_mailbox_hal_exit_critical();
+}
+
+/*
+ * Update the NSPE queue status with the replies collected so far and notify
+ * NSPE. The replies are held back while the NSPE queue is being drained, and
+ * flushed together when draining completes.
+ */
+static void mailbox_flush_replies(void)
+{
+    mailbox_queue_status_t reply_slots;
+    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
+
+    tfm_mailbox_hal_enter_critical();
+
+    if (spe_mailbox_queue.is_draining) {
+        tfm_mailbox_hal_exit_critical();
+        return;
+    }
+
+    reply_slots = spe_mailbox_queue.reply_ns_slots;
+    spe_mailbox_queue.reply_ns_slots = 0;
+
+    /* Set the NSPE mailbox replied status */
+    set_nspe_queue_replied_status(ns_queue, reply_slots);
+
+    tfm_mailbox_hal_exit_critical();
+
+    if (reply_slots) {
+        tfm_mailbox_hal_notify_peer();
+    }
 }
 
 __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
@@ -184,111 +291,150 @@ __STATIC_INLINE int32_t check_mailbox_msg(const struct mailbox_msg_t *msg)
     return MAILBOX_SUCCESS;
 }
 
-int32_t tfm_mailbox_handle_msg(void)
+/* Handle the message in NSPE queue slot ns_idx with SPE queue slot idx */
+static void mailbox_handle_slot(uint8_t idx, uint8_t ns_idx)
 {
-    uint8_t idx;
     int32_t result;
     psa_status_t psa_ret = PSA_ERROR_GENERIC_ERROR;
-    mailbox_queue_status_t mask_bits, pend_slots, reply_slots = 0;
     struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
     struct mailbox_msg_t *msg_ptr;
 
-    SPM_ASSERT(ns_queue != NULL);
+    spe_mailbox_queue.queue[idx].ns_slot_idx = ns_idx;
 
-    tfm_mailbox_hal_enter_critical();
+    /*
+     * The message is copied into SPE, so that it cannot be modified by NSPE
+     * after it is checked.
+     */
+    msg_ptr = &spe_mailbox_queue.queue[idx].msg;
+    spm_memcpy(msg_ptr, &ns_queue->queue[ns_idx].msg, sizeof(*msg_ptr));
 
-    pend_slots = get_nspe_queue_pend_status(ns_queue);
+    if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return;
+    }
 
-    tfm_mailbox_hal_exit_critical();
+    get_spe_mailbox_msg_handle(idx, &spe_mailbox_queue.queue[idx].msg_handle);
 
-    /* Check if NSPE mailbox did assert a PSA client call request */
-    if (!pend_slots) {
-        return MAILBOX_NO_PEND_EVENT;
-    }
+    /*
+     * Set the current slot index under processing.
+     * The value is used in mailbox_get_caller_data() to identify the
+     * mailbox queue slot.
+     */
+    spe_mailbox_queue.cur_proc_slot_idx = idx;
 
-    for (idx = 0; idx < NUM_MAILBOX_QUEUE_SLOT; idx++) {
-        mask_bits = (1 << idx);
-        /* Check if current NSPE mailbox queue slot is pending for handling */
-        if (!(pend_slots & mask_bits)) {
-            continue;
-        }
+    result = tfm_mailbox_dispatch(msg_ptr->call_type, &msg_ptr->params,
+                                  msg_ptr->client_id, &psa_ret);
 
+    /* Clean up the current slot index under processing */
+    spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
+
+    if (result != MAILBOX_SUCCESS) {
+        mailbox_clean_queue_slot(idx);
+        return;
+    }
+
+    if ((msg_ptr->call_type == MAILBOX_PSA_FRAMEWORK_VERSION) ||
+        (msg_ptr->call_type == MAILBOX_PSA_VERSION) ||
+        (msg_ptr->call_type == MAILBOX_SHM_REGISTER) ||
+        (msg_ptr->call_type == MAILBOX_SHM_UNREGISTER)) {
         /*
-         * TODO
-         * The operations are simplified here. Use the SPE mailbox queue
-         * slot with the same idx as that of the NSPE mailbox queue slot.
-         * A more general implementation should dynamically search and
-         * select an empty SPE mailbox queue slot.
+         * Directly write the result to NSPE for psa_framework_version(),
+         * psa_version() and shared memory buffer requests.
          */
-        clear_spe_queue_empty_status(idx);
-        spe_mailbox_queue.queue[idx].ns_slot_idx = idx;
+        mailbox_direct_reply(idx, (uint32_t)psa_ret);
+    } else if ((msg_ptr->call_type == MAILBOX_PSA_CONNECT) ||
+               (msg_ptr->call_type == MAILBOX_PSA_CALL)) {
+        /*
+         * If it failed to deliver psa_connect() or psa_call() request to
+         * TF-M IPC SPM, the failure result should be returned immediately.
+         */
+        if (psa_ret != PSA_SUCCESS) {
+            mailbox_direct_reply(idx, (uint32_t)psa_ret);
+        }
+    }
+    /*
+     * Skip checking psa_call() since it neither returns immediately nor
+     * has return value.
+     */
+}
+
+int32_t tfm_mailbox_handle_msg(void)
+{
+    uint8_t idx, ns_idx;
+    uint32_t pass;
+    mailbox_queue_status_t mask_bits, pend_slots, fetched_slots;
+    mailbox_queue_status_t handled_slots = 0;
+    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
 
-        msg_ptr = &spe_mailbox_queue.queue[idx].msg;
-        spm_memcpy(msg_ptr, &ns_queue->queue[idx].msg, sizeof(*msg_ptr));
+    SPM_ASSERT(ns_queue != NULL);
 
-        if (check_mailbox_msg(msg_ptr) != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
+    tfm_mailbox_hal_enter_critical();
+    spe_mailbox_queue.is_draining = true;
+    tfm_mailbox_hal_exit_critical();
 
-        get_spe_mailbox_msg_handle(idx,
-                                   &spe_mailbox_queue.queue[idx].msg_handle);
+    /*
+     * NSPE can pend new requests while the previous ones are being handled.
+     * Keep draining the NSPE queue until no request is pending, instead of
+     * waiting for another notification from NSPE. Each pass handles at least
+     * one request. The number of passes is bounded so that NSPE cannot keep
+     * SPE busy in this loop forever.
+     */
+    for (pass = 0; pass < NUM_MAILBOX_QUEUE_SLOT; pass++) {
+        tfm_mailbox_hal_enter_critical();
 
-        /*
-         * Set the current slot index under processing.
-         * The value is used in mailbox_get_caller_data() to identify the
-         * mailbox queue slot.
-         */
-        spe_mailbox_queue.cur_proc_slot_idx = idx;
+        pend_slots = get_nspe_queue_pend_status(ns_queue);
 
-        result = tfm_mailbox_dispatch(msg_ptr->call_type, &msg_ptr->params,
-                                      msg_ptr->client_id, &psa_ret);
-        if (result != MAILBOX_SUCCESS) {
-            mailbox_clean_queue_slot(idx);
-            continue;
-        }
+        tfm_mailbox_hal_exit_critical();
 
-        /* Clean up the current slot index under processing */
-        spe_mailbox_queue.cur_proc_slot_idx = NUM_MAILBOX_QUEUE_SLOT;
+        fetched_slots = 0;
 
-        if ((msg_ptr->call_type == MAILBOX_PSA_FRAMEWORK_VERSION) ||
-            (msg_ptr->call_type == MAILBOX_PSA_VERSION)) {
-            /*
-             * Directly write the result to NSPE for psa_framework_version() and
-             * psa_version().
-             */
-            reply_slots |= (1 << idx);
+        for (ns_idx = 0; ns_idx < NUM_MAILBOX_QUEUE_SLOT; ns_idx++) {
+            mask_bits = (mailbox_queue_status_t)(1UL << ns_idx);
+            /* Check if current NSPE mailbox queue slot is pending */
+            if (!(pend_slots & mask_bits)) {
+                continue;
+            }
 
-            mailbox_direct_reply(idx, (uint32_t)psa_ret);
-        } else if ((msg_ptr->call_type == MAILBOX_PSA_CONNECT) ||
-                   (msg_ptr->call_type == MAILBOX_PSA_CALL)) {
             /*
-             * If it failed to deliver psa_connect() or psa_call() request to
-             * TF-M IPC SPM, the failure result should be returned immediately.
+             * Leave the request pending in NSPE queue if all the SPE queue
+             * slots are occupied. It is handled in a later pass or at next
+             * notification, after an SPE queue slot is released.
              */
-            if (psa_ret != PSA_SUCCESS) {
-                reply_slots |= (1 << idx);
-                mailbox_direct_reply(idx, (uint32_t)psa_ret);
+            if (alloc_spe_queue_slot(&idx) != MAILBOX_SUCCESS) {
+                break;
             }
+
+            fetched_slots |= mask_bits;
+
+            mailbox_handle_slot(idx, ns_idx);
+        }
+
+        if (!fetched_slots) {
+            break;
         }
+
+        handled_slots |= fetched_slots;
+
         /*
-         * Skip checking psa_call() since it neither returns immediately nor
-         * has return value.
+         * Clean the NSPE mailbox pending status of the fetched slots. The
+         * replied status of these slots is only set afterwards, in
+         * mailbox_flush_replies(), so NSPE cannot reuse them in between.
          */
+        tfm_mailbox_hal_enter_critical();
+        clear_nspe_queue_pend_status(ns_queue, fetched_slots);
+        tfm_mailbox_hal_exit_critical();
     }
 
     tfm_mailbox_hal_enter_critical();
-
-    /* Clean the NSPE mailbox pending status. */
-    clear_nspe_queue_pend_status(ns_queue, pend_slots);
-
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_queue, reply_slots);
-
+    spe_mailbox_queue.is_draining = false;
     tfm_mailbox_hal_exit_critical();
 
-    if (reply_slots) {
-        tfm_mailbox_hal_notify_peer();
+    /* Notify NSPE once for all the replies during draining */
+    mailbox_flush_replies();
+
+    /* Check if NSPE mailbox did assert a PSA client call request */
+    if (!handled_slots) {
+        return MAILBOX_NO_PEND_EVENT;
     }
 
     return MAILBOX_SUCCESS;
@@ -298,9 +444,8 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
 {
     uint8_t idx;
     int32_t ret;
-    struct ns_mailbox_queue_t *ns_queue = spe_mailbox_queue.ns_queue;
 
-    SPM_ASSERT(ns_queue != NULL);
+    SPM_ASSERT(spe_mailbox_queue.ns_queue != NULL);
 
     /*
      * If handle == MAILBOX_MSG_NULL_HANDLE, reply to the mailbox message
@@ -317,20 +462,21 @@ int32_t tfm_mailbox_reply_msg(mailbox_msg_handle_t handle, int32_t reply)
         }
     }
 
+    if (idx >= NUM_MAILBOX_QUEUE_SLOT) {
+        return MAILBOX_INVAL_PARAMS;
+    }
+
     if (get_spe_queue_empty_status(idx)) {
         return MAILBOX_NO_PEND_EVENT;
     }
 
     mailbox_direct_reply(idx, (uint32_t)reply);
 
-    tfm_mailbox_hal_enter_critical();
-
-    /* Set the NSPE mailbox replied status */
-    set_nspe_queue_replied_status(ns_queue, (1 << idx));
-
-    tfm_mailbox_hal_exit_critical();
-
-    tfm_mailbox_hal_notify_peer();
+    /*
+     * The reply is notified together with the others if the NSPE queue is
+     * being drained.
+     */
+    mailbox_flush_replies();
 
     return MAILBOX_SUCCESS;
 }
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2019-2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2019-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -8,6 +8,7 @@
 #ifndef __TFM_SPE_MAILBOX_H__
 #define __TFM_SPE_MAILBOX_H__
 
+#include <stdbool.h>
 #include "tfm_mailbox.h"
 
 /* A handle to a mailbox message in use */
@@ -33,12 +34,27 @@ struct secure_mailbox_queue_t {
                                                      * queue slot currently
                                                      * under processing.
                                                      */
+    bool                         is_draining;      /*
+                                                    * NSPE mailbox queue is
+                                                    * being drained.
+                                                    */
+    mailbox_queue_status_t       reply_ns_slots;   /*
+                                                    * bitmask of NSPE slots
+                                                    * replied but not notified
+                                                    * yet.
+                                                    */
 };
 
 /**
  * \brief Handle mailbox message(s) from NSPE.
  *
+ * \details The NSPE mailbox queue is drained until no message is pending.
+ *          Each message is handled in an empty SPE mailbox queue slot, which
+ *          is not necessarily the one with the same index as the NSPE slot.
+ *          NSPE is notified once for all the replies written meanwhile.
+ *
  * \retval MAILBOX_SUCCESS      Successfully get PSA client call return result.
+ * \retval MAILBOX_NO_PEND_EVENT No message is pending in NSPE mailbox queue.
  * \retval Other return code    Operation failed with an error code.
  */
 int32_t tfm_mailbox_handle_msg(void);
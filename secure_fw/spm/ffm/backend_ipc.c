@@ -15,6 +15,8 @@
 #include "config_spm.h"
 #include "runtime_defs.h"
 #include "ffm/stack_watermark.h"
+#include "ffm/spm_profiler.h"
+#include "ffm/spm_boot_ts.h"
 #include "spm_ipc.h"
 #include "tfm_hal_memory_symbols.h"
 #include "tfm_hal_isolation.h"
@@ -74,7 +76,7 @@ static void prv_process_metadata(struct partition_t *p_pt)
     }
 
     ARCH_CTXCTRL_ALLOCATE_STACK(ctx_ctrl, allocate_size);
-    p_rt_meta = (struct runtime_metadata_t *)
+    p_rt_meta = (struct runtime_metadata_t *)(uintptr_t)
                                     ARCH_CTXCTRL_ALLOCATED_PTR(ctx_ctrl);
 
     p_rt_meta->entry = p_pt_ldi->entry;
@@ -218,6 +220,8 @@ uint32_t backend_system_run(void)
         tfm_core_panic();
     }
 
+    SPM_BOOT_TS_PT_START(p_cur_pt);
+
     return control;
 }
 
@@ -235,6 +239,8 @@ psa_signal_t backend_wait(struct partition_t *p_pt, psa_signal_t signal_mask)
      */
     CRITICAL_SECTION_ENTER(cs_assert);
 
+    SPM_BOOT_TS_PT_IDLE(p_pt);
+
     ret_signal = p_pt->signals_asserted & signal_mask;
     if (ret_signal == 0) {
         p_pt->signals_waiting = signal_mask;
@@ -260,10 +266,14 @@ uint64_t ipc_schedule(void)
     struct context_ctrl_t *p_curr_ctx;
     struct thread_t *pth_next = thrd_next();
     struct critical_section_t cs = CRITICAL_SECTION_STATIC_INIT;
+#ifdef CONFIG_TFM_SPM_PROFILING
+    uint32_t prof_start;
+#endif
 
     p_curr_ctx = (struct context_ctrl_t *)(CURRENT_THREAD->p_context_ctrl);
 
-    AAPCS_DUAL_U32_SET(ctx_ctrls, (uint32_t)p_curr_ctx, (uint32_t)p_curr_ctx);
+    AAPCS_DUAL_U32_SET(ctx_ctrls, (uint32_t)(uintptr_t)p_curr_ctx,
+                       (uint32_t)(uintptr_t)p_curr_ctx);
 
     p_part_curr = GET_CURRENT_COMPONENT();
     p_part_next = GET_THRD_OWNER(pth_next);
@@ -276,6 +286,7 @@ uint64_t ipc_schedule(void)
             tfm_core_panic();
         }
 
+        SPM_PROF_CTX_SWITCH_START(prof_start);
         CRITICAL_SECTION_ENTER(cs);
         /*
          * If required, let the platform update boundary based on its
@@ -291,10 +302,13 @@ uint64_t ipc_schedule(void)
         }
         ARCH_FLUSH_FP_CONTEXT();
 
-        AAPCS_DUAL_U32_SET_A1(ctx_ctrls, (uint32_t)pth_next->p_context_ctrl);
+        AAPCS_DUAL_U32_SET_A1(ctx_ctrls,
+                              (uint32_t)(uintptr_t)pth_next->p_context_ctrl);
 
         CURRENT_THREAD = pth_next;
         CRITICAL_SECTION_LEAVE(cs);
+        SPM_PROF_CTX_SWITCH_DONE(p_part_next, prof_start);
+        SPM_BOOT_TS_PT_START(p_part_next);
     }
 
     /* Update meta indicator */
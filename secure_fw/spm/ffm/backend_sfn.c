@@ -14,6 +14,8 @@
 #include "runtime_defs.h"
 #include "tfm_hal_platform.h"
 #include "ffm/backend.h"
+#include "ffm/spm_boot_ts.h"
+#include "ffm/spm_profiler.h"
 #include "ffm/stack_watermark.h"
 #include "load/partition_defs.h"
 #include "load/service_defs.h"
@@ -53,6 +55,7 @@ psa_status_t backend_messaging(struct service_t *service,
     SET_CURRENT_COMPONENT(p_target);
 
     if (p_target->state == SFN_PARTITION_STATE_NOT_INITED) {
+        SPM_BOOT_TS_PT_START(p_target);
         if (p_target->p_ldinf->entry != 0) {
             status = ((sfn_init_fn_t)p_target->p_ldinf->entry)();
             /* Negative value indicates errors. */
@@ -60,9 +63,12 @@ psa_status_t backend_messaging(struct service_t *service,
                 return PSA_ERROR_PROGRAMMER_ERROR;
             }
         }
+        SPM_BOOT_TS_PT_IDLE(p_target);
         p_target->state = SFN_PARTITION_STATE_INITED;
     }
 
+    SPM_PROF_MSG_GOT(handle);
+
     status = ((service_fn_t)service->p_ldinf->sfn)(&handle->msg);
 
     handle->status = TFM_HANDLE_STATUS_ACTIVE;
@@ -103,6 +109,7 @@ static void spm_thread_fn(void)
         }
 
         SET_CURRENT_COMPONENT(p_part);
+        SPM_BOOT_TS_PT_START(p_part);
 
         if (p_part->p_ldinf->entry != 0) {
             if (((sfn_init_fn_t)p_part->p_ldinf->entry)() < PSA_SUCCESS) {
@@ -110,10 +117,13 @@ static void spm_thread_fn(void)
             }
         }
 
+        SPM_BOOT_TS_PT_IDLE(p_part);
         p_part->state = SFN_PARTITION_STATE_INITED;
     }
 
     SET_CURRENT_COMPONENT(p_curr);
+    /* Returns to the NS agent */
+    SPM_BOOT_TS_PT_START(p_curr);
 }
 
 /* Parameters are treated as assuredly */
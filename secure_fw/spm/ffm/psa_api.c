@@ -17,6 +17,7 @@
 #include "psa/service.h"
 #include "interrupt.h"
 #include "spm_ipc.h"
+#include "ffm/spm_profiler.h"
 #include "tfm_arch.h"
 #include "load/partition_defs.h"
 #include "load/service_defs.h"
@@ -252,7 +253,7 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
      * if the memory reference for the wrap input vector is invalid or not
      * readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              curr_partition->boundary, (uintptr_t)inptr,
              in_num * sizeof(psa_invec), TFM_HAL_ACCESS_READABLE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -264,7 +265,7 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
      * actual length later. It is a PROGRAMMER ERROR if the memory reference for
      * the wrap output vector is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              curr_partition->boundary, (uintptr_t)outptr,
              out_num * sizeof(psa_outvec), TFM_HAL_ACCESS_READWRITE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -283,7 +284,7 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
      * memory reference was invalid or not readable.
      */
     for (i = 0; i < in_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
+        FIH_CALL(spm_memory_check, fih_rc,
                  curr_partition->boundary, (uintptr_t)invecs[i].base,
                  invecs[i].len, TFM_HAL_ACCESS_READABLE);
         if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -312,7 +313,7 @@ psa_status_t tfm_spm_client_psa_call(psa_handle_t handle,
      * payload memory reference was invalid or not read-write.
      */
     for (i = 0; i < out_num; i++) {
-        FIH_CALL(tfm_hal_memory_check, fih_rc,
+        FIH_CALL(spm_memory_check, fih_rc,
                  curr_partition->boundary, (uintptr_t)outvecs[i].base,
                  outvecs[i].len, TFM_HAL_ACCESS_READWRITE);
         if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -505,7 +506,7 @@ psa_status_t tfm_spm_partition_psa_get(psa_signal_t signal, psa_msg_t *msg)
      * Write the message to the service buffer. It is a fatal error if the
      * input msg pointer is not a valid memory reference or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              partition->boundary, (uintptr_t)msg,
              sizeof(psa_msg_t), TFM_HAL_ACCESS_READWRITE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -537,34 +538,26 @@ psa_status_t tfm_spm_partition_psa_get(psa_signal_t signal, psa_msg_t *msg)
         return PSA_ERROR_DOES_NOT_EXIST;
     }
 
+    SPM_PROF_MSG_GOT(handle);
+
     spm_memcpy(msg, &handle->msg, sizeof(psa_msg_t));
 
     return PSA_SUCCESS;
 }
 #endif
 
-size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
-                                  void *buffer, size_t num_bytes)
+/*
+ * Copy from one client input vector into a partition buffer. The caller must
+ * have validated 'handle' as a request message owned by 'curr_partition'.
+ */
+static size_t spm_read_invec(struct conn_handle_t *handle,
+                             struct partition_t *curr_partition,
+                             uint32_t invec_idx, void *buffer,
+                             size_t num_bytes)
 {
     size_t bytes;
-    struct conn_handle_t *handle = NULL;
-    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     fih_int fih_rc = FIH_FAILURE;
 
-    /* It is a fatal error if message handle is invalid */
-    handle = spm_get_handle_by_msg_handle(msg_handle);
-    if (!handle) {
-        tfm_core_panic();
-    }
-
-    /*
-     * It is a fatal error if message handle does not refer to a request
-     * message
-     */
-    if (handle->msg.type < PSA_IPC_CALL) {
-        tfm_core_panic();
-    }
-
     /*
      * It is a fatal error if invec_idx is equal to or greater than
      * PSA_MAX_IOVEC
@@ -594,7 +587,7 @@ size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
      * Copy the client data to the service buffer. It is a fatal error
      * if the memory reference for buffer is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              curr_partition->boundary, (uintptr_t)buffer,
              num_bytes, TFM_HAL_ACCESS_READWRITE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -614,6 +607,83 @@ size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
     return bytes;
 }
 
+size_t tfm_spm_partition_psa_read(psa_handle_t msg_handle, uint32_t invec_idx,
+                                  void *buffer, size_t num_bytes)
+{
+    struct conn_handle_t *handle = NULL;
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+
+    /* It is a fatal error if message handle is invalid */
+    handle = spm_get_handle_by_msg_handle(msg_handle);
+    if (!handle) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (handle->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    return spm_read_invec(handle, curr_partition, invec_idx,
+                          buffer, num_bytes);
+}
+
+size_t tfm_spm_partition_psa_read_vec(psa_handle_t msg_handle,
+                                      struct tfm_psa_rw_seg_t *segs,
+                                      uint32_t num_segs)
+{
+    struct tfm_psa_rw_seg_t seg;
+    struct conn_handle_t *handle = NULL;
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    size_t total = 0;
+    uint32_t i;
+    fih_int fih_rc = FIH_FAILURE;
+
+    /* It is a fatal error if message handle is invalid */
+    handle = spm_get_handle_by_msg_handle(msg_handle);
+    if (!handle) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (handle->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    if (num_segs > TFM_PSA_RW_VEC_MAX_SEGS) {
+        tfm_core_panic();
+    }
+
+    /*
+     * The copied length is reported back in the segment array. It is a fatal
+     * error if the memory reference for segs is invalid or not read-write.
+     */
+    FIH_CALL(spm_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)segs,
+             num_segs * sizeof(struct tfm_psa_rw_seg_t),
+             TFM_HAL_ACCESS_READWRITE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        tfm_core_panic();
+    }
+
+    for (i = 0; i < num_segs; i++) {
+        /* Copy the segment out to avoid TOCTOU attacks. */
+        spm_memcpy(&seg, &segs[i], sizeof(seg));
+
+        segs[i].len = spm_read_invec(handle, curr_partition, seg.iovec_idx,
+                                     seg.buffer, seg.len);
+        total += segs[i].len;
+    }
+
+    return total;
+}
+
 size_t tfm_spm_partition_psa_skip(psa_handle_t msg_handle, uint32_t invec_idx,
                                   size_t num_bytes)
 {
@@ -674,27 +744,17 @@ size_t tfm_spm_partition_psa_skip(psa_handle_t msg_handle, uint32_t invec_idx,
     return num_bytes;
 }
 
-void tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
-                                 const void *buffer, size_t num_bytes)
+/*
+ * Copy from a partition buffer into one client output vector. The caller must
+ * have validated 'handle' as a request message owned by 'curr_partition'.
+ */
+static void spm_write_outvec(struct conn_handle_t *handle,
+                             struct partition_t *curr_partition,
+                             uint32_t outvec_idx, const void *buffer,
+                             size_t num_bytes)
 {
-    struct conn_handle_t *handle = NULL;
-    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
     fih_int fih_rc = FIH_FAILURE;
 
-    /* It is a fatal error if message handle is invalid */
-    handle = spm_get_handle_by_msg_handle(msg_handle);
-    if (!handle) {
-        tfm_core_panic();
-    }
-
-    /*
-     * It is a fatal error if message handle does not refer to a request
-     * message
-     */
-    if (handle->msg.type < PSA_IPC_CALL) {
-        tfm_core_panic();
-    }
-
     /*
      * It is a fatal error if outvec_idx is equal to or greater than
      * PSA_MAX_IOVEC
@@ -728,7 +788,7 @@ void tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
      * Copy the service buffer to client outvecs. It is a fatal error
      * if the memory reference for buffer is invalid or not readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              curr_partition->boundary, (uintptr_t)buffer,
              num_bytes, TFM_HAL_ACCESS_READABLE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -742,6 +802,78 @@ void tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
     handle->outvec[outvec_idx].len += num_bytes;
 }
 
+void tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
+                                 const void *buffer, size_t num_bytes)
+{
+    struct conn_handle_t *handle = NULL;
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+
+    /* It is a fatal error if message handle is invalid */
+    handle = spm_get_handle_by_msg_handle(msg_handle);
+    if (!handle) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (handle->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    spm_write_outvec(handle, curr_partition, outvec_idx, buffer, num_bytes);
+}
+
+void tfm_spm_partition_psa_write_vec(psa_handle_t msg_handle,
+                                     const struct tfm_psa_rw_seg_t *segs,
+                                     uint32_t num_segs)
+{
+    struct tfm_psa_rw_seg_t seg;
+    struct conn_handle_t *handle = NULL;
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    uint32_t i;
+    fih_int fih_rc = FIH_FAILURE;
+
+    /* It is a fatal error if message handle is invalid */
+    handle = spm_get_handle_by_msg_handle(msg_handle);
+    if (!handle) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if message handle does not refer to a request
+     * message
+     */
+    if (handle->msg.type < PSA_IPC_CALL) {
+        tfm_core_panic();
+    }
+
+    if (num_segs > TFM_PSA_RW_VEC_MAX_SEGS) {
+        tfm_core_panic();
+    }
+
+    /*
+     * It is a fatal error if the memory reference for segs is invalid or not
+     * readable.
+     */
+    FIH_CALL(spm_memory_check, fih_rc,
+             curr_partition->boundary, (uintptr_t)segs,
+             num_segs * sizeof(struct tfm_psa_rw_seg_t),
+             TFM_HAL_ACCESS_READABLE);
+    if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
+        tfm_core_panic();
+    }
+
+    for (i = 0; i < num_segs; i++) {
+        /* Copy the segment out to avoid TOCTOU attacks. */
+        spm_memcpy(&seg, &segs[i], sizeof(seg));
+
+        spm_write_outvec(handle, curr_partition, seg.iovec_idx,
+                         seg.buffer, seg.len);
+    }
+}
+
 psa_status_t tfm_spm_partition_psa_reply(psa_handle_t msg_handle,
                                          psa_status_t status)
 {
@@ -766,6 +898,8 @@ psa_status_t tfm_spm_partition_psa_reply(psa_handle_t msg_handle,
         tfm_core_panic();
     }
 
+    SPM_PROF_MSG_REPLIED(handle);
+
     switch (handle->msg.type) {
     case PSA_IPC_CONNECT:
         /*
@@ -1098,7 +1232,7 @@ const void *tfm_spm_partition_psa_map_invec(psa_handle_t msg_handle,
      * It is a fatal error if the memory reference for the wrap input vector is
      * invalid or not readable.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              partition->boundary, (uintptr_t)handle->invec[invec_idx].base,
              handle->invec[invec_idx].len, TFM_HAL_ACCESS_READABLE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -1229,7 +1363,7 @@ void *tfm_spm_partition_psa_map_outvec(psa_handle_t msg_handle,
     /*
      * It is a fatal error if the output vector is invalid or not read-write.
      */
-    FIH_CALL(tfm_hal_memory_check, fih_rc,
+    FIH_CALL(spm_memory_check, fih_rc,
              partition->boundary, (uintptr_t)handle->outvec[outvec_idx].base,
              handle->outvec[outvec_idx].len, TFM_HAL_ACCESS_READWRITE);
     if (fih_not_eq(fih_rc, fih_int_encode(PSA_SUCCESS))) {
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "boot_timestamp.h"
+#include "ffm/spm_boot_ts.h"
+#include "load/partition_defs.h"
+#include "region_defs.h"
+#include "spm_ipc.h"
+#include "tfm_boot_status.h"
+#include "tfm_spm_log.h"
+#include "utilities.h"
+
+static void log_record(const struct boot_ts_record_t *p_record)
+{
+    SPMLOG_INFMSGVAL("  Checkpoint: ", ((uint32_t)p_record->stage << 24) |
+                                       ((uint32_t)p_record->checkpoint << 16) |
+                                       p_record->arg);
+    SPMLOG_INFMSGVAL("    Time: ", p_record->time);
+}
+
+/* Log the checkpoints of the boot stages, then the ones of SPM */
+static void log_boot_timeline(void)
+{
+    const struct boot_ts_record_t *p_records;
+    size_t count, i;
+#ifdef BOOT_DATA_AVAILABLE
+    struct tfm_boot_data *boot_data =
+                            (struct tfm_boot_data *)BOOT_TFM_SHARED_DATA_BASE;
+    struct shared_data_tlv_entry tlv_entry;
+    struct boot_ts_record_t record;
+    uintptr_t tlv_end, offset;
+#endif /* BOOT_DATA_AVAILABLE */
+
+    SPMLOG_INFMSG("Boot timeline (checkpoints as 0xSSCCAAAA: stage, "
+                  "checkpoint, argument)\r\n");
+
+#ifdef BOOT_DATA_AVAILABLE
+    if (boot_data->header.tlv_magic == SHARED_DATA_TLV_INFO_MAGIC &&
+        boot_data->header.tlv_tot_len <= BOOT_TFM_SHARED_DATA_SIZE) {
+        tlv_end = BOOT_TFM_SHARED_DATA_BASE + boot_data->header.tlv_tot_len;
+        offset  = BOOT_TFM_SHARED_DATA_BASE + SHARED_DATA_HEADER_SIZE;
+
+        for (; offset + SHARED_DATA_ENTRY_HEADER_SIZE <= tlv_end;
+             offset += SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len)) {
+            /* Create local copy to avoid unaligned access */
+            (void)spm_memcpy(&tlv_entry, (const void *)offset,
+                             SHARED_DATA_ENTRY_HEADER_SIZE);
+
+            if (GET_MAJOR(tlv_entry.tlv_type) != TLV_MAJOR_BTS ||
+                offset + SHARED_DATA_ENTRY_SIZE(tlv_entry.tlv_len) > tlv_end) {
+                continue;
+            }
+
+            for (i = 0; i + sizeof(record) <= tlv_entry.tlv_len;
+                 i += sizeof(record)) {
+                (void)spm_memcpy(&record,
+                                 (const void *)(offset +
+                                                SHARED_DATA_ENTRY_HEADER_SIZE +
+                                                i),
+                                 sizeof(record));
+                log_record(&record);
+            }
+        }
+    }
+#endif /* BOOT_DATA_AVAILABLE */
+
+    count = boot_ts_fetch_records(&p_records);
+    for (i = 0; i < count; i++) {
+        log_record(&p_records[i]);
+    }
+}
+
+void spm_boot_ts_partition_start(struct partition_t *p_pt)
+{
+    if (p_pt->boot_ts_state != SPM_BOOT_TS_PT_NOT_STARTED) {
+        return;
+    }
+
+    if (IS_PARTITION_NS_AGENT(p_pt->p_ldinf)) {
+        /* The NS agent runs once the other partitions are initialized */
+        p_pt->boot_ts_state = SPM_BOOT_TS_PT_INITIALIZED;
+        SPM_BOOT_TS_RECORD(BOOT_TS_NS_ENTRY, p_pt->p_ldinf->pid);
+        log_boot_timeline();
+        return;
+    }
+
+    p_pt->boot_ts_state = SPM_BOOT_TS_PT_INITIALIZING;
+    SPM_BOOT_TS_RECORD(BOOT_TS_PARTITION_INIT_ENTRY, p_pt->p_ldinf->pid);
+}
+
+void spm_boot_ts_partition_idle(struct partition_t *p_pt)
+{
+    if (p_pt->boot_ts_state != SPM_BOOT_TS_PT_INITIALIZING) {
+        return;
+    }
+
+    p_pt->boot_ts_state = SPM_BOOT_TS_PT_INITIALIZED;
+    SPM_BOOT_TS_RECORD(BOOT_TS_PARTITION_INIT_EXIT, p_pt->p_ldinf->pid);
+}
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_BOOT_TS_H__
+#define __SPM_BOOT_TS_H__
+
+#include <stdint.h>
+#include "boot_timestamp.h"
+
+/* Partition init states of the boot timeline, held in 'struct partition_t' */
+#define SPM_BOOT_TS_PT_NOT_STARTED      0
+#define SPM_BOOT_TS_PT_INITIALIZING     1
+#define SPM_BOOT_TS_PT_INITIALIZED      2
+
+#ifdef TFM_BOOT_TIMESTAMPS
+
+struct partition_t;
+
+/**
+ * \brief Record that a partition starts running. The first time, this is the
+ *        entry of the partition initialization. For the NS agent, this is the
+ *        entry to NSPE, and the boot timeline is logged.
+ *
+ * \param[in] p_pt              The partition.
+ */
+void spm_boot_ts_partition_start(struct partition_t *p_pt);
+
+/**
+ * \brief Record that a partition waits for signals or returns from its SFN
+ *        initialization function, the first time this is the exit of the
+ *        partition initialization.
+ *
+ * \param[in] p_pt              The partition.
+ */
+void spm_boot_ts_partition_idle(struct partition_t *p_pt);
+
+#define SPM_BOOT_TS_RECORD(checkpoint, arg)                             \
+    BOOT_TS_RECORD(BOOT_TS_STAGE_SPM, checkpoint, arg)
+#define SPM_BOOT_TS_PT_START(p_pt)      spm_boot_ts_partition_start(p_pt)
+#define SPM_BOOT_TS_PT_IDLE(p_pt)       spm_boot_ts_partition_idle(p_pt)
+
+#else /* TFM_BOOT_TIMESTAMPS */
+
+#define SPM_BOOT_TS_RECORD(checkpoint, arg)
+#define SPM_BOOT_TS_PT_START(p_pt)
+#define SPM_BOOT_TS_PT_IDLE(p_pt)
+
+#endif /* TFM_BOOT_TIMESTAMPS */
+
+#endif /* __SPM_BOOT_TS_H__ */
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include <stdint.h>
+#include "cmsis_compiler.h"
+#include "critical_section.h"
+#include "current.h"
+#include "ffm/backend.h"
+#include "ffm/spm_profiler.h"
+#include "lists.h"
+#include "load/service_defs.h"
+#include "load/spm_load_api.h"
+#include "spm_ipc.h"
+#include "tfm_hal_device_header.h"
+#include "tfm_spm_log.h"
+#include "utilities.h"
+
+/* Always output, regardless of log level.
+ * If you don't want output, don't build this code
+ */
+#define SPMLOG(x) tfm_hal_output_spm_log((x), sizeof(x))
+#define SPMLOG_VAL(x, y) spm_log_msgval((x), sizeof(x), y)
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || \
+    defined(__ARM_ARCH_8M_MAIN__) || defined(__ARM_ARCH_8_1M_MAIN__)
+#define SPM_PROF_HAS_DWT_CYCCNT
+#endif
+
+__WEAK uint32_t spm_prof_get_cycles(void)
+{
+#ifdef SPM_PROF_HAS_DWT_CYCCNT
+    return DWT->CYCCNT;
+#else
+    return 0;
+#endif
+}
+
+__WEAK void spm_prof_init(void)
+{
+#ifdef SPM_PROF_HAS_DWT_CYCCNT
+    /*
+     * Only differences are accounted, so the counter is not reset. This keeps
+     * it monotonic for the boot timestamps, which share it.
+     */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+}
+
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_memory_check(uintptr_t boundary,
+                                                     uintptr_t base,
+                                                     size_t size,
+                                                     uint32_t access_type)
+{
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+    uint32_t start = spm_prof_get_cycles();
+    fih_int fih_rc = FIH_FAILURE;
+
+    FIH_CALL(tfm_hal_memory_check, fih_rc, boundary, base, size, access_type);
+
+    if (curr_partition) {
+        SPM_PROF_ACCOUNT(&curr_partition->prof, mem_check_count,
+                         mem_check_cycles, start);
+    }
+
+    FIH_RET(fih_rc);
+}
+
+/* 2 char for '0x', 16 for the number and 2 for '\r\n' */
+#define U64_DIGIT_BITS 20
+
+/* Outputs the message and the 64 bit value in hex format on a single line */
+static void dump_u64(const char *msg, size_t len, uint64_t value)
+{
+    static const char hex_table[] = "0123456789ABCDEF";
+    char value_str[U64_DIGIT_BITS];
+    int i = U64_DIGIT_BITS - 1;
+
+    value_str[i--] = '\n';
+    value_str[i--] = '\r';
+    for (; i > 1; i--, value >>= 4) {
+        value_str[i] = hex_table[value & 0xF];
+    }
+    value_str[1] = 'x';
+    value_str[0] = '0';
+
+    tfm_hal_output_spm_log(msg, len);
+    tfm_hal_output_spm_log(value_str, U64_DIGIT_BITS);
+}
+
+#define SPMLOG_VAL64(x, y) dump_u64((x), sizeof(x), y)
+
+void spm_profiler_dump(uint32_t flags)
+{
+    struct partition_t *p_pt;
+    struct service_t *p_srv;
+    const struct service_load_info_t *p_srv_ldinf;
+    struct critical_section_t cs_assert = CRITICAL_SECTION_STATIC_INIT;
+    int32_t i;
+
+    SPMLOG("SPM profiling report (cycles)\r\n");
+    UNI_LIST_FOREACH(p_pt, PARTITION_LIST_ADDR, next) {
+        SPMLOG_VAL("  Partition id: ", p_pt->p_ldinf->pid);
+        SPMLOG_VAL("    Memory checks: ", p_pt->prof.mem_check_count);
+        SPMLOG_VAL64("    Memory check cycles: ",
+                     p_pt->prof.mem_check_cycles);
+        SPMLOG_VAL("    Context switches: ", p_pt->prof.ctx_switch_count);
+        SPMLOG_VAL64("    Context switch cycles: ",
+                     p_pt->prof.ctx_switch_cycles);
+
+        /* Services of a partition are loaded in the load info order */
+        p_srv_ldinf = LOAD_INFO_SERVICE(p_pt->p_ldinf);
+        for (i = 0; i < p_pt->p_ldinf->nservices; i++) {
+            p_srv = tfm_spm_get_service_by_sid(p_srv_ldinf[i].sid);
+            if (!p_srv) {
+                continue;
+            }
+
+            SPMLOG_VAL("    SID: ", p_srv->p_ldinf->sid);
+            SPMLOG_VAL("      Messages: ", p_srv->prof.msg_count);
+            SPMLOG_VAL64("      Queued cycles: ", p_srv->prof.queued_cycles);
+            SPMLOG_VAL64("      Service cycles: ",
+                         p_srv->prof.service_cycles);
+
+            if (flags & SPM_PROFILER_DUMP_RESET) {
+                CRITICAL_SECTION_ENTER(cs_assert);
+                spm_memset(&p_srv->prof, 0, sizeof(p_srv->prof));
+                CRITICAL_SECTION_LEAVE(cs_assert);
+            }
+        }
+
+        if (flags & SPM_PROFILER_DUMP_RESET) {
+            CRITICAL_SECTION_ENTER(cs_assert);
+            spm_memset(&p_pt->prof, 0, sizeof(p_pt->prof));
+            CRITICAL_SECTION_LEAVE(cs_assert);
+        }
+    }
+}
+
+void tfm_spm_profiler_dump_handler(uint32_t args[])
+{
+    struct partition_t *curr_partition = GET_CURRENT_COMPONENT();
+
+    /* Only privileged partitions are allowed to query the counters */
+    if (!curr_partition ||
+        GET_PARTITION_PRIVILEGED_MODE(curr_partition->p_ldinf) !=
+                                            TFM_PARTITION_PRIVILEGED_MODE) {
+        args[0] = (uint32_t)PSA_ERROR_NOT_PERMITTED;
+        return;
+    }
+
+    spm_profiler_dump(args[0]);
+
+    args[0] = (uint32_t)PSA_SUCCESS;
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef __SPM_PROFILER_H__
+#define __SPM_PROFILER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "fih.h"
+#include "tfm_hal_isolation.h"
+
+/* Flags of tfm_spm_profiler_dump() */
+#define SPM_PROFILER_DUMP_RESET         (1U << 0)   /* Reset after dumping */
+
+#ifdef CONFIG_TFM_SPM_PROFILING
+
+/* Counters per RoT Service, held in 'struct service_t' */
+struct spm_prof_service_t {
+    uint32_t msg_count;                 /* Messages delivered to the service */
+    uint64_t queued_cycles;             /* Message sent until psa_get()      */
+    uint64_t service_cycles;            /* psa_get() until psa_reply()       */
+};
+
+/* Counters per partition, held in 'struct partition_t' */
+struct spm_prof_partition_t {
+    uint32_t mem_check_count;           /* tfm_hal_memory_check() calls      */
+    uint64_t mem_check_cycles;          /* Cycles in tfm_hal_memory_check()  */
+    uint32_t ctx_switch_count;          /* Switches into the partition       */
+    uint64_t ctx_switch_cycles;         /* Cycles spent switching into it    */
+};
+
+/* Timestamps per message, held in 'struct conn_handle_t' */
+struct spm_prof_msg_t {
+    uint32_t ts_queued;                 /* When the message was sent         */
+    uint32_t ts_got;                    /* When the service got the message  */
+};
+
+/**
+ * \brief Get the current value of the free running cycle counter.
+ *
+ * \details The default implementation reads the DWT cycle counter on
+ *          Armv7-M and Armv8-M Mainline cores, and returns 0 elsewhere.
+ *          Platforms and host builds override it with their own time source.
+ */
+uint32_t spm_prof_get_cycles(void);
+
+/**
+ * \brief Start the cycle counter used by the profiler.
+ */
+void spm_prof_init(void);
+
+/*
+ * Account the elapsed cycles since 'start' to 'count'/'cycles' fields of a
+ * counter structure.
+ */
+#define SPM_PROF_ACCOUNT(p_prof, count, cycles, start)                  \
+    do {                                                                \
+        (p_prof)->count++;                                              \
+        (p_prof)->cycles += (uint32_t)(spm_prof_get_cycles() - (start));\
+    } while (0)
+
+/* A message is sent to a service by psa_call(), psa_connect() or psa_close() */
+#define SPM_PROF_MSG_QUEUED(p_handle)                                   \
+    ((p_handle)->prof.ts_queued = spm_prof_get_cycles())
+
+/* The service got the message, by psa_get() or by the SFN dispatcher */
+#define SPM_PROF_MSG_GOT(p_handle)                                      \
+    do {                                                                \
+        (p_handle)->prof.ts_got = spm_prof_get_cycles();                \
+        (p_handle)->service->prof.msg_count++;                          \
+        (p_handle)->service->prof.queued_cycles +=                      \
+            (uint32_t)((p_handle)->prof.ts_got - (p_handle)->prof.ts_queued); \
+    } while (0)
+
+/* The service replied the message */
+#define SPM_PROF_MSG_REPLIED(p_handle)                                  \
+    ((p_handle)->service->prof.service_cycles +=                        \
+        (uint32_t)(spm_prof_get_cycles() - (p_handle)->prof.ts_got))
+
+/**
+ * \brief Call tfm_hal_memory_check() and account the time spent in it to the
+ *        current partition. The parameters and return value are the same as
+ *        tfm_hal_memory_check().
+ */
+FIH_RET_TYPE(enum tfm_hal_status_t) spm_memory_check(uintptr_t boundary,
+                                                     uintptr_t base,
+                                                     size_t size,
+                                                     uint32_t access_type);
+
+#define SPM_PROF_CTX_SWITCH_START(start)                                \
+    ((start) = spm_prof_get_cycles())
+
+/* Account a context switch into partition 'p_pt' started at 'start' */
+#define SPM_PROF_CTX_SWITCH_DONE(p_pt, start)                           \
+    SPM_PROF_ACCOUNT(&(p_pt)->prof, ctx_switch_count,                   \
+                     ctx_switch_cycles, start)
+
+/**
+ * \brief Dump the profiling counters of all partitions and services through
+ *        tfm_hal_output_spm_log().
+ *
+ * \param[in] flags             \ref SPM_PROFILER_DUMP_RESET to clear the
+ *                              counters after dumping.
+ */
+void spm_profiler_dump(uint32_t flags);
+
+/**
+ * \brief SVC handler of \ref tfm_spm_profiler_dump.
+ *
+ * \param[in,out] args          SVC arguments, args[0] holds the flags on
+ *                              entry and the result on return.
+ */
+void tfm_spm_profiler_dump_handler(uint32_t args[]);
+
+#else /* CONFIG_TFM_SPM_PROFILING */
+
+#define spm_prof_init()
+#define SPM_PROF_MSG_QUEUED(p_handle)
+#define SPM_PROF_MSG_GOT(p_handle)
+#define SPM_PROF_MSG_REPLIED(p_handle)
+#define spm_memory_check                        tfm_hal_memory_check
+#define SPM_PROF_CTX_SWITCH_START(start)
+#define SPM_PROF_CTX_SWITCH_DONE(p_pt, start)
+
+#endif /* CONFIG_TFM_SPM_PROFILING */
+
+#endif /* __SPM_PROFILER_H__ */
@@ -23,6 +23,7 @@ extern "C" {
 #define TLV_MAJOR_IAS      0x1
 #define TLV_MAJOR_FWU      0x2
 #define TLV_MAJOR_MBS      0x3
+#define TLV_MAJOR_BTS      0x4
 
 /**
  * The shared data between boot loader and runtime SW is TLV encoded. The
@@ -61,6 +62,8 @@ extern "C" {
  * |---------------------------------------|
  * | MAJOR_MBS   | slot ID  (6) | claim(6) |
  * |---------------------------------------|
+ * | MAJOR_BTS   |       boot stage        |
+ * |---------------------------------------|
  * | MAJOR_CORE  |          TBD            |
  * |---------------------------------------|
  */
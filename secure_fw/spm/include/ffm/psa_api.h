@@ -13,6 +13,7 @@
 #include "config_spm.h"
 #include "psa/client.h"
 #include "psa/service.h"
+#include "tfm_psa_rw_vec.h"
 
 /**
  * \brief This function handles the specific programmer error cases.
@@ -243,6 +244,36 @@ size_t tfm_spm_partition_psa_skip(psa_handle_t msg_handle, uint32_t invec_idx,
 void tfm_spm_partition_psa_write(psa_handle_t msg_handle, uint32_t outvec_idx,
                                  const void *buffer, size_t num_bytes);
 
+/**
+ * \brief Function body of \ref tfm_psa_read_vec.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in,out] segs          Array of segments to read. The len member of
+ *                              each segment is updated with the number of bytes
+ *                              copied for it.
+ * \param[in] num_segs          Number of segments in the array.
+ *
+ * \retval >=0                  Total number of bytes copied.
+ * \retval "PROGRAMMER ERROR"   The call is invalid, see \ref tfm_psa_read_vec.
+ */
+size_t tfm_spm_partition_psa_read_vec(psa_handle_t msg_handle,
+                                      struct tfm_psa_rw_seg_t *segs,
+                                      uint32_t num_segs);
+
+/**
+ * \brief Function body of \ref tfm_psa_write_vec.
+ *
+ * \param[in] msg_handle        Handle for the client's message.
+ * \param[in] segs              Array of segments to write.
+ * \param[in] num_segs          Number of segments in the array.
+ *
+ * \retval void                 Success
+ * \retval "PROGRAMMER ERROR"   The call is invalid, see \ref tfm_psa_write_vec.
+ */
+void tfm_spm_partition_psa_write_vec(psa_handle_t msg_handle,
+                                     const struct tfm_psa_rw_seg_t *segs,
+                                     uint32_t num_segs);
+
 /**
  * \brief Function body of \ref psa_reply.
  *
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2021, Arm Limited. All rights reserved.
+ * Copyright (c) 2021-2022, Arm Limited. All rights reserved.
  *
  * SPDX-License-Identifier: BSD-3-Clause
  *
@@ -40,6 +40,11 @@
 #define TFM_SVC_GET_BOOT_DATA           (0x40)
 #define TFM_SVC_SPM_INIT                (0x41)
 #define TFM_SVC_FLIH_FUNC_RETURN        (0x42)
+#define TFM_SVC_PSA_READ_VEC            (0x43)
+#define TFM_SVC_PSA_WRITE_VEC           (0x44)
+#ifdef CONFIG_TFM_SPM_PROFILING
+#define TFM_SVC_SPM_PROFILER_DUMP       (0x45)
+#endif
 #define TFM_SVC_THREAD_NUMBER_END       (0x7F)
 #if TFM_SP_LOG_RAW_ENABLED
 #define TFM_SVC_OUTPUT_UNPRIV_STRING    (TFM_SVC_THREAD_NUMBER_END)
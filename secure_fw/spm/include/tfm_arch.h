@@ -18,7 +18,9 @@
 #include "tfm_hal_device_header.h"
 #include "cmsis_compiler.h"
 
-#if defined(__ARM_ARCH_8_1M_MAIN__) || \
+#if defined(TFM_SPM_HOST_BUILD)
+#include "tfm_arch_host.h"
+#elif defined(__ARM_ARCH_8_1M_MAIN__) || \
     defined(__ARM_ARCH_8M_MAIN__)  || defined(__ARM_ARCH_8M_BASE__)
 #include "tfm_arch_v8m.h"
 #elif defined(__ARM_ARCH_6M__) || defined(__ARM_ARCH_7M__) || \
@@ -34,7 +36,9 @@
 #define XPSR_T32            0x01000000
 
 /* Define IRQ level */
-#if defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_8M_MAIN__)
+#if defined(TFM_SPM_HOST_BUILD)
+/* No exception priorities in the host simulation */
+#elif defined(__ARM_ARCH_8_1M_MAIN__) || defined(__ARM_ARCH_8M_MAIN__)
 #define SecureFault_IRQnLVL      (0)
 #define MemoryManagement_IRQnLVL (0)
 #define BusFault_IRQnLVL         (0)
@@ -183,6 +187,7 @@ struct cross_call_abi_frame_t {
                 .exc_ret   = 0,                                           \
             }
 
+#ifndef TFM_SPM_HOST_BUILD
 /**
  * \brief Get Link Register
  * \details Returns the value of the Link Register (LR)
@@ -262,6 +267,7 @@ __STATIC_INLINE bool tfm_arch_is_priv(void)
 #else
 #define ARCH_FLUSH_FP_CONTEXT()
 #endif
+#endif /* !TFM_SPM_HOST_BUILD */
 
 /* Set secure exceptions priority. */
 void tfm_arch_set_secure_exception_priorities(void);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022, Arm Limited. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#ifndef __TFM_ARCH_HOST_H__
+#define __TFM_ARCH_HOST_H__
+
+/*
+ * Architecture layer of the host simulation build. The SPM runs as a Linux
+ * user space process, partition threads are ucontext instances and PendSV is
+ * emulated by a pending flag which is served once interrupts are unmasked.
+ * There is no preemption, so the 'interrupt mask' only defers scheduling.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "cmsis_compiler.h"
+#include "utilities.h"
+
+/* Pseudo EXC_RETURN, only used as an opaque token by common code */
+#define EXC_RETURN_THREAD_S_PSP                 (0xFFFFFFFDUL)
+
+/* Exception numbers */
+#define EXC_NUM_THREAD_MODE                     (0)
+#define EXC_NUM_SVCALL                          (11)
+#define EXC_NUM_PENDSV                          (14)
+
+#define TFM_NS_EXC_DISABLE()
+#define TFM_NS_EXC_ENABLE()
+
+/* Emulated PRIMASK and active exception number */
+extern uint32_t tfm_arch_host_primask;
+extern uint32_t tfm_arch_host_exc_num;
+
+/* Serve a pending scheduling request. Called when interrupts get unmasked. */
+void tfm_arch_host_pendsv_check(void);
+
+__STATIC_INLINE uint32_t __save_disable_irq(void)
+{
+    uint32_t result = tfm_arch_host_primask;
+
+    tfm_arch_host_primask = 1;
+    return result;
+}
+
+__STATIC_INLINE void __restore_irq(uint32_t status)
+{
+    tfm_arch_host_primask = status;
+    if (!status) {
+        tfm_arch_host_pendsv_check();
+    }
+}
+
+__STATIC_INLINE uint32_t __get_active_exc_num(void)
+{
+    return tfm_arch_host_exc_num;
+}
+
+/* Everything runs at the same privilege in the simulation */
+__STATIC_INLINE bool tfm_arch_is_priv(void)
+{
+    return true;
+}
+
+#define ARCH_FLUSH_FP_CONTEXT()
+
+__STATIC_INLINE void tfm_arch_set_psplim(uint32_t psplim)
+{
+    (void)psplim;
+}
+
+__STATIC_INLINE void tfm_arch_set_msplim(uint32_t msplim)
+{
+    (void)msplim;
+}
+
+/* Host stacks are not sealed, the context is kept at the stack top instead. */
+__STATIC_INLINE uintptr_t arch_seal_thread_stack(uintptr_t stk)
+{
+    SPM_ASSERT((stk & 0x7) == 0);
+    return stk;
+}
+
+__STATIC_INLINE void tfm_arch_check_msp_sealing(void)
+{
+}
+
+#endif